@@ -161,6 +161,22 @@ moment_to_discrete(vector<double> &data) const
     }
 }
 
+void Angular_Discretization::
+moment_to_discrete_matrix(vector<double> &matrix) const
+{
+    matrix.resize(number_of_moments_ * number_of_ordinates_);
+    for (int o = 0; o < number_of_ordinates_; ++o)
+    {
+        for (int m = 0; m < number_of_moments_; ++m)
+        {
+            int const l = scattering_indices()[m];
+            int const k = m + number_of_moments_ * o;
+            
+            matrix[k] = (2 * static_cast<double>(l) + 1) / angular_normalization_ * moment(m, o);
+        }
+    }
+}
+
 void Angular_Discretization::
 discrete_to_moment(vector<double> &data) const
 {
@@ -89,6 +89,10 @@ public:
     // Perform moment-to-discrete operation
     virtual void moment_to_discrete(std::vector<double> &data) const;
 
+    // Get the moment-to-discrete matrix, (2l + 1) / norm * P_m(o), indexed
+    // as m + number_of_moments * o
+    virtual void moment_to_discrete_matrix(std::vector<double> &matrix) const;
+
     // Perform discrete-to-moment operation
     virtual void discrete_to_moment(std::vector<double> &data) const;
 
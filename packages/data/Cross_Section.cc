@@ -25,6 +25,16 @@ Cross_Section(Dependencies dependencies,
     check_class_invariants();
 }
 
+Cross_Section::
+Cross_Section(Dependencies dependencies,
+              shared_ptr<Angular_Discretization> angular_discretization,
+              shared_ptr<Energy_Discretization> energy_discretization):
+    dependencies_(dependencies),
+    angular_discretization_(angular_discretization),
+    energy_discretization_(energy_discretization)
+{
+}
+
 int Cross_Section::
 size() const
 {
@@ -164,7 +174,7 @@ output(XML_Node output_node) const
 {
     string description = angular_string() + energy_string() + dimensional_string() + spatial_string();
     
-    output_node.set_vector(data_, description);
+    output_node.set_vector(data(), description);
 }
 
 std::shared_ptr<Conversion<Cross_Section::Dependencies::Angular, string> > Cross_Section::Dependencies::
@@ -83,6 +83,13 @@ public:
     
     virtual void check_class_invariants() const;
     virtual void output(XML_Node output_node) const;
+
+protected:
+
+    // Constructor for derived classes that do not store the full data
+    Cross_Section(Dependencies dependencies,
+                  std::shared_ptr<Angular_Discretization> angular_discretization,
+                  std::shared_ptr<Energy_Discretization> energy_discretization);
     
 private:
     
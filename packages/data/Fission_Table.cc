@@ -0,0 +1,213 @@
+#include "Fission_Table.hh"
+
+#include <cmath>
+
+#include "Check.hh"
+#include "Cross_Section.hh"
+#include "Material.hh"
+#include "Material_Table.hh"
+
+using namespace std;
+
+Fission_Table::
+Fission_Table(int number_of_groups,
+              int number_of_dimensional_moments,
+              shared_ptr<Material_Table> material_table):
+    number_of_groups_(number_of_groups),
+    number_of_dimensional_moments_(number_of_dimensional_moments)
+{
+    Assert(material_table);
+    int number_of_points = material_table->number_of_points();
+    int number_of_materials = material_table->number_of_materials();
+
+    // Add a table for each interned material, which points then share
+    for (int m = 0; m < number_of_materials; ++m)
+    {
+        add_table(material_table->interned_material(m));
+    }
+    table_indices_.resize(number_of_points);
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        table_indices_[i] = material_table->material_index(i);
+    }
+
+    check_class_invariants();
+}
+
+void Fission_Table::
+add_table(shared_ptr<Material> material)
+{
+    int const number_of_groups = number_of_groups_;
+    int const number_of_dimensional_moments = number_of_dimensional_moments_;
+    offsets_.push_back(values_.size());
+
+    // Separate nu, sigma_f and chi with no dimensional dependence in chi are
+    // already factored
+    if (material->sigma_f()->dependencies().energy == Cross_Section::Dependencies::Energy::GROUP
+        && material->chi()->data().size() == number_of_groups)
+    {
+        vector<double> const &nu = material->nu()->data();
+        vector<double> const &sigma_f = material->sigma_f()->data();
+        vector<double> const &chi = material->chi()->data();
+        int nu_dimensional_size = nu.size() / number_of_groups;
+        int sigma_f_dimensional_size = sigma_f.size() / number_of_groups;
+
+        factored_.push_back(true);
+        values_.insert(values_.end(), chi.begin(), chi.end());
+        for (int g = 0; g < number_of_groups; ++g)
+        {
+            for (int d = 0; d < number_of_dimensional_moments; ++d)
+            {
+                int k_nu = (nu_dimensional_size == 1 ? 0 : d) + nu_dimensional_size * g;
+                int k_sigma = (sigma_f_dimensional_size == 1 ? 0 : d) + sigma_f_dimensional_size * g;
+
+                values_.push_back(nu[k_nu] * sigma_f[k_sigma]);
+            }
+        }
+        return;
+    }
+
+    // Otherwise, check whether the group-to-group matrices share a common chi
+    vector<double> sigma_f;
+    get_dense(material,
+              sigma_f);
+    int max_index = 0;
+    for (int k = 0; k < sigma_f.size(); ++k)
+    {
+        if (abs(sigma_f[k]) > abs(sigma_f[max_index]))
+        {
+            max_index = k;
+        }
+    }
+    double const max_value = sigma_f[max_index];
+    int const d_max = max_index % number_of_dimensional_moments;
+    int const gf_max = (max_index / number_of_dimensional_moments) % number_of_groups;
+    int const gt_max = max_index / (number_of_dimensional_moments * number_of_groups);
+
+    // Factor through the largest entry: chi is normalized to one in its row
+    vector<double> chi(number_of_groups, 0.);
+    vector<double> nu_sigma_f(number_of_dimensional_moments * number_of_groups, 0.);
+    if (max_value != 0)
+    {
+        for (int gt = 0; gt < number_of_groups; ++gt)
+        {
+            int k = d_max + number_of_dimensional_moments * (gf_max + number_of_groups * gt);
+            chi[gt] = sigma_f[k] / max_value;
+        }
+        for (int gf = 0; gf < number_of_groups; ++gf)
+        {
+            for (int d = 0; d < number_of_dimensional_moments; ++d)
+            {
+                int k = d + number_of_dimensional_moments * (gf + number_of_groups * gt_max);
+                nu_sigma_f[d + number_of_dimensional_moments * gf] = sigma_f[k];
+            }
+        }
+    }
+
+    // Keep the factored form only if it reproduces the matrices to roundoff
+    double const tolerance = 1e-12 * abs(max_value);
+    bool rank_one = true;
+    for (int gt = 0; gt < number_of_groups && rank_one; ++gt)
+    {
+        for (int gf = 0; gf < number_of_groups && rank_one; ++gf)
+        {
+            for (int d = 0; d < number_of_dimensional_moments; ++d)
+            {
+                int k = d + number_of_dimensional_moments * (gf + number_of_groups * gt);
+                if (abs(sigma_f[k] - chi[gt] * nu_sigma_f[d + number_of_dimensional_moments * gf]) > tolerance)
+                {
+                    rank_one = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    factored_.push_back(rank_one);
+    if (rank_one)
+    {
+        values_.insert(values_.end(), chi.begin(), chi.end());
+        values_.insert(values_.end(), nu_sigma_f.begin(), nu_sigma_f.end());
+    }
+    else
+    {
+        values_.insert(values_.end(), sigma_f.begin(), sigma_f.end());
+    }
+}
+
+void Fission_Table::
+get_dense(shared_ptr<Material> material,
+          vector<double> &sigma_f) const
+{
+    int const number_of_groups = number_of_groups_;
+    int const number_of_dimensional_moments = number_of_dimensional_moments_;
+    sigma_f.assign(number_of_dimensional_moments * number_of_groups * number_of_groups, 0.);
+
+    // Cross sections without dimensional dependence apply to all dimensional moments
+    switch (material->sigma_f()->dependencies().energy)
+    {
+    case Cross_Section::Dependencies::Energy::GROUP:
+    {
+        vector<double> const &nu = material->nu()->data();
+        vector<double> const &sigma_f_data = material->sigma_f()->data();
+        vector<double> const &chi = material->chi()->data();
+        int nu_dimensional_size = nu.size() / number_of_groups;
+        int sigma_f_dimensional_size = sigma_f_data.size() / number_of_groups;
+        int chi_dimensional_size = chi.size() / number_of_groups;
+
+        for (int gt = 0; gt < number_of_groups; ++gt)
+        {
+            for (int gf = 0; gf < number_of_groups; ++gf)
+            {
+                for (int d = 0; d < number_of_dimensional_moments; ++d)
+                {
+                    int k = d + number_of_dimensional_moments * (gf + number_of_groups * gt);
+                    int k_nu = (nu_dimensional_size == 1 ? 0 : d) + nu_dimensional_size * gf;
+                    int k_sigma = (sigma_f_dimensional_size == 1 ? 0 : d) + sigma_f_dimensional_size * gf;
+                    int k_chi = (chi_dimensional_size == 1 ? 0 : d) + chi_dimensional_size * gt;
+
+                    sigma_f[k] = chi[k_chi] * nu[k_nu] * sigma_f_data[k_sigma];
+                }
+            }
+        }
+        break;
+    } // GROUP
+    case Cross_Section::Dependencies::Energy::GROUP_TO_GROUP:
+    {
+        vector<double> const &sigma_f_data = material->sigma_f()->data();
+        int dimensional_size = sigma_f_data.size() / (number_of_groups * number_of_groups);
+        AssertMsg(dimensional_size == 1 || dimensional_size == number_of_dimensional_moments,
+                  "fission cross section size does not match the group structure");
+
+        for (int gt = 0; gt < number_of_groups; ++gt)
+        {
+            for (int gf = 0; gf < number_of_groups; ++gf)
+            {
+                for (int d = 0; d < number_of_dimensional_moments; ++d)
+                {
+                    int k = d + number_of_dimensional_moments * (gf + number_of_groups * gt);
+                    int k_data = (dimensional_size == 1 ? 0 : d) + dimensional_size * (gf + number_of_groups * gt);
+
+                    sigma_f[k] = sigma_f_data[k_data];
+                }
+            }
+        }
+        break;
+    } // GROUP_TO_GROUP
+    default:
+        AssertMsg(false, "fission cross section must depend on group");
+        break;
+    }
+}
+
+void Fission_Table::
+check_class_invariants() const
+{
+    Assert(number_of_groups_ > 0);
+    Assert(number_of_dimensional_moments_ > 0);
+    Assert(factored_.size() == offsets_.size());
+    for (int t : table_indices_)
+    {
+        Assert(t >= 0 && t < number_of_tables());
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef Fission_Table_hh
+#define Fission_Table_hh
+
+#include <memory>
+#include <vector>
+
+class Material;
+class Material_Table;
+
+/*
+  Fission cross sections of all points, kept in factored form when possible
+
+  The fission matrix for dimensional moment d is chi(gt) * nu_sigma_f(d, gf)
+  whenever the material is given as separate nu, sigma_f and chi, and also
+  for weighted materials whose group-to-group fission matrix is the weighted
+  sum of such products with a common chi. Applying the factored form is a
+  dot product followed by a scale. Materials whose fission matrix is not of
+  this form keep the dense group-to-group matrix.
+
+  Points are assigned the table of their interned material in the
+  Material_Table.
+*/
+class Fission_Table
+{
+public:
+
+    // Constructor: one table per interned material
+    Fission_Table(int number_of_groups,
+                  int number_of_dimensional_moments,
+                  std::shared_ptr<Material_Table> material_table);
+
+    // Number of points and distinct tables
+    int number_of_points() const
+    {
+        return table_indices_.size();
+    }
+    int number_of_tables() const
+    {
+        return offsets_.size();
+    }
+
+    // Index of the table for point i
+    int table_index(int i) const
+    {
+        return table_indices_[i];
+    }
+
+    // Whether table t is stored in factored form
+    bool factored(int t) const
+    {
+        return factored_[t];
+    }
+
+    // Factored form: chi indexed by group and nu_sigma_f indexed as d + D * g
+    double const *chi(int t) const
+    {
+        return &values_[offsets_[t]];
+    }
+    double const *nu_sigma_f(int t) const
+    {
+        return &values_[offsets_[t] + number_of_groups_];
+    }
+
+    // Dense form: indexed as d + D * (gf + G * gt)
+    double const *sigma_f(int t) const
+    {
+        return &values_[offsets_[t]];
+    }
+
+    void check_class_invariants() const;
+
+private:
+
+    // Add the factored or dense fission matrices of one material
+    void add_table(std::shared_ptr<Material> material);
+
+    // Get the dense fission matrices of one material
+    void get_dense(std::shared_ptr<Material> material,
+                   std::vector<double> &sigma_f) const;
+
+    int number_of_groups_;
+    int number_of_dimensional_moments_;
+    std::vector<int> table_indices_;
+    std::vector<bool> factored_;
+    std::vector<int> offsets_; // first value of each table
+    std::vector<double> values_;
+};
+
+#endif
@@ -0,0 +1,210 @@
+#include "Material_Table.hh"
+
+#include <functional>
+#include <unordered_map>
+
+#include "Check.hh"
+#include "Cross_Section.hh"
+#include "Material.hh"
+#include "Mixed_Cross_Section.hh"
+
+using namespace std;
+
+namespace // anonymous
+{
+    // Mixed cross sections are compared and stored by reference only
+    bool is_mixed(shared_ptr<Cross_Section> cross_section)
+    {
+        return static_cast<bool>(dynamic_pointer_cast<Mixed_Cross_Section>(cross_section));
+    }
+
+    bool equal_dependencies(Cross_Section::Dependencies const &deps1,
+                            Cross_Section::Dependencies const &deps2)
+    {
+        return (deps1.angular == deps2.angular
+                && deps1.energy == deps2.energy
+                && deps1.dimensional == deps2.dimensional
+                && deps1.spatial == deps2.spatial
+                && deps1.number_of_basis_functions == deps2.number_of_basis_functions);
+    }
+}
+
+Material_Table::
+Material_Table(vector<shared_ptr<Material> > const &materials)
+{
+    int number_of_points = materials.size();
+    material_indices_.resize(number_of_points);
+
+    // Assign each point to an interned material, comparing data only for
+    // materials with matching hashes
+    unordered_map<Material const *, int> known_pointers;
+    unordered_map<size_t, vector<int> > known_hashes;
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        shared_ptr<Material> const &material = materials[i];
+        Assert(material);
+
+        unordered_map<Material const *, int>::const_iterator it
+            = known_pointers.find(material.get());
+        if (it != known_pointers.end())
+        {
+            material_indices_[i] = it->second;
+            continue;
+        }
+
+        vector<int> &candidates = known_hashes[hash(material)];
+        int t = -1;
+        for (int c : candidates)
+        {
+            if (equal(materials_[c], material))
+            {
+                t = c;
+                break;
+            }
+        }
+        if (t < 0)
+        {
+            t = number_of_materials();
+            materials_.push_back(material);
+            candidates.push_back(t);
+        }
+        known_pointers[material.get()] = t;
+        material_indices_[i] = t;
+    }
+
+    // Get offsets
+    int number_of_materials = materials_.size();
+    for (int q = 0; q < NUMBER_OF_QUANTITIES; ++q)
+    {
+        offsets_[q].assign(number_of_materials + 1, 0);
+    }
+    vector<shared_ptr<Cross_Section> > cross_sections;
+    for (int t = 0; t < number_of_materials; ++t)
+    {
+        get_cross_sections(materials_[t],
+                           cross_sections);
+        for (int q = 0; q < NUMBER_OF_QUANTITIES; ++q)
+        {
+            shared_ptr<Cross_Section> const &cross_section = cross_sections[q];
+            int size = (!cross_section || is_mixed(cross_section)
+                        ? 0
+                        : cross_section->data().size());
+            offsets_[q][t + 1] = offsets_[q][t] + size;
+        }
+    }
+
+    // Copy data
+    for (int q = 0; q < NUMBER_OF_QUANTITIES; ++q)
+    {
+        data_[q].resize(offsets_[q][number_of_materials]);
+    }
+    for (int t = 0; t < number_of_materials; ++t)
+    {
+        get_cross_sections(materials_[t],
+                           cross_sections);
+        for (int q = 0; q < NUMBER_OF_QUANTITIES; ++q)
+        {
+            if (offsets_[q][t + 1] > offsets_[q][t])
+            {
+                vector<double> const &data = cross_sections[q]->data();
+                copy(data.begin(), data.end(), data_[q].begin() + offsets_[q][t]);
+            }
+        }
+    }
+
+    check_class_invariants();
+}
+
+void Material_Table::
+get_cross_sections(shared_ptr<Material> material,
+                   vector<shared_ptr<Cross_Section> > &cross_sections) const
+{
+    cross_sections.resize(NUMBER_OF_QUANTITIES);
+    cross_sections[SIGMA_T] = material->sigma_t();
+    cross_sections[SIGMA_S] = material->sigma_s();
+    cross_sections[NU] = material->nu();
+    cross_sections[SIGMA_F] = material->sigma_f();
+    cross_sections[CHI] = material->chi();
+    cross_sections[INTERNAL_SOURCE] = material->internal_source();
+    cross_sections[NORM] = material->norm();
+}
+
+bool Material_Table::
+equal(shared_ptr<Material> material1,
+      shared_ptr<Material> material2) const
+{
+    if (material1->index() != material2->index()
+        || material1->angular_discretization() != material2->angular_discretization()
+        || material1->energy_discretization() != material2->energy_discretization())
+    {
+        return false;
+    }
+
+    vector<shared_ptr<Cross_Section> > cross_sections1;
+    vector<shared_ptr<Cross_Section> > cross_sections2;
+    get_cross_sections(material1,
+                       cross_sections1);
+    get_cross_sections(material2,
+                       cross_sections2);
+    for (int q = 0; q < NUMBER_OF_QUANTITIES; ++q)
+    {
+        shared_ptr<Cross_Section> const &cross_section1 = cross_sections1[q];
+        shared_ptr<Cross_Section> const &cross_section2 = cross_sections2[q];
+
+        if (cross_section1 == cross_section2)
+        {
+            continue;
+        }
+        if (!cross_section1
+            || !cross_section2
+            || is_mixed(cross_section1)
+            || is_mixed(cross_section2)
+            || !equal_dependencies(cross_section1->dependencies(),
+                                   cross_section2->dependencies())
+            || cross_section1->data() != cross_section2->data())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t Material_Table::
+hash(shared_ptr<Material> material) const
+{
+    std::hash<double> hash_double;
+    size_t value = std::hash<int>()(material->index());
+
+    vector<shared_ptr<Cross_Section> > cross_sections;
+    get_cross_sections(material,
+                       cross_sections);
+    for (shared_ptr<Cross_Section> const &cross_section : cross_sections)
+    {
+        if (!cross_section || is_mixed(cross_section))
+        {
+            continue;
+        }
+        for (double v : cross_section->data())
+        {
+            value ^= hash_double(v) + 0x9e3779b9 + (value << 6) + (value >> 2);
+        }
+    }
+
+    return value;
+}
+
+void Material_Table::
+check_class_invariants() const
+{
+    int number_of_materials = materials_.size();
+    for (int t : material_indices_)
+    {
+        Assert(t >= 0 && t < number_of_materials);
+    }
+    for (int q = 0; q < NUMBER_OF_QUANTITIES; ++q)
+    {
+        Assert(offsets_[q].size() == number_of_materials + 1);
+        Assert(data_[q].size() == offsets_[q][number_of_materials]);
+    }
+}
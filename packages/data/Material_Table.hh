@@ -0,0 +1,129 @@
+#ifndef Material_Table_hh
+#define Material_Table_hh
+
+#include <memory>
+#include <vector>
+
+class Cross_Section;
+class Material;
+
+/*
+  Cross sections of all points, with identical materials stored once
+
+  Points whose materials have the same index, discretizations and cross
+  section data are assigned a single interned material. The data of each
+  interned material is stored contiguously for each cross section, in the
+  same order as Cross_Section::data(), so operators can read it through raw
+  pointers instead of through the shared cross section objects.
+
+  Mixed cross sections are not expanded, as this would undo their
+  compression, and have a null pointer in the view, as does a missing norm.
+*/
+class Material_Table
+{
+public:
+
+    // Pointers to the cross sections of one point
+    struct View
+    {
+        int material_index;
+        double const *sigma_t;
+        double const *sigma_s;
+        double const *nu;
+        double const *sigma_f;
+        double const *chi;
+        double const *internal_source;
+        double const *norm;
+    };
+
+    // Constructor: one material per point
+    Material_Table(std::vector<std::shared_ptr<Material> > const &materials);
+
+    // Number of points and distinct materials
+    int number_of_points() const
+    {
+        return material_indices_.size();
+    }
+    int number_of_materials() const
+    {
+        return materials_.size();
+    }
+
+    // Index of the interned material for point i
+    int material_index(int i) const
+    {
+        return material_indices_[i];
+    }
+
+    // Interned material for point i
+    std::shared_ptr<Material> material(int i) const
+    {
+        return materials_[material_indices_[i]];
+    }
+
+    // Interned material with index t
+    std::shared_ptr<Material> interned_material(int t) const
+    {
+        return materials_[t];
+    }
+
+    // Get cross sections for point i
+    View view(int i) const
+    {
+        int t = material_indices_[i];
+        View v;
+        v.material_index = t;
+        v.sigma_t = pointer(SIGMA_T, t);
+        v.sigma_s = pointer(SIGMA_S, t);
+        v.nu = pointer(NU, t);
+        v.sigma_f = pointer(SIGMA_F, t);
+        v.chi = pointer(CHI, t);
+        v.internal_source = pointer(INTERNAL_SOURCE, t);
+        v.norm = pointer(NORM, t);
+        return v;
+    }
+
+    void check_class_invariants() const;
+
+private:
+
+    // Cross sections in the order of View
+    enum Quantity
+    {
+        SIGMA_T = 0,
+        SIGMA_S,
+        NU,
+        SIGMA_F,
+        CHI,
+        INTERNAL_SOURCE,
+        NORM,
+        NUMBER_OF_QUANTITIES
+    };
+
+    double const *pointer(int q,
+                          int t) const
+    {
+        return (offsets_[q][t + 1] == offsets_[q][t]
+                ? nullptr
+                : data_[q].data() + offsets_[q][t]);
+    }
+
+    // Get the cross sections of a material in the order of Quantity
+    void get_cross_sections(std::shared_ptr<Material> material,
+                            std::vector<std::shared_ptr<Cross_Section> > &cross_sections) const;
+
+    // Check whether two materials can share storage
+    bool equal(std::shared_ptr<Material> material1,
+               std::shared_ptr<Material> material2) const;
+
+    // Hash of the index and cross section data of a material
+    std::size_t hash(std::shared_ptr<Material> material) const;
+
+    // Data
+    std::vector<int> material_indices_;
+    std::vector<std::shared_ptr<Material> > materials_;
+    std::vector<double> data_[NUMBER_OF_QUANTITIES];
+    std::vector<int> offsets_[NUMBER_OF_QUANTITIES]; // start of each interned material, plus end
+};
+
+#endif
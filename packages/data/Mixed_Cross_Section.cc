@@ -0,0 +1,91 @@
+#include "Mixed_Cross_Section.hh"
+
+#include "Check.hh"
+#include "XML_Node.hh"
+
+using namespace std;
+
+Mixed_Cross_Section::
+Mixed_Cross_Section(Dependencies dependencies,
+                    shared_ptr<Angular_Discretization> angular_discretization,
+                    shared_ptr<Energy_Discretization> energy_discretization,
+                    vector<shared_ptr<Cross_Section> > const &components,
+                    vector<double> const &coefficients):
+    Cross_Section(dependencies,
+                  angular_discretization,
+                  energy_discretization),
+    components_(components),
+    coefficients_(coefficients)
+{
+    check_class_invariants();
+}
+
+void Mixed_Cross_Section::
+expand(vector<double> &data) const
+{
+    int number_of_dimensional_moments = dimensional_size();
+    int number_of_basis_functions = spatial_size();
+    int component_size = angular_size() * energy_size();
+
+    data.assign(size(), 0.);
+    for (int r = 0; r < number_of_components(); ++r)
+    {
+        vector<double> const &component_data = components_[r]->data();
+
+        for (int j = 0; j < number_of_basis_functions; ++j)
+        {
+            for (int d = 0; d < number_of_dimensional_moments; ++d)
+            {
+                double coefficient = coefficients_[d + number_of_dimensional_moments * (j + number_of_basis_functions * r)];
+
+                for (int s = 0; s < component_size; ++s)
+                {
+                    int k = d + number_of_dimensional_moments * (s + component_size * j);
+
+                    data[k] += coefficient * component_data[s];
+                }
+            }
+        }
+    }
+}
+
+vector<double> const &Mixed_Cross_Section::
+data() const
+{
+    // Expand once, as the data may be requested concurrently
+    call_once(expanded_flag_,
+              [this]()
+              {
+                  expand(expanded_data_);
+              });
+
+    return expanded_data_;
+}
+
+void Mixed_Cross_Section::
+check_class_invariants() const
+{
+    Dependencies deps = dependencies();
+    Assert(deps.spatial == Dependencies::Spatial::BASIS_WEIGHT);
+    Assert(coefficients_.size() == dimensional_size() * spatial_size() * components_.size());
+    for (shared_ptr<Cross_Section> component : components_)
+    {
+        Assert(component);
+        Dependencies component_deps = component->dependencies();
+        Assert(component_deps.angular == deps.angular);
+        Assert(component_deps.energy == deps.energy);
+        Assert(component_deps.dimensional == Dependencies::Dimensional::NONE);
+        Assert(component_deps.spatial == Dependencies::Spatial::WEIGHT);
+    }
+}
+
+void Mixed_Cross_Section::
+output(XML_Node output_node) const
+{
+    // Write the expanded data without keeping it
+    string description = angular_string() + energy_string() + dimensional_string() + spatial_string();
+    vector<double> data;
+    expand(data);
+    
+    output_node.set_vector(data, description);
+}
@@ -0,0 +1,64 @@
+#ifndef Mixed_Cross_Section_hh
+#define Mixed_Cross_Section_hh
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Cross_Section.hh"
+
+/*
+  Basis-weight cross section stored as a mixture of component cross sections
+
+  For weighting over several material regions, the cross section for
+  dimensional moment d and basis function j is the sum over components r of
+  coefficient(d, j, r) * component(r). The components have weight spatial
+  dependence and no dimensional dependence, and are shared between the
+  mixtures that contain them, so only the coefficients are stored per
+  mixture. Callers that need the full data should expand it into their own
+  storage or work with the components; data() keeps an expanded copy and
+  is only meant for code that cannot do either.
+*/
+class Mixed_Cross_Section : public Cross_Section
+{
+public:
+
+    // Constructor: coefficients indexed as d + D * (j + J * r)
+    Mixed_Cross_Section(Dependencies dependencies,
+                        std::shared_ptr<Angular_Discretization> angular_discretization,
+                        std::shared_ptr<Energy_Discretization> energy_discretization,
+                        std::vector<std::shared_ptr<Cross_Section> > const &components,
+                        std::vector<double> const &coefficients);
+
+    // Components and mixing coefficients
+    int number_of_components() const
+    {
+        return components_.size();
+    }
+    std::shared_ptr<Cross_Section> component(int r) const
+    {
+        return components_[r];
+    }
+    std::vector<double> const &coefficients() const
+    {
+        return coefficients_;
+    }
+
+    // Expand the mixture into the full data, ordered as Cross_Section::data()
+    void expand(std::vector<double> &data) const;
+    
+    // Expanded data, formed and kept on first use
+    virtual std::vector<double> const &data() const override;
+
+    virtual void check_class_invariants() const override;
+    virtual void output(XML_Node output_node) const override;
+
+private:
+
+    std::vector<std::shared_ptr<Cross_Section> > components_;
+    std::vector<double> coefficients_;
+    mutable std::once_flag expanded_flag_;
+    mutable std::vector<double> expanded_data_;
+};
+
+#endif
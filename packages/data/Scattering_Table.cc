@@ -0,0 +1,147 @@
+#include "Scattering_Table.hh"
+
+#include <functional>
+#include <unordered_map>
+
+#include "Check.hh"
+#include "Material.hh"
+#include "Material_Table.hh"
+
+using namespace std;
+
+namespace // anonymous
+{
+    // Cross sections with equal angular dependence and data share a table
+    bool equal_cross_sections(shared_ptr<Cross_Section> cross_section1,
+                              shared_ptr<Cross_Section> cross_section2)
+    {
+        return (cross_section1->dependencies().angular == cross_section2->dependencies().angular
+                && cross_section1->data() == cross_section2->data());
+    }
+
+    size_t hash_cross_section(shared_ptr<Cross_Section> cross_section)
+    {
+        std::hash<double> hash_double;
+        size_t value = std::hash<int>()(static_cast<int>(cross_section->dependencies().angular));
+        for (double v : cross_section->data())
+        {
+            value ^= hash_double(v) + 0x9e3779b9 + (value << 6) + (value >> 2);
+        }
+        return value;
+    }
+}
+
+Scattering_Table::
+Scattering_Table(int number_of_groups,
+                 int number_of_dimensional_moments,
+                 shared_ptr<Material_Table> material_table):
+    number_of_groups_(number_of_groups),
+    number_of_dimensional_moments_(number_of_dimensional_moments)
+{
+    Assert(material_table);
+    int number_of_points = material_table->number_of_points();
+    int number_of_materials = material_table->number_of_materials();
+    vector<int> material_tables(number_of_materials);
+    row_offsets_.push_back(0);
+
+    // Assign each interned material to a table, adding a table for each
+    // distinct cross section and comparing data only for matching hashes
+    unordered_map<Cross_Section const *, int> known_cross_sections;
+    unordered_map<size_t, vector<int> > known_hashes;
+    vector<shared_ptr<Cross_Section> > table_cross_sections;
+    for (int m = 0; m < number_of_materials; ++m)
+    {
+        shared_ptr<Cross_Section> const cross_section
+            = material_table->interned_material(m)->sigma_s();
+        Assert(cross_section);
+
+        // Check whether this cross section has already been seen
+        unordered_map<Cross_Section const *, int>::const_iterator it
+            = known_cross_sections.find(cross_section.get());
+        if (it != known_cross_sections.end())
+        {
+            material_tables[m] = it->second;
+            continue;
+        }
+
+        // Check whether an identical cross section already has a table
+        vector<int> &candidates = known_hashes[hash_cross_section(cross_section)];
+        int table = -1;
+        for (int t : candidates)
+        {
+            if (equal_cross_sections(table_cross_sections[t], cross_section))
+            {
+                table = t;
+                break;
+            }
+        }
+        if (table == -1)
+        {
+            table = table_cross_sections.size();
+            table_cross_sections.push_back(cross_section);
+            candidates.push_back(table);
+            add_table(cross_section);
+        }
+
+        known_cross_sections[cross_section.get()] = table;
+        material_tables[m] = table;
+    }
+
+    // Points share the table of their interned material
+    table_indices_.resize(number_of_points);
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        table_indices_[i] = material_tables[material_table->material_index(i)];
+    }
+
+    check_class_invariants();
+}
+
+void Scattering_Table::
+add_table(shared_ptr<Cross_Section> sigma_s)
+{
+    vector<double> const &data = sigma_s->data();
+    int block_size = number_of_dimensional_moments_ * number_of_groups_ * number_of_groups_;
+    AssertMsg(data.size() % block_size == 0, "scattering cross section size does not match the group structure");
+    int number_of_orders = data.size() / block_size;
+
+    angular_dependencies_.push_back(sigma_s->dependencies().angular);
+    block_offsets_.push_back(row_offsets_.size() - 1);
+
+    // Store nonzero transfers into each group, ordered as in Scattering_Table::row()
+    for (int l = 0; l < number_of_orders; ++l)
+    {
+        for (int d = 0; d < number_of_dimensional_moments_; ++d)
+        {
+            for (int gt = 0; gt < number_of_groups_; ++gt)
+            {
+                for (int gf = 0; gf < number_of_groups_; ++gf)
+                {
+                    int k_sigma = d + number_of_dimensional_moments_ * (gf + number_of_groups_ * (gt + number_of_groups_ * l));
+
+                    if (data[k_sigma] != 0)
+                    {
+                        groups_.push_back(gf);
+                        values_.push_back(data[k_sigma]);
+                    }
+                }
+
+                row_offsets_.push_back(values_.size());
+            }
+        }
+    }
+}
+
+void Scattering_Table::
+check_class_invariants() const
+{
+    Assert(number_of_groups_ > 0);
+    Assert(number_of_dimensional_moments_ > 0);
+    Assert(block_offsets_.size() == angular_dependencies_.size());
+    Assert(groups_.size() == values_.size());
+    Assert(row_offsets_.back() == values_.size());
+    for (int t : table_indices_)
+    {
+        Assert(t >= 0 && t < number_of_tables());
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef Scattering_Table_hh
+#define Scattering_Table_hh
+
+#include <memory>
+#include <vector>
+
+#include "Cross_Section.hh"
+
+class Material_Table;
+
+/*
+  Group-to-group scattering cross sections of all points in compressed form
+
+  Points are assigned the table of their interned material in the
+  Material_Table. Interned materials that share a scattering cross section,
+  or whose scattering cross sections have identical dependencies and data,
+  are assigned the same table. For each table,
+  Legendre order (or moment) and dimensional moment, the transfer matrix is
+  stored with one compressed row per destination group that contains only
+  the nonzero source groups, in increasing order.
+*/
+class Scattering_Table
+{
+public:
+
+    // Nonzero transfers into one group
+    struct Row
+    {
+        int size;
+        int const *groups; // source groups
+        double const *values; // cross sections from each source group
+    };
+
+    // Constructor: scattering cross sections of the interned materials
+    Scattering_Table(int number_of_groups,
+                     int number_of_dimensional_moments,
+                     std::shared_ptr<Material_Table> material_table);
+
+    // Number of points and distinct tables
+    int number_of_points() const
+    {
+        return table_indices_.size();
+    }
+    int number_of_tables() const
+    {
+        return angular_dependencies_.size();
+    }
+
+    // Index of the table for point i
+    int table_index(int i) const
+    {
+        return table_indices_[i];
+    }
+
+    // Angular dependence of table t, which determines whether the order is
+    // the Legendre order or the moment
+    Cross_Section::Dependencies::Angular angular_dependence(int t) const
+    {
+        return angular_dependencies_[t];
+    }
+
+    // Transfers into group gt for table t, order l and dimensional moment d
+    Row row(int t,
+            int l,
+            int d,
+            int gt) const
+    {
+        int r = gt + number_of_groups_ * (d + number_of_dimensional_moments_ * l) + block_offsets_[t];
+        Row v;
+        v.size = row_offsets_[r + 1] - row_offsets_[r];
+        v.groups = groups_.data() + row_offsets_[r];
+        v.values = values_.data() + row_offsets_[r];
+        return v;
+    }
+
+    // Number of stored transfers, for comparison with the dense size
+    int number_of_nonzeros() const
+    {
+        return values_.size();
+    }
+
+    void check_class_invariants() const;
+
+private:
+
+    // Add the compressed transfer matrices of one cross section
+    void add_table(std::shared_ptr<Cross_Section> sigma_s);
+
+    int number_of_groups_;
+    int number_of_dimensional_moments_;
+    std::vector<int> table_indices_;
+    std::vector<Cross_Section::Dependencies::Angular> angular_dependencies_;
+    std::vector<int> block_offsets_; // first row of each table
+    std::vector<int> row_offsets_;
+    std::vector<int> groups_;
+    std::vector<double> values_;
+};
+
+#endif
@@ -16,6 +16,7 @@
 #include "Manufactured_Parser.hh"
 #include "Meshless_Sweep.hh"
 #include "Meshless_Sweep_Parser.hh"
+#include "Multigroup_Gauss_Seidel.hh"
 #include "Solver.hh"
 #include "Solver_Parser.hh"
 #include "Source_Iteration.hh"
@@ -182,6 +183,11 @@ solve_steady_state(string discretization_method)
         solver = solver_parser.get_krylov_steady_state(solver_node,
                                                        sweep);
     }
+    else if (type == "multigroup_gauss_seidel")
+    {
+        solver = solver_parser.get_multigroup_gauss_seidel(solver_node,
+                                                           sweep);
+    }
     else
     {
         AssertMsg(false, "solver type (" + type + ") not found");
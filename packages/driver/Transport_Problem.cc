@@ -14,6 +14,7 @@
 #include "Material_Parser.hh"
 #include "Meshless_Sweep.hh"
 #include "Meshless_Sweep_Parser.hh"
+#include "Multigroup_Gauss_Seidel.hh"
 #include "Solver.hh"
 #include "Solver_Parser.hh"
 #include "Source_Iteration.hh"
@@ -23,6 +24,7 @@
 #include "Transport_Discretization.hh"
 #include "Weak_Spatial_Discretization.hh"
 #include "Weak_Spatial_Discretization_Parser.hh"
+#include "Wielandt_Eigenvalue.hh"
 
 using namespace std;
 
@@ -212,6 +214,11 @@ solve_steady_state(string discretization_method)
         solver = solver_parser.get_krylov_steady_state(solver_node,
                                                        sweep);
     }
+    else if (type == "multigroup_gauss_seidel")
+    {
+        solver = solver_parser.get_multigroup_gauss_seidel(solver_node,
+                                                           sweep);
+    }
     else
     {
         AssertMsg(false, "solver type (" + type + ") not found");
@@ -279,6 +286,11 @@ solve_eigenvalue(string discretization_method)
         solver = solver_parser.get_krylov_eigenvalue(solver_node,
                                                      sweep);
     }
+    else if (type == "wielandt")
+    {
+        solver = solver_parser.get_wielandt_eigenvalue(solver_node,
+                                                       sweep);
+    }
     else
     {
         AssertMsg(false, "solver type (" + type + ") not found");
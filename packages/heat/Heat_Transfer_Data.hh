@@ -13,6 +13,12 @@ public:
     virtual double convection(std::vector<double> const &position) const = 0;
     virtual double source(std::vector<double> const &position) const = 0;
     virtual double temperature_inf(std::vector<double> const &position) const = 0;
+
+    // Volumetric removal term, which is zero for pure conduction
+    virtual double absorption(std::vector<double> const &position) const
+    {
+        return 0;
+    }
 };
 
 #endif
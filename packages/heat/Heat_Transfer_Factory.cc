@@ -182,6 +182,7 @@ get_cylindrical_1d(int number_of_points,
                                                  spatial);
     
     return make_shared<Heat_Transfer_Solve>(integration,
-                                            spatial);
+                                            spatial,
+                                            Heat_Transfer_Solve::Options());
 }
 
@@ -119,6 +119,7 @@ perform_integration()
                                      w_val,
                                      w_grad);
             double const conduction = data_->conduction(position);
+            double const absorption = data_->absorption(position);
             double const source = data_->source(position);
 
             // Add integrals for each weight function in this cell
@@ -144,7 +145,7 @@ perform_integration()
                     // Get basis index for this weight function
                     int w_b_ind = weight_basis_indices[w][b];
 
-                    // Add convection term to matrix
+                    // Add conduction and absorption terms to matrix
                     if (w_b_ind != Weight_Function::Errors::DOES_NOT_EXIST)
                     {
                         switch (options_->geometry)
@@ -155,9 +156,10 @@ perform_integration()
                             {
                                 matrix_[w_ind][w_b_ind] += quad_weight * w_grad[w][d] * b_grad[b][d] * conduction;
                             }
+                            matrix_[w_ind][w_b_ind] += quad_weight * w_val[w] * b_val[b] * absorption;
                             break;
                         case Heat_Transfer_Integration_Options::Geometry::CYLINDRICAL_1D:
-                            matrix_[w_ind][w_b_ind] += quad_weight * w_grad[w][0] * b_grad[b][0] * conduction * position[0];
+                            matrix_[w_ind][w_b_ind] += quad_weight * (w_grad[w][0] * b_grad[b][0] * conduction + w_val[w] * b_val[b] * absorption) * position[0];
                             break;
                         }
                     }
@@ -9,6 +9,8 @@
 #include "Epetra_Vector.h"
 
 #include "Check.hh"
+#include "Conversion.hh"
+#include "Eigen_Sparse_Solver.hh"
 #include "Heat_Transfer_Integration.hh"
 #include "Heat_Transfer_Solution.hh"
 #include "Weak_Spatial_Discretization.hh"
@@ -17,7 +19,9 @@ using namespace std;
 
 Heat_Transfer_Solve::
 Heat_Transfer_Solve(shared_ptr<Heat_Transfer_Integration> integration,
-                    shared_ptr<Weak_Spatial_Discretization> spatial):
+                    shared_ptr<Weak_Spatial_Discretization> spatial,
+                    Options options):
+    options_(options),
     integration_(integration),
     spatial_(spatial)
 {
@@ -27,6 +31,27 @@ Heat_Transfer_Solve(shared_ptr<Heat_Transfer_Integration> integration,
 
 shared_ptr<Heat_Transfer_Solution> Heat_Transfer_Solve::
 solve()
+{
+    int number_of_points = spatial_->number_of_points();
+    
+    // Get solution
+    vector<double> coefficients(number_of_points);
+    switch (options_.solver)
+    {
+    case Options::Solver::AMESOS:
+        solve_amesos(coefficients);
+        break;
+    case Options::Solver::EIGEN_SPARSE_LU:
+        solve_eigen(coefficients);
+        break;
+    }
+
+    return make_shared<Heat_Transfer_Solution>(spatial_,
+                                               coefficients);
+}
+
+void Heat_Transfer_Solve::
+solve_amesos(vector<double> &coefficients)
 {
     // Get needed spatial discretization information
     int number_of_points = spatial_->number_of_points();
@@ -82,12 +107,55 @@ solve()
     AssertMsg(solver->Solve() == 0, "Heat solver failed");
 
     // Get solution
-    vector<double> coefficients(number_of_points);
     for (int i = 0; i < number_of_points; ++i)
     {
         coefficients[i] = (*lhs)[i];
     }
+}
 
-    return make_shared<Heat_Transfer_Solution>(spatial_,
-                                               coefficients);
+void Heat_Transfer_Solve::
+solve_eigen(vector<double> &coefficients)
+{
+    // Get needed spatial discretization information
+    int number_of_points = spatial_->number_of_points();
+    vector<int> const &number_of_basis_functions = spatial_->number_of_basis_functions();
+    vector<vector<double> > const &matrix = integration_->matrix();
+    
+    // Get matrix in compressed row form
+    vector<int> row_offsets(number_of_points + 1, 0);
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        row_offsets[i + 1] = row_offsets[i] + number_of_basis_functions[i];
+    }
+    vector<int> column_indices(row_offsets[number_of_points]);
+    vector<double> values(row_offsets[number_of_points]);
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        vector<int> const &indices = spatial_->weight(i)->basis_function_indices();
+        Assert(indices.size() == number_of_basis_functions[i]);
+        Assert(matrix[i].size() == number_of_basis_functions[i]);
+        
+        copy(indices.begin(), indices.end(), column_indices.begin() + row_offsets[i]);
+        copy(matrix[i].begin(), matrix[i].end(), values.begin() + row_offsets[i]);
+    }
+    
+    // Factor and solve problem
+    shared_ptr<Eigen_Sparse_Pattern<double> > pattern
+        = make_shared<Eigen_Sparse_Pattern<double> >(number_of_points,
+                                                     row_offsets,
+                                                     column_indices);
+    Eigen_Sparse_Solver<double> solver(pattern);
+    solver.initialize(values);
+    solver.solve(integration_->rhs(),
+                 coefficients);
+}
+
+shared_ptr<Conversion<Heat_Transfer_Solve::Options::Solver, string> > Heat_Transfer_Solve::Options::
+solver_conversion() const
+{
+    vector<pair<Solver, string> > conversions
+        = {{Solver::AMESOS, "amesos"},
+           {Solver::EIGEN_SPARSE_LU, "eigen_sparse_lu"}};
+    
+    return make_shared<Conversion<Solver, string> >(conversions);
 }
@@ -2,7 +2,10 @@
 #define Heat_Transfer_Solve_hh
 
 #include <memory>
+#include <string>
+#include <vector>
 
+template<class T1, class T2> class Conversion;
 class Heat_Transfer_Integration;
 class Heat_Transfer_Solution;
 class Weak_Spatial_Discretization;
@@ -11,13 +14,32 @@ class Heat_Transfer_Solve
 {
 public:
 
+    struct Options
+    {
+        // Direct solver type
+        enum class Solver
+        {
+            AMESOS,
+            EIGEN_SPARSE_LU
+        };
+        std::shared_ptr<Conversion<Solver, std::string> > solver_conversion() const;
+        
+        Solver solver = Solver::AMESOS;
+    };
+    
     Heat_Transfer_Solve(std::shared_ptr<Heat_Transfer_Integration> integration,
-                        std::shared_ptr<Weak_Spatial_Discretization> spatial);
+                        std::shared_ptr<Weak_Spatial_Discretization> spatial,
+                        Options options);
     
     std::shared_ptr<Heat_Transfer_Solution> solve();
     
 private:
 
+    // Solve using each type of solver
+    void solve_amesos(std::vector<double> &coefficients);
+    void solve_eigen(std::vector<double> &coefficients);
+    
+    Options options_;
     std::shared_ptr<Heat_Transfer_Integration> integration_;
     std::shared_ptr<Weak_Spatial_Discretization> spatial_;
 };
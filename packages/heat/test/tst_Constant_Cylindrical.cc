@@ -5,6 +5,8 @@
 
 #include <mpi.h>
 
+#include "Check_Equality.hh"
+#include "Conversion.hh"
 #include "Heat_Transfer_Data.hh"
 #include "Heat_Transfer_Factory.hh"
 #include "Heat_Transfer_Integration.hh"
@@ -16,6 +18,7 @@
 #include "XML_Node.hh"
 
 using namespace std;
+namespace ce = Check_Equality;
 
 // Local class for given heat transfer data
 class Constant_Heat_Transfer_Data : public Heat_Transfer_Data
@@ -146,6 +149,8 @@ int test_constant(int number_of_points,
 }
 
 int test_constant_2d(XML_Node input_node,
+                     Heat_Transfer_Solve::Options::Solver solver_type,
+                     double tolerance,
                      double length1,
                      double length2,
                      double conduction1,
@@ -200,10 +205,14 @@ int test_constant_2d(XML_Node input_node,
                                                  spatial);
     
     // Initialize heat transfer solver
-    cout << "initializing solver" << endl;
+    Heat_Transfer_Solve::Options solve_options;
+    solve_options.solver = solver_type;
+    string solver_description = solve_options.solver_conversion()->convert(solver_type);
+    cout << "initializing " << solver_description << " solver" << endl;
     shared_ptr<Heat_Transfer_Solve> solver
         = make_shared<Heat_Transfer_Solve>(integration,
-                                           spatial);
+                                           spatial,
+                                           solve_options);
     
     // Solve problem
     cout << "solving problem" << endl;
@@ -213,8 +222,17 @@ int test_constant_2d(XML_Node input_node,
     // Check a spot
     vector<double> test_position(dimension, 0.046);
     test_position[1] = 0;
-    cout << solution->solution(test_position) << endl;
-    cout << data->solution(test_position) << endl;
+    double numeric = solution->solution(test_position);
+    double analytic = data->solution(test_position);
+    cout << numeric << endl;
+    cout << analytic << endl;
+    if (!ce::approx(numeric / analytic, 1., tolerance))
+    {
+        cerr << "Test failed: " << solver_description << " solution differs from analytic" << endl;
+        cerr << "\tnumeric:  " << numeric << endl;
+        cerr << "\tanalytic: " << analytic << endl;
+        checksum += 1;
+    }
 
     return checksum;
 }
@@ -256,15 +274,23 @@ int main(int argc, char **argv)
         XML_Document input_file(input_filename);
         XML_Node input_node = input_file.get_child("input");
         
-        checksum += test_constant_2d(input_node,
-                                     length1,
-                                     length2,
-                                     conduction1,
-                                     conduction2,
-                                     convection,
-                                     source1,
-                                     source2,
-                                     temperature_inf);
+        // Relative tolerance for the coarse two-region discretization
+        double tolerance = 0.1;
+        for (Heat_Transfer_Solve::Options::Solver solver_type : {Heat_Transfer_Solve::Options::Solver::AMESOS,
+                                                                  Heat_Transfer_Solve::Options::Solver::EIGEN_SPARSE_LU})
+        {
+            checksum += test_constant_2d(input_node,
+                                         solver_type,
+                                         tolerance,
+                                         length1,
+                                         length2,
+                                         conduction1,
+                                         conduction2,
+                                         convection,
+                                         source1,
+                                         source2,
+                                         temperature_inf);
+        }
     }
     MPI_Finalize();
     
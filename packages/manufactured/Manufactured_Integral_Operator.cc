@@ -9,6 +9,7 @@
 
 #include "Angular_Discretization.hh"
 #include "Basis_Function.hh"
+#include "Cell_Basis_Values.hh"
 #include "Conversion.hh"
 #include "Energy_Discretization.hh"
 #include "Integration_Mesh.hh"
@@ -62,171 +63,152 @@ check_class_invariants() const
 
     if (initialized_)
     {
-        Assert(mesh_);
+        Assert(cell_values_);
+        Assert(expected_.size() == (angular_->number_of_moments()
+                                    * energy_->number_of_groups()
+                                    * cell_values_->ordinate_offsets().back()));
     }
 }
 
 void Manufactured_Integral_Operator::
-apply(vector<double> &x) const
+initialize() const
 {
-    // Get size data
-    int number_of_points = spatial_->number_of_points();
-    int number_of_groups = energy_->number_of_groups();
-    int number_of_moments = angular_->number_of_moments();
+    int const number_per_point = (angular_->number_of_moments()
+                                  * energy_->number_of_groups());
+
+    // Get basis values at the quadrature points of each cell
+    shared_ptr<Integration_Mesh> const mesh
+        = make_shared<Integration_Mesh>(spatial_->dimension(),
+                                        spatial_->number_of_points(),
+                                        integration_options_,
+                                        spatial_->bases(),
+                                        spatial_->weights());
+    cell_values_ = make_shared<Cell_Basis_Values>(mesh);
+    
+    // Ensure row size initialization is correct
+    int const number_of_cells = cell_values_->number_of_cells();
+    Assert(row_size_ == number_of_cells * number_per_point);
+    
+    // Get expected solution at the quadrature points of each cell
+    int const dimension = cell_values_->dimension();
+    vector<int> const &ordinate_offsets = cell_values_->ordinate_offsets();
+    expected_.resize(number_per_point * ordinate_offsets[number_of_cells]);
+    #pragma omp parallel for schedule(dynamic, 10)
+    for (int i = 0; i < number_of_cells; ++i)
+    {
+        Cell_Basis_Values::View const cell = cell_values_->view(i);
+        for (int q = 0; q < cell.number_of_ordinates; ++q)
+        {
+            vector<double> const position(cell.ordinates + dimension * q,
+                                          cell.ordinates + dimension * (q + 1));
+            vector<double> const expected
+                = solution_->get_solution(position);
+            Assert(expected.size() >= number_per_point);
+            copy(expected.begin(), expected.begin() + number_per_point, expected_.begin() + number_per_point * (ordinate_offsets[i] + q));
+        }
+    }
     
+    initialized_ = true;
+    check_class_invariants();
+}
+
+void Manufactured_Integral_Operator::
+apply(vector<double> &x) const
+{
     // Initialize if applicable
     if (!initialized_)
     {
-        mesh_ = make_shared<Integration_Mesh>(spatial_->dimension(),
-                                              number_of_points,
-                                              integration_options_,
-                                              spatial_->bases(),
-                                              spatial_->weights());
-        initialized_ = true;
-        check_class_invariants();
+        initialize();
     }
-
-    // Ensure row size initialization is correct
-    int number_of_cells = mesh_->number_of_cells();
-    Assert(row_size_ == (number_of_cells
-                         * angular_->number_of_moments()
-                         * energy_->number_of_groups()));
+    
+    // Get size data
+    int const number_per_point = (angular_->number_of_moments()
+                                  * energy_->number_of_groups());
+    int const number_of_cells = cell_values_->number_of_cells();
+    vector<int> const &ordinate_offsets = cell_values_->ordinate_offsets();
     
     // Apply operator
     vector<double> result(row_size_, 0.);
-    vector<double> norm(row_size_, 0.);
     #pragma omp parallel for schedule(dynamic, 10)
     for (int i = 0; i < number_of_cells; ++i)
     {
-        // Get cell
-        shared_ptr<Integration_Cell> const cell = mesh_->cell(i);
-        
-        // Get quadrature
-        int number_of_ordinates;
-        vector<vector<double> > ordinates;
-        vector<double> weights;
-        mesh_->get_volume_quadrature(i,
-                                     number_of_ordinates,
-                                     ordinates,
-                                     weights);
-
-        // Get center positions
-        vector<vector<double> > basis_centers;
-        mesh_->get_basis_centers(cell,
-                                 basis_centers);
+        // Get quadrature and flux at the quadrature points
+        Cell_Basis_Values::View const cell = cell_values_->view(i);
+        vector<double> flux;
+        cell_values_->get_values(i,
+                                 number_per_point,
+                                 x,
+                                 flux);
+        double const *const expected = &expected_[number_per_point * ordinate_offsets[i]];
         
-        for (int q = 0; q < number_of_ordinates; ++q)
+        for (int q = 0; q < cell.number_of_ordinates; ++q)
         {
-            // Get quadrature position and weight
-            double const weight = weights[q];
-            vector<double> const &position = ordinates[q];
-            
-            // Get volume values
-            vector<double> b_val;
-            mesh_->get_basis_values(cell,
-                                    position,
-                                    basis_centers,
-                                    b_val);
-            
-            // Get flux
-            vector<double> flux;
-            get_flux(cell,
-                     b_val,
-                     x,
-                     flux);
-
-            // Get expected solution
-            vector<double> expected
-                = solution_->get_solution(position);
+            double const weight = cell.weights[q];
             
             // Add to integral
             switch (options_.norm)
             {
             case Options::Norm::INTEGRAL:
-                for (int m = 0; m < number_of_moments; ++m)
+                for (int j = 0; j < number_per_point; ++j)
                 {
-                    for (int g = 0; g < number_of_groups; ++g)
-                    {
-                        int k_res = g + number_of_groups * (m + number_of_moments * i);
-                        int k_flux = g + number_of_groups * m;
+                    int k_res = j + number_per_point * i;
+                    int k_flux = j + number_per_point * q;
                     
-                        result[k_res] += (expected[k_flux] - flux[k_flux]) * weight;
-                    }
+                    result[k_res] += (expected[k_flux] - flux[k_flux]) * weight;
                 }
                 break;
             case Options::Norm::L1:
-                for (int m = 0; m < number_of_moments; ++m)
+                for (int j = 0; j < number_per_point; ++j)
                 {
-                    for (int g = 0; g < number_of_groups; ++g)
-                    {
-                        int k_res = g + number_of_groups * (m + number_of_moments * i);
-                        int k_flux = g + number_of_groups * m;
+                    int k_res = j + number_per_point * i;
+                    int k_flux = j + number_per_point * q;
                     
-                        result[k_res] += std::abs(expected[k_flux] - flux[k_flux]) * weight;
-                    }
+                    result[k_res] += std::abs(expected[k_flux] - flux[k_flux]) * weight;
                 }
                 break;
             case Options::Norm::L2:
-                for (int m = 0; m < number_of_moments; ++m)
+                for (int j = 0; j < number_per_point; ++j)
                 {
-                    for (int g = 0; g < number_of_groups; ++g)
-                    {
-                        int k_res = g + number_of_groups * (m + number_of_moments * i);
-                        int k_flux = g + number_of_groups * m;
-
-                        double val = expected[k_flux] - flux[k_flux];
-                        result[k_res] += val * val * weight;
-                    }
+                    int k_res = j + number_per_point * i;
+                    int k_flux = j + number_per_point * q;
+                    
+                    double val = expected[k_flux] - flux[k_flux];
+                    result[k_res] += val * val * weight;
                 }
                 break;
             case Options::Norm::LINF:
-                for (int m = 0; m < number_of_moments; ++m)
+                for (int j = 0; j < number_per_point; ++j)
                 {
-                    for (int g = 0; g < number_of_groups; ++g)
-                    {
-                        int k_res = g + number_of_groups * (m + number_of_moments * i);
-                        int k_flux = g + number_of_groups * m;
+                    int k_res = j + number_per_point * i;
+                    int k_flux = j + number_per_point * q;
 
-                        double val = std::abs(expected[k_flux] - flux[k_flux]);
-                        if (val > result[k_res])
-                        {
-                            result[k_res] = val;
-                        }
+                    double val = std::abs(expected[k_flux] - flux[k_flux]);
+                    if (val > result[k_res])
+                    {
+                        result[k_res] = val;
                     }
                 }
                 break;
             }
         }
         
-        // Get the volume (sum of weights)
-        double volume = 0;
-        for (double weight : weights)
-        { 
-            volume += weight;
-        }
-        
         // Normalize the result
+        double const volume = cell.volume;
         switch (options_.norm)
         {
         case Options::Norm::INTEGRAL: // fallthrough intentional
         case Options::Norm::L1:
-            for (int m = 0; m < number_of_moments; ++m)
+            for (int j = 0; j < number_per_point; ++j)
             {
-                for (int g = 0; g < number_of_groups; ++g)
-                {
-                    int k = g + number_of_groups * (m + number_of_moments * i);
-                    result[k] /= volume;
-                }
+                int k = j + number_per_point * i;
+                result[k] /= volume;
             }
             break;
         case Options::Norm::L2:
-            for (int m = 0; m < number_of_moments; ++m)
+            for (int j = 0; j < number_per_point; ++j)
             {
-                for (int g = 0; g < number_of_groups; ++g)
-                {
-                    int k = g + number_of_groups * (m + number_of_moments * i);
-                    result[k] = sqrt(result[k]) / volume;
-                }
+                int k = j + number_per_point * i;
+                result[k] = sqrt(result[k]) / volume;
             }
             break;
         case Options::Norm::LINF:
@@ -239,34 +221,6 @@ apply(vector<double> &x) const
     x.swap(result);
 }
 
-void Manufactured_Integral_Operator::
-get_flux(shared_ptr<Integration_Cell> const cell,
-         vector<double> const &b_val,
-         vector<double> const &coeff,
-         vector<double> &flux) const
-{
-    // Get size information
-    int const number_of_groups = energy_->number_of_groups();
-    int const number_of_moments = angular_->number_of_moments();
-
-    // Calculate flux
-    flux.assign(number_of_groups * number_of_moments, 0.);
-    for (int i = 0; i < cell->number_of_basis_functions; ++i)
-    {
-        int const j = cell->basis_indices[i];
-        for (int m = 0; m < number_of_moments; ++m)
-        {
-            for (int g = 0; g < number_of_groups; ++g)
-            {
-                int const k_f = g + number_of_groups * m; // Local flux index
-                int const k_c = g + number_of_groups * (m + number_of_moments * j); // Global coefficient index
-
-                flux[k_f] += b_val[i] * coeff[k_c];
-            }
-        }
-    }
-}
-
 shared_ptr<Conversion<Manufactured_Integral_Operator::Options::Norm, string> > Manufactured_Integral_Operator::Options::
 norm_conversion() const
 {
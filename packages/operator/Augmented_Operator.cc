@@ -19,10 +19,11 @@ Augmented_Operator(int number_of_augments,
 void Augmented_Operator::
 apply(vector<double> &x) const
 {
-    int operator_row_size = vector_operator_->row_size();
     int operator_column_size = vector_operator_->column_size();
-    
-    vector<double> y(x.begin() + operator_column_size, x.end());
+
+    // Keep augments in the workspace while the operator is applied
+    vector<double> &y = workspace_;
+    y.assign(x.begin() + operator_column_size, x.end());
     x.resize(operator_column_size);
     (*vector_operator_)(x);
     
@@ -36,6 +37,27 @@ apply(vector<double> &x) const
     }
 }
 
+void Augmented_Operator::
+apply_out_of_place(vector<double> const &x,
+                   vector<double> &y) const
+{
+    int operator_column_size = vector_operator_->column_size();
+
+    // Apply operator to the values without augments
+    vector<double> &z = workspace_;
+    z.assign(x.begin(), x.begin() + operator_column_size);
+    (*vector_operator_)(z, y);
+
+    if (zero_out_augments_)
+    {
+        y.resize(row_size(), 0);
+    }
+    else
+    {
+        y.insert(y.end(), x.begin() + operator_column_size, x.end());
+    }
+}
+
 void Augmented_Operator::
 check_class_invariants() const
 {
@@ -28,10 +28,20 @@ public:
         return vector_operator_->column_size() + number_of_augments_;
     }
     virtual std::string description() const override;
+    virtual void set_inner_tolerance(double tolerance) override
+    {
+        vector_operator_->set_inner_tolerance(tolerance);
+    }
+    virtual void reset_inner_tolerance() override
+    {
+        vector_operator_->reset_inner_tolerance();
+    }
     
 private:
     
     virtual void apply(std::vector<double> &x) const override;
+    virtual void apply_out_of_place(std::vector<double> const &x,
+                                    std::vector<double> &y) const override;
 
     bool zero_out_augments_;
     int number_of_augments_;
@@ -17,7 +17,8 @@ Aztec_Inverse_Operator::
 Aztec_Inverse_Operator(Options options,
                        shared_ptr<Vector_Operator> vector_operator):
     Inverse_Operator(vector_operator),
-    options_(options)
+    options_(options),
+    inner_tolerance_(options.tolerance)
 {
     initialize_trilinos(true);
     check_class_invariants();
@@ -30,6 +31,7 @@ Aztec_Inverse_Operator(Options options,
                        shared_ptr<Epetra_Map> map):
     Inverse_Operator(vector_operator),
     options_(options),
+    inner_tolerance_(options.tolerance),
     comm_(comm),
     map_(map)
 {
@@ -49,12 +51,20 @@ initialize_trilinos(bool initialize_comm)
     rhs_ = make_shared<Epetra_Vector>(*map_);
     oper_ = make_shared<Epetra_Operator_Interface>(comm_,
                                                    map_,
-                                                   vector_operator_);
+                                                   vector_operator_,
+                                                   options_.preconditioner);
     problem_ = make_shared<Epetra_LinearProblem>(oper_.get(),
                                                  lhs_.get(),
                                                  rhs_.get());
     solver_ = make_shared<AztecOO>(*problem_);
-    solver_->SetAztecOption(AZ_precond, AZ_none);
+    if (options_.preconditioner)
+    {
+        solver_->SetPrecOperator(oper_.get());
+    }
+    else
+    {
+        solver_->SetAztecOption(AZ_precond, AZ_none);
+    }
     solver_->SetAztecOption(AZ_solver, AZ_gmres);
     solver_->SetAztecOption(AZ_kspace, options_.kspace);
     solver_->SetAztecOption(AZ_conv, AZ_rhs);
@@ -80,7 +90,7 @@ apply(vector<double> &x) const
     }
     
     solver_->Iterate(options_.max_iterations,
-                     options_.tolerance);
+                     inner_tolerance_);
     number_of_iterations_ += solver_->NumIters();
     
     lhs_->ExtractCopy(&x[0]);
@@ -99,6 +109,11 @@ check_class_invariants() const
     Assert(problem_);
     Assert(solver_);
     Assert(map_->NumMyElements() == size_);
+    if (options_.preconditioner)
+    {
+        Assert(options_.preconditioner->square());
+        Assert(options_.preconditioner->row_size() == size_);
+    }
 }
 
 string Aztec_Inverse_Operator::
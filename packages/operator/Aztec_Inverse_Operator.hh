@@ -14,6 +14,9 @@ class Epetra_Vector;
 
 /*
   Inverts a Vector_Operator
+
+  An optional preconditioner approximates the inverse of the operator and is
+  reused for every application of the inverse
 */
 class Aztec_Inverse_Operator : public Inverse_Operator
 {
@@ -25,6 +28,7 @@ public:
         int kspace = 20;
         int solver_print = 0;
         double tolerance = 1e-10;
+        std::shared_ptr<Vector_Operator> preconditioner;
     };
     
     // Constructor
@@ -40,6 +44,17 @@ public:
     
     virtual std::string description() const override;
 
+    // Set the tolerance of the GMRES solve, or return to the tolerance given
+    // in the options
+    virtual void set_inner_tolerance(double tolerance) override
+    {
+        inner_tolerance_ = tolerance;
+    }
+    virtual void reset_inner_tolerance() override
+    {
+        inner_tolerance_ = options_.tolerance;
+    }
+
     virtual int number_of_iterations() const
     {
         return number_of_iterations_;
@@ -53,6 +68,7 @@ private:
     // Solver data
     mutable int number_of_iterations_ = 0;
     Options options_;
+    double inner_tolerance_;
     std::shared_ptr<Epetra_Comm> comm_;
     std::shared_ptr<Epetra_Map> map_;
     std::shared_ptr<Epetra_Vector> lhs_;
@@ -12,6 +12,8 @@
 #include "Cross_Section.hh"
 #include "Dimensional_Moments.hh"
 #include "Energy_Discretization.hh"
+#include "Fission_Table.hh"
+#include "Integral_Store.hh"
 #include "Material.hh"
 #include "Weak_Spatial_Discretization.hh"
 #include "Weight_Function.hh"
@@ -28,6 +30,12 @@ Basis_Fission(shared_ptr<Weak_Spatial_Discretization> spatial_discretization,
                              energy_discretization,
                              options)
 {
+    // Get fission cross sections of the interned materials, factored where possible
+    fission_table_
+        = make_shared<Fission_Table>(energy_discretization->number_of_groups(),
+                                     spatial_discretization->dimensional_moments()->number_of_dimensional_moments(),
+                                     spatial_discretization->material_table());
+    
     check_class_invariants();
 }
 
@@ -37,6 +45,8 @@ check_class_invariants() const
     Assert(spatial_discretization_);
     Assert(angular_discretization_);
     Assert(energy_discretization_);
+    Assert(fission_table_);
+    Assert(fission_table_->number_of_points() == spatial_discretization_->number_of_points());
     Assert(spatial_discretization_->options()->weighting
            == Weak_Spatial_Discretization_Options::Weighting::BASIS);
     
@@ -61,64 +71,85 @@ apply_full(vector<double> &x) const
     int number_of_nodes = spatial_discretization_->number_of_nodes();
     int number_of_groups = energy_discretization_->number_of_groups();
     int number_of_moments = angular_discretization_->number_of_moments();
-    int number_of_scattering_moments = angular_discretization_->number_of_scattering_moments();
-    vector<int> const scattering_indices = angular_discretization_->scattering_indices();
+    Fission_Table const &table = *fission_table_;
     
     // Get dimensional moments
     shared_ptr<Dimensional_Moments> dimensional_moments = spatial_discretization_->dimensional_moments();
     int number_of_dimensional_moments = dimensional_moments->number_of_dimensional_moments();
     
-    // Copy source flux
-    vector<double> y(x);
+    // Move source flux into the workspace
+    vector<double> &y = workspace_;
+    y.swap(x);
     x.assign(number_of_points * number_of_nodes * number_of_groups * number_of_moments * number_of_dimensional_moments, 0);
     #pragma omp parallel for schedule(dynamic, 10)
     for (int i = 0; i < number_of_points; ++i)
     {
         // Get weight function and connectivity information
-        shared_ptr<Weight_Function> weight = spatial_discretization_->weight(i);
-        int const number_of_basis_functions = weight->number_of_basis_functions();
-        vector<int> const basis_function_indices = weight->basis_function_indices();
-        Weight_Function::Integrals const integrals = weight->integrals();
-        vector<double> const &iv_b_w = integrals.iv_b_w;
-        vector<double> const &iv_b_dw = integrals.iv_b_dw;
+        Integral_Store::View const integrals = spatial_discretization_->integral_store()->view(i);
+        int const number_of_basis_functions = integrals.number_of_basis_functions;
+        int const *basis_function_indices = integrals.basis_function_indices;
+        double const *iv_b_w = integrals.iv_b_w;
+        double const *iv_b_dw = integrals.iv_b_dw;
         
-        // Perform scattering
+        // Perform fission
         int const m = 0;
-        for (int gt = 0; gt < number_of_groups; ++gt)
+        for (int n = 0; n < number_of_nodes; ++n)
         {
-            for (int n = 0; n < number_of_nodes; ++n)
+            for (int d = 0; d < number_of_dimensional_moments; ++d)
             {
-                for (int d = 0; d < number_of_dimensional_moments; ++d)
+                for (int j = 0; j < number_of_basis_functions; ++j)
                 {
-                    double sum = 0;
-                        
-                    for (int j = 0; j < number_of_basis_functions; ++j)
+                    // Get summation constants and other basis data
+                    int b = basis_function_indices[j];
+                    double mult = (d == 0
+                                   ? iv_b_w[j]
+                                   : iv_b_dw[d - 1 + dimension * j]);
+                    double const *y_from = &y[number_of_nodes * number_of_groups * (m + number_of_moments * b)];
+                    
+                    // Get cross section information: stored in weight functions but weighted by basis functions
+                    int const t = table.table_index(b);
+                    if (table.factored(t))
                     {
-                        // Get summation constants and other basis data
-                        int b = basis_function_indices[j];
-                        double mult = (d == 0
-                                       ? iv_b_w[j]
-                                       : iv_b_dw[d - 1 + dimension * j]);
-                            
-                        // Get cross section information: stored in weight functions but weighted by basis functions
-                        vector<double> const sigma_f
-                            = spatial_discretization_->weight(b)->material()->sigma_f()->data();
-                            
+                        double const *chi = table.chi(t);
+                        double const *nu_sigma_f = table.nu_sigma_f(t);
+                        double fission_source = 0;
+                        
                         for (int gf = 0; gf < number_of_groups; ++gf)
                         {
-                            int k_phi_from = n + number_of_nodes * (gf + number_of_groups * (m + number_of_moments * b));
-                            int k_sigma = d + number_of_dimensional_moments * (gf + number_of_groups * gt);
-                            
-                            sum += sigma_f[k_sigma] * mult * y[k_phi_from];
+                            fission_source += nu_sigma_f[d + number_of_dimensional_moments * gf] * y_from[n + number_of_nodes * gf];
                         } // from group
-                    } // basis functions
+                        fission_source *= mult;
                         
-                    int k_phi_to = n + number_of_nodes * (d + number_of_dimensional_moments * (gt + number_of_groups * (m + number_of_moments * i)));
+                        for (int gt = 0; gt < number_of_groups; ++gt)
+                        {
+                            int k_phi_to = n + number_of_nodes * (d + number_of_dimensional_moments * (gt + number_of_groups * (m + number_of_moments * i)));
+                            
+                            x[k_phi_to] += chi[gt] * fission_source;
+                        } // to group
+                    }
+                    else
+                    {
+                        double const *sigma_f = table.sigma_f(t);
                         
-                    x[k_phi_to] = sum;
-                } // dimensional moments
-            } // nodes
-        } // to group
+                        for (int gt = 0; gt < number_of_groups; ++gt)
+                        {
+                            double sum = 0;
+                            
+                            for (int gf = 0; gf < number_of_groups; ++gf)
+                            {
+                                int k_sigma = d + number_of_dimensional_moments * (gf + number_of_groups * gt);
+                                
+                                sum += sigma_f[k_sigma] * y_from[n + number_of_nodes * gf];
+                            } // from group
+                            
+                            int k_phi_to = n + number_of_nodes * (d + number_of_dimensional_moments * (gt + number_of_groups * (m + number_of_moments * i)));
+                            
+                            x[k_phi_to] += mult * sum;
+                        } // to group
+                    }
+                } // basis functions
+            } // dimensional moments
+        } // nodes
     } // weight functions
 }
 
@@ -6,6 +6,8 @@
 
 #include "Full_Scattering_Operator.hh"
 
+class Fission_Table;
+
 /*
   Applies scattering to a moment representation of the flux
 */
@@ -33,6 +35,9 @@ private:
     
     // Apply only within-group scattering
     virtual void apply_coherent(std::vector<double> &x) const override;
+
+    // Fission cross sections of each weight function, factored where possible
+    std::shared_ptr<Fission_Table> fission_table_;
 };
 
 #endif
@@ -12,6 +12,7 @@
 #include "Cross_Section.hh"
 #include "Dimensional_Moments.hh"
 #include "Energy_Discretization.hh"
+#include "Integral_Store.hh"
 #include "Material.hh"
 #include "Weak_Spatial_Discretization.hh"
 #include "Weight_Function.hh"
@@ -75,12 +76,11 @@ apply_full(vector<double> &x) const
     for (int i = 0; i < number_of_points; ++i)
     {
         // Get weight function and connectivity information
-        shared_ptr<Weight_Function> weight = spatial_discretization_->weight(i);
-        int const number_of_basis_functions = weight->number_of_basis_functions();
-        vector<int> const basis_function_indices = weight->basis_function_indices();
-        Weight_Function::Integrals const integrals = weight->integrals();
-        vector<double> const &iv_b_w = integrals.iv_b_w;
-        vector<double> const &iv_b_dw = integrals.iv_b_dw;
+        Integral_Store::View const integrals = spatial_discretization_->integral_store()->view(i);
+        int const number_of_basis_functions = integrals.number_of_basis_functions;
+        int const *basis_function_indices = integrals.basis_function_indices;
+        double const *iv_b_w = integrals.iv_b_w;
+        double const *iv_b_dw = integrals.iv_b_dw;
         
         // Perform scattering
         for (int m = 0; m < number_of_moments; ++m)
@@ -104,7 +104,7 @@ apply_full(vector<double> &x) const
                                            : iv_b_dw[d - 1 + dimension * j]);
                             
                             // Get cross section information: stored in weight functions but weighted by basis functions
-                            vector<double> const sigma_s
+                            vector<double> const &sigma_s
                                 = spatial_discretization_->weight(b)->material()->sigma_s()->data();
                             
                             for (int gf = 0; gf < number_of_groups; ++gf)
@@ -12,7 +12,9 @@
 #include "Cross_Section.hh"
 #include "Dimensional_Moments.hh"
 #include "Energy_Discretization.hh"
+#include "Fission_Table.hh"
 #include "Material.hh"
+#include "Material_Table.hh"
 #include "Point.hh"
 #include "Weak_Spatial_Discretization.hh"
 
@@ -28,6 +30,12 @@ Combined_SUPG_Fission(shared_ptr<Weak_Spatial_Discretization> spatial_discretiza
                            energy_discretization,
                            options)
 {
+    // Get fission cross sections of the interned materials, factored where possible
+    fission_table_
+        = make_shared<Fission_Table>(energy_discretization->number_of_groups(),
+                                     spatial_discretization->dimensional_moments()->number_of_dimensional_moments(),
+                                     spatial_discretization->material_table());
+    
     check_class_invariants();
 }
 
@@ -37,6 +45,9 @@ check_class_invariants() const
     Assert(spatial_discretization_);
     Assert(angular_discretization_);
     Assert(energy_discretization_);
+    Assert(spatial_discretization_->material_table());
+    Assert(fission_table_);
+    Assert(fission_table_->number_of_points() == spatial_discretization_->number_of_points());
 
     int number_of_points = spatial_discretization_->number_of_points();
     for (int i = 0; i < number_of_points; ++i)
@@ -67,13 +78,16 @@ apply_full(vector<double> &x) const
     int const number_of_moments = angular_discretization_->number_of_moments();
     int const number_of_ordinates = angular_discretization_->number_of_ordinates();
     double const angular_normalization = angular_discretization_->angular_normalization();
+    Fission_Table const &table = *fission_table_;
+    Material_Table const &material_table = *spatial_discretization_->material_table();
     
     // Get dimensional moments
     shared_ptr<Dimensional_Moments> const dimensional_moments = spatial_discretization_->dimensional_moments();
     int const number_of_dimensional_moments = dimensional_moments->number_of_dimensional_moments();
     
-    // Copy source flux
-    vector<double> y(x);
+    // Move source flux into the workspace
+    vector<double> &y = workspace_;
+    y.swap(x);
     x.assign(number_of_points * number_of_groups * number_of_ordinates, 0);
     int const m = 0;
     #pragma omp parallel for schedule(dynamic, 10)
@@ -84,11 +98,8 @@ apply_full(vector<double> &x) const
         double const tau = weight->options()->tau;
         
         // Get cross section information
-        shared_ptr<Material> const material = weight->material();
-        shared_ptr<Cross_Section> const sigma_f_cs = material->sigma_f();
-        shared_ptr<Cross_Section> const norm_cs = material->norm();
-        vector<double> const sigma_f = sigma_f_cs->data();
-        vector<double> const norm = norm_cs->data();
+        double const *norm = material_table.view(i).norm;
+        int const t = table.table_index(i);
         for (int o = 0; o < number_of_ordinates; ++o)
         {
             vector<double> const direction = angular_discretization_->direction(o);
@@ -96,10 +107,13 @@ apply_full(vector<double> &x) const
                 = dimensional_moments->coefficients(tau,
                                                     direction);
             
-            for (int gt = 0; gt < number_of_groups; ++gt)
+            if (table.factored(t))
             {
-                // Apply fission operator
-                double fission = 0;
+                double const *chi = table.chi(t);
+                double const *nu_sigma_f = table.nu_sigma_f(t);
+                
+                // Calculate fission source, which is shared by all groups
+                double fission_source = 0;
                 for (int gf = 0; gf < number_of_groups; ++gf)
                 {
                     // Get summations of dimensional moments
@@ -108,20 +122,55 @@ apply_full(vector<double> &x) const
                     double den = 0;
                     for (int d = 0; d < number_of_dimensional_moments; ++d)
                     {
-                        int const k_sf = d + number_of_dimensional_moments * (gf + number_of_groups * gt);
+                        int const k_sf = d + number_of_dimensional_moments * gf;
                         int const k_norm = d + number_of_dimensional_moments * (gf + number_of_groups * m);
                         int const k_phi = d + number_of_dimensional_moments * (gf + number_of_groups * (m + number_of_moments * i));
                         phi += y[k_phi] * coeffs[d];
-                        num += sigma_f[k_sf] * coeffs[d];
+                        num += nu_sigma_f[k_sf] * coeffs[d];
                         den += norm[k_norm] * coeffs[d];
                     }
                     
-                    fission += num / den * phi;
+                    fission_source += num / den * phi;
                 }
                 
                 // Apply angular normalization and assign result
-                int const k_psi = gt + number_of_groups * (o + number_of_ordinates * i);
-                x[k_psi] = fission / angular_normalization;
+                for (int gt = 0; gt < number_of_groups; ++gt)
+                {
+                    int const k_psi = gt + number_of_groups * (o + number_of_ordinates * i);
+                    x[k_psi] = chi[gt] * fission_source / angular_normalization;
+                }
+            }
+            else
+            {
+                double const *sigma_f = table.sigma_f(t);
+                
+                for (int gt = 0; gt < number_of_groups; ++gt)
+                {
+                    // Apply fission operator
+                    double fission = 0;
+                    for (int gf = 0; gf < number_of_groups; ++gf)
+                    {
+                        // Get summations of dimensional moments
+                        double phi = 0;
+                        double num = 0;
+                        double den = 0;
+                        for (int d = 0; d < number_of_dimensional_moments; ++d)
+                        {
+                            int const k_sf = d + number_of_dimensional_moments * (gf + number_of_groups * gt);
+                            int const k_norm = d + number_of_dimensional_moments * (gf + number_of_groups * m);
+                            int const k_phi = d + number_of_dimensional_moments * (gf + number_of_groups * (m + number_of_moments * i));
+                            phi += y[k_phi] * coeffs[d];
+                            num += sigma_f[k_sf] * coeffs[d];
+                            den += norm[k_norm] * coeffs[d];
+                        }
+                        
+                        fission += num / den * phi;
+                    }
+                    
+                    // Apply angular normalization and assign result
+                    int const k_psi = gt + number_of_groups * (o + number_of_ordinates * i);
+                    x[k_psi] = fission / angular_normalization;
+                }
             }
         }
     }
@@ -13,6 +13,7 @@
 #include "Dimensional_Moments.hh"
 #include "Energy_Discretization.hh"
 #include "Material.hh"
+#include "Material_Table.hh"
 #include "Point.hh"
 #include "Weak_Spatial_Discretization.hh"
 
@@ -37,6 +38,7 @@ check_class_invariants() const
     Assert(spatial_discretization_);
     Assert(angular_discretization_);
     Assert(energy_discretization_);
+    Assert(spatial_discretization_->material_table());
 
     int number_of_points = spatial_discretization_->number_of_points();
     for (int i = 0; i < number_of_points; ++i)
@@ -76,6 +78,7 @@ apply_full(vector<double> &x) const
     // Copy source flux
     vector<double> y(x);
     x.assign(number_of_points * number_of_groups * number_of_ordinates, 0);
+    Material_Table const &material_table = *spatial_discretization_->material_table();
     #pragma omp parallel for schedule(dynamic, 10)
     for (int i = 0; i < number_of_points; ++i)
     {
@@ -86,9 +89,8 @@ apply_full(vector<double> &x) const
         // Get cross section information
         shared_ptr<Material> const material = weight->material();
         shared_ptr<Cross_Section> const sigma_s_cs = material->sigma_s();
-        shared_ptr<Cross_Section> const norm_cs = material->norm();
-        vector<double> const sigma_s = sigma_s_cs->data();
-        vector<double> const norm = norm_cs->data();
+        vector<double> const &sigma_s = sigma_s_cs->data();
+        double const *norm = material_table.view(i).norm;
         for (int o = 0; o < number_of_ordinates; ++o)
         {
             vector<double> const direction = angular_discretization_->direction(o);
@@ -7,6 +7,7 @@
 #include "Angular_Discretization.hh"
 #include "Dimensional_Moments.hh"
 #include "Energy_Discretization.hh"
+#include "Integral_Store.hh"
 #include "Weak_Spatial_Discretization.hh"
 #include "Weight_Function.hh"
 
@@ -79,18 +80,16 @@ apply(vector<double> &x) const
         {
             // Get weight function and data
             shared_ptr<Weight_Function> weight = spatial_->weight(i);
-            int number_of_basis_functions = weight->number_of_basis_functions();
-            vector<int> basis_indices = weight->basis_function_indices();
-            Weight_Function::Integrals const integrals = weight->integrals();
+            Integral_Store::View const integrals = spatial_->integral_store()->view(i);
             shared_ptr<Weight_Function_Options> const weight_options = weight->options();
             double const tau = weight_options->tau;
-            vector<double> const &iv_w = integrals.iv_w;
-            vector<double> const &iv_dw = integrals.iv_dw;
+            double const *iv_w = integrals.iv_w;
+            double const *iv_dw = integrals.iv_dw;
         
             for (int o = 0; o < number_of_ordinates; ++o)
             {
                 // Get normalization constant
-                vector<double> const direction = angular_->direction(o);
+                vector<double> const &direction = angular_->direction(o);
                 double norm = 1;
                 norm = iv_w[0];
                 if (include_supg)
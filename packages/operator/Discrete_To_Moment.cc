@@ -4,6 +4,8 @@
     #include <omp.h>
 #endif
 
+#include <Eigen/Dense>
+
 #include "Angular_Discretization.hh"
 #include "Check.hh"
 #include "Energy_Discretization.hh"
@@ -12,6 +14,10 @@
 using std::shared_ptr;
 using std::vector;
 
+typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> EMatrix;
+typedef Eigen::Map<EMatrix> EMMatrix;
+typedef Eigen::Map<EMatrix const> ECMMatrix;
+
 Discrete_To_Moment::
 Discrete_To_Moment(shared_ptr<Spatial_Discretization> spatial_discretization,
                    shared_ptr<Angular_Discretization> angular_discretization,
@@ -31,6 +37,21 @@ Discrete_To_Moment(shared_ptr<Spatial_Discretization> spatial_discretization,
                     * angular_discretization->number_of_ordinates());
     row_size_ = phi_size;
     column_size_ = psi_size;
+
+    // Precompute the discrete-to-moment matrix
+    int number_of_moments = angular_discretization->number_of_moments();
+    int number_of_ordinates = angular_discretization->number_of_ordinates();
+    vector<double> const &weights = angular_discretization->weights();
+    discrete_to_moment_.resize(number_of_ordinates * number_of_moments);
+    for (int m = 0; m < number_of_moments; ++m)
+    {
+        for (int o = 0; o < number_of_ordinates; ++o)
+        {
+            int k = o + number_of_ordinates * m;
+            
+            discrete_to_moment_[k] = weights[o] * angular_discretization->moment(m, o);
+        }
+    }
     
     check_class_invariants();
 }
@@ -38,43 +59,32 @@ Discrete_To_Moment(shared_ptr<Spatial_Discretization> spatial_discretization,
 void Discrete_To_Moment::
 apply(vector<double> &x) const
 {
-    vector<double> y(x);
-    
-    x.resize(row_size());
+    apply_from_workspace(x);
+}
+
+void Discrete_To_Moment::
+apply_out_of_place(vector<double> const &x,
+                   vector<double> &y) const
+{
+    y.resize(row_size());
     
     int number_of_points = spatial_discretization_->number_of_points();
     int number_of_nodes = spatial_discretization_->number_of_nodes();
     int number_of_groups = energy_discretization_->number_of_groups();
     int number_of_moments = angular_discretization_->number_of_moments();
     int number_of_ordinates = angular_discretization_->number_of_ordinates();
-    vector<double> const weights = angular_discretization_->weights();
-    vector<double> const ordinates = angular_discretization_->ordinates();
+    int local_size = number_of_nodes * number_of_groups;
+    ECMMatrix const discrete_to_moment(&discrete_to_moment_[0], number_of_ordinates, number_of_moments);
 
+    // For each point, the discrete values form a (nodes * groups) x ordinates
+    // matrix and the moments a (nodes * groups) x moments matrix
     #pragma omp parallel for schedule(dynamic, 10)
     for (int i = 0; i < number_of_points; ++i)
     {
-        for (int g = 0; g < number_of_groups; ++g)
-        {
-            for (int n = 0; n < number_of_nodes; ++n)
-            {
-                for (int m = 0; m < number_of_moments; ++m)
-                {
-                    double sum = 0;
-                    
-                    for (int o = 0; o < number_of_ordinates; ++o)
-                    {
-                        int k = n + number_of_nodes * (g + number_of_groups * (o + number_of_ordinates * i));
-                        double p = angular_discretization_->moment(m, o);
-                        
-                        sum += weights[o] * p * y[k];
-                    }
-                    
-                    int k = n + number_of_nodes * (g + number_of_groups * (m + number_of_moments * i));
-                    
-                    x[k] = sum;
-                }
-            }
-        }
+        ECMMatrix const psi(&x[local_size * number_of_ordinates * i], local_size, number_of_ordinates);
+        EMMatrix phi(&y[local_size * number_of_moments * i], local_size, number_of_moments);
+        
+        phi.noalias() = psi * discrete_to_moment;
     }
 }
 
@@ -84,4 +94,6 @@ check_class_invariants() const
     Assert(spatial_discretization_);
     Assert(angular_discretization_);
     Assert(energy_discretization_);
+    Assert(discrete_to_moment_.size() == (angular_discretization_->number_of_ordinates()
+                                          * angular_discretization_->number_of_moments()));
 }
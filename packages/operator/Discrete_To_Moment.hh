@@ -40,12 +40,18 @@ public:
 private:
     
     virtual void apply(std::vector<double> &x) const override;
+    virtual void apply_out_of_place(std::vector<double> const &x,
+                                    std::vector<double> &y) const override;
 
     int row_size_;
     int column_size_;
     std::shared_ptr<Spatial_Discretization> spatial_discretization_;
     std::shared_ptr<Angular_Discretization> angular_discretization_;
     std::shared_ptr<Energy_Discretization> energy_discretization_;
+
+    // Discrete-to-moment matrix, w(o) * P_m(o), column-major with
+    // ordinates as rows and moments as columns
+    std::vector<double> discrete_to_moment_;
 };
 
 #endif
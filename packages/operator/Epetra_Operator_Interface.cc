@@ -1,18 +1,29 @@
-#include "Check.hh"
 #include "Epetra_Operator_Interface.hh"
 
+#include <algorithm>
+
+#include "Check.hh"
+
+using std::copy;
 using std::shared_ptr;
 using std::vector;
 
 Epetra_Operator_Interface::
 Epetra_Operator_Interface(shared_ptr<Epetra_Comm> const &comm,
                           shared_ptr<Epetra_Map> const &map,
-                          shared_ptr<Vector_Operator> const &oper):
+                          shared_ptr<Vector_Operator> const &oper,
+                          shared_ptr<Vector_Operator> const &inverse_oper):
     comm_(comm),
     map_(map),
-    oper_(oper)
+    oper_(oper),
+    inverse_oper_(inverse_oper)
 {
     Check(oper_->square());
+    if (inverse_oper_)
+    {
+        Check(inverse_oper_->row_size() == oper_->row_size());
+        Check(inverse_oper_->square());
+    }
 }
 
 Epetra_Operator_Interface::
@@ -24,36 +35,49 @@ int Epetra_Operator_Interface::
 Apply(Epetra_MultiVector const &X,
       Epetra_MultiVector &Y) const
 {
-    Assert(X.NumVectors() == Y.NumVectors());
+    return apply_operator(*oper_,
+                          X,
+                          Y);
+}
 
-    int const size = oper_->row_size();
-    int const number_of_vectors = X.NumVectors();
-    
-    vector<double> x(size * number_of_vectors);
-    X.ExtractCopy(&x[0], X.Stride());
-    
-    if (number_of_vectors > 1)
+int Epetra_Operator_Interface::
+ApplyInverse(Epetra_MultiVector const &X,
+             Epetra_MultiVector &Y) const
+{
+    // Do nothing if explicit inverse is not available
+    if (!inverse_oper_)
     {
-        for (int i = 0; i < number_of_vectors; ++i)
-        {
-            vector<double> x1(x.begin() + i * size, x.begin() + (i + 1) * size);
-            
-            (*oper_)(x1);
-            
-            for (int j = 0; j < size; ++j)
-            {
-                Y.ReplaceGlobalValue(j, i, x1[j]);
-            }
-        }
+        return 1;
     }
-    else
+    
+    return apply_operator(*inverse_oper_,
+                          X,
+                          Y);
+}
+
+int Epetra_Operator_Interface::
+apply_operator(Vector_Operator &oper,
+               Epetra_MultiVector const &X,
+               Epetra_MultiVector &Y) const
+{
+    Assert(X.NumVectors() == Y.NumVectors());
+    Assert(X.MyLength() == oper.column_size());
+    Assert(Y.MyLength() == oper.row_size());
+    
+    int const number_of_vectors = X.NumVectors();
+    
+    // Apply the operator to each column, reading from and writing to the
+    // column storage of the multivectors directly
+    // The columns are applied in turn, as the operators are not reentrant
+    vector<double> x;
+    for (int i = 0; i < number_of_vectors; ++i)
     {
-        (*oper_)(x);
+        double const *const x_column = X[i];
+        x.assign(x_column, x_column + X.MyLength());
+        
+        oper(x);
         
-        for (int i = 0; i < size; ++i)
-        {
-            Y.ReplaceGlobalValue(i, 0, x[i]);
-        }
+        copy(x.begin(), x.end(), Y[i]);
     }
     
     return 0;
@@ -18,6 +18,8 @@
   Wraps a Vector_Operator to create an Epetra_Operator object
   
   Useful for Krylov solves, in which the matrix does not need to be explicit
+  
+  An approximate inverse can be given to use the object as a preconditioner
 */
 class Epetra_Operator_Interface: public Epetra_Operator
 {
@@ -26,7 +28,8 @@ public:
     // Creator
     Epetra_Operator_Interface(std::shared_ptr<Epetra_Comm> const &comm,
                               std::shared_ptr<Epetra_Map> const &map,
-                              std::shared_ptr<Vector_Operator> const &oper);
+                              std::shared_ptr<Vector_Operator> const &oper,
+                              std::shared_ptr<Vector_Operator> const &inverse_oper = std::shared_ptr<Vector_Operator>());
 
     // Destructor
     ~Epetra_Operator_Interface();
@@ -41,12 +44,9 @@ public:
     virtual int Apply(Epetra_MultiVector const &X,
                       Epetra_MultiVector &Y) const override;
     
-    // Do nothing, as explicit inverse is not available
+    // Apply the inverse Vector_Operator, if available
     virtual int ApplyInverse(Epetra_MultiVector const &X,
-                             Epetra_MultiVector &Y) const override
-    {
-        return 1;
-    }
+                             Epetra_MultiVector &Y) const override;
     
     // Cannot provide inf norm
     virtual double NormInf() const override
@@ -92,10 +92,16 @@ public:
     
 
 private:
+
+    // Apply a Vector_Operator to each vector
+    int apply_operator(Vector_Operator &oper,
+                       Epetra_MultiVector const &X,
+                       Epetra_MultiVector &Y) const;
     
     std::shared_ptr<Epetra_Comm> comm_;
     std::shared_ptr<Epetra_Map> map_;
     std::shared_ptr<Vector_Operator> oper_;
+    std::shared_ptr<Vector_Operator> inverse_oper_;
 };
 
 #endif
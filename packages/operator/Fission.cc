@@ -12,6 +12,7 @@
 #include "Cross_Section.hh"
 #include "Dimensional_Moments.hh"
 #include "Energy_Discretization.hh"
+#include "Fission_Table.hh"
 #include "Material.hh"
 #include "Point.hh"
 #include "Spatial_Discretization.hh"
@@ -28,6 +29,12 @@ Fission(shared_ptr<Spatial_Discretization> spatial_discretization,
                         energy_discretization,
                         options)
 {
+    // Get fission cross sections of the interned materials, factored where possible
+    fission_table_
+        = make_shared<Fission_Table>(energy_discretization->number_of_groups(),
+                                     spatial_discretization->dimensional_moments()->number_of_dimensional_moments(),
+                                     spatial_discretization->material_table());
+    
     check_class_invariants();
 }
 
@@ -37,6 +44,8 @@ check_class_invariants() const
     Assert(spatial_discretization_);
     Assert(angular_discretization_);
     Assert(energy_discretization_);
+    Assert(fission_table_);
+    Assert(fission_table_->number_of_points() == spatial_discretization_->number_of_points());
 
     int number_of_points = spatial_discretization_->number_of_points();
     
@@ -71,89 +80,68 @@ check_class_invariants() const
 void Fission::
 apply_full(vector<double> &x) const
 {
-    switch (spatial_discretization_->point(0)->material()->sigma_f()->dependencies().energy)
-    {
-    case Cross_Section::Dependencies::Energy::GROUP:
-        group_full(x);
-        break;
-    case Cross_Section::Dependencies::Energy::GROUP_TO_GROUP:
-        group_to_group_full(x);
-        break;
-    default:
-        Assert(false);
-        break;
-    }
-}
-
-void Fission::
-apply_coherent(vector<double> &x) const
-{
-    switch (spatial_discretization_->point(0)->material()->sigma_f()->dependencies().energy)
-    {
-    case Cross_Section::Dependencies::Energy::GROUP:
-        group_coherent(x);
-        break;
-    case Cross_Section::Dependencies::Energy::GROUP_TO_GROUP:
-        group_to_group_coherent(x);
-        break;
-    default:
-        Assert(false);
-        break;
-    }
-}
-
-void Fission::
-group_to_group_full(vector<double> &x) const
-{
-    vector<double> y(x);
-
+    // Get size information
     int number_of_points = spatial_discretization_->number_of_points();
     int number_of_nodes = spatial_discretization_->number_of_nodes();
     int number_of_groups = energy_discretization_->number_of_groups();
     int number_of_moments = angular_discretization_->number_of_moments();
     int number_of_dimensional_moments = spatial_discretization_->dimensional_moments()->number_of_dimensional_moments();
+    Fission_Table const &table = *fission_table_;
 
+    // Move source flux into the workspace: fission only contributes to the
+    // zeroth moment, so the other moments remain zero
+    vector<double> &y = workspace_;
+    y.swap(x);
+    x.assign(y.size(), 0);
     #pragma omp parallel for schedule(dynamic, 10)
     for (int i = 0; i < number_of_points; ++i)
     {
-        shared_ptr<Cross_Section> sigma_f_cs = spatial_discretization_->point(i)->material()->sigma_f();
-        vector<double> const sigma_f = sigma_f_cs->data();
+        int const m = 0;
+        int const d = 0;
+        int const t = table.table_index(i);
+        double const *y_from = &y[number_of_nodes * number_of_groups * (m + number_of_moments * i)];
+        double *x_to = &x[number_of_nodes * number_of_groups * (m + number_of_moments * i)];
         
-        int m = 0;
-        int d = 0;
-        for (int gt = 0; gt < number_of_groups; ++gt)
+        if (table.factored(t))
         {
+            double const *chi = table.chi(t);
+            double const *nu_sigma_f = table.nu_sigma_f(t);
+            
             for (int n = 0; n < number_of_nodes; ++n)
             {
-                double sum = 0;
-                    
-                for (int gf = 0; gf < number_of_groups; ++gf)
+                // Calculate fission source
+                double fission_source = 0;
+                
+                for (int g = 0; g < number_of_groups; ++g)
                 {
-                    int k_phi_from = n + number_of_nodes * (gf + number_of_groups * (m + number_of_moments * i));
-                    int k_sigma = d + number_of_dimensional_moments * (gf + number_of_groups * gt);
-                    
-                    sum += sigma_f[k_sigma] * y[k_phi_from];
+                    fission_source += nu_sigma_f[d + number_of_dimensional_moments * g] * y_from[n + number_of_nodes * g];
+                }
+                
+                // Distribute the fission source over the groups
+                for (int g = 0; g < number_of_groups; ++g)
+                {
+                    x_to[n + number_of_nodes * g] = chi[g] * fission_source;
                 }
-                            
-                int k_phi_to = n + number_of_nodes * (gt + number_of_groups * (m + number_of_moments * i));
-                    
-                x[k_phi_to] = sum;
             }
         }
-    }
-    
-    // Zero out other moments
-    for (int i = 0; i < number_of_points; ++i)
-    {
-        for (int m = 1; m < number_of_moments; ++m)
+        else
         {
-            for (int g = 0; g < number_of_groups; ++g)
+            double const *sigma_f = table.sigma_f(t);
+            
+            for (int gt = 0; gt < number_of_groups; ++gt)
             {
                 for (int n = 0; n < number_of_nodes; ++n)
                 {
-                    int k_phi = n + number_of_nodes * (g + number_of_groups * (m + number_of_moments * i));
+                    double sum = 0;
+                    
+                    for (int gf = 0; gf < number_of_groups; ++gf)
+                    {
+                        int k_sigma = d + number_of_dimensional_moments * (gf + number_of_groups * gt);
                         
-                    x[k_phi] = 0;
+                        sum += sigma_f[k_sigma] * y_from[n + number_of_nodes * gf];
+                    }
+                    
+                    x_to[n + number_of_nodes * gt] = sum;
                 }
             }
         }
@@ -161,74 +149,26 @@ group_to_group_full(vector<double> &x) const
 }
 
 void Fission::
-group_to_group_coherent(vector<double> &x) const
+apply_coherent(vector<double> &x) const
 {
-    AssertMsg(false, "not implemented");
+    switch (spatial_discretization_->point(0)->material()->sigma_f()->dependencies().energy)
+    {
+    case Cross_Section::Dependencies::Energy::GROUP:
+        group_coherent(x);
+        break;
+    case Cross_Section::Dependencies::Energy::GROUP_TO_GROUP:
+        group_to_group_coherent(x);
+        break;
+    default:
+        Assert(false);
+        break;
+    }
 }
 
 void Fission::
-group_full(vector<double> &x) const
+group_to_group_coherent(vector<double> &x) const
 {
-    int number_of_points = spatial_discretization_->number_of_points();
-    int number_of_nodes = spatial_discretization_->number_of_nodes();
-    int number_of_dimensional_moments = spatial_discretization_->dimensional_moments()->number_of_dimensional_moments();
-    int number_of_groups = energy_discretization_->number_of_groups();
-    int number_of_moments = angular_discretization_->number_of_moments();
-    int number_of_ordinates = angular_discretization_->number_of_ordinates();
-    
-    {
-        int m = 0;
-        int d = 0;
-        #pragma omp parallel for schedule(dynamic, 10)
-        for (int i = 0; i < number_of_points; ++i)
-        {
-            shared_ptr<Material> material = spatial_discretization_->point(i)->material();
-            vector<double> const nu = material->nu()->data();
-            vector<double> const sigma_f = material->sigma_f()->data();
-            vector<double> const chi = material->chi()->data();
-            
-            for (int n = 0; n < number_of_nodes; ++n)
-            {
-                // Calculate fission source
-                
-                double fission_source = 0;
-                    
-                for (int g = 0; g < number_of_groups; ++g)
-                {
-                    int k_phi = n + number_of_nodes * (g + number_of_groups * (m + number_of_moments * i));
-                    int k_xs = d + number_of_dimensional_moments * g;
-                    
-                    fission_source += nu[k_xs] * sigma_f[k_xs] * x[k_phi];
-                }
-                    
-                // Assign flux back to the appropriate group and zeroth moment
-                for (int g = 0; g < number_of_groups; ++g)
-                {
-                    int k_phi = n + number_of_nodes * (g + number_of_groups * (m + number_of_moments * i));
-                    int k_xs = d + number_of_dimensional_moments * g;
-                    
-                    x[k_phi] = chi[k_xs] * fission_source;
-                }
-            }
-        }
-    }
-    
-    // Zero out other moments
-    for (int i = 0; i < number_of_points; ++i)
-    {
-        for (int m = 1; m < number_of_moments; ++m)
-        {
-            for (int g = 0; g < number_of_groups; ++g)
-            {
-                for (int n = 0; n < number_of_nodes; ++n)
-                {
-                    int k_phi = n + number_of_nodes * (g + number_of_groups * (m + number_of_moments * i));
-                    
-                    x[k_phi] = 0;
-                }
-            }
-        }
-    }
+    AssertMsg(false, "not implemented");
 }
 
 void Fission::
@@ -6,6 +6,8 @@
 
 #include "Scattering_Operator.hh"
 
+class Fission_Table;
+
 /*
   Applies fission to a moment representation of the flux
 */
@@ -35,12 +37,13 @@ private:
     virtual void apply_coherent(std::vector<double> &x) const override;
     
     // Regular fission with nu, chi and sigma_f
-    void group_full(std::vector<double> &x) const;
     void group_coherent(std::vector<double> &x) const;
     
     // Scattering-like fission (group to group) with all info in sigma_f
-    void group_to_group_full(std::vector<double> &x) const;
     void group_to_group_coherent(std::vector<double> &x) const;
+
+    // Fission cross sections of each point, factored where possible
+    std::shared_ptr<Fission_Table> fission_table_;
 };
 
 #endif
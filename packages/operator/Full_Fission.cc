@@ -10,6 +10,7 @@
 #include "Dimensional_Moments.hh"
 #include "Energy_Discretization.hh"
 #include "Material.hh"
+#include "Mixed_Cross_Section.hh"
 #include "Weak_Spatial_Discretization.hh"
 #include "Weight_Function.hh"
 
@@ -55,54 +56,162 @@ apply_full(vector<double> &x) const
     int number_of_nodes = spatial_discretization_->number_of_nodes();
     int number_of_groups = energy_discretization_->number_of_groups();
     int number_of_moments = angular_discretization_->number_of_moments();
-    
+
     // Get dimensional moments
     shared_ptr<Dimensional_Moments> dimensional_moments = spatial_discretization_->dimensional_moments();
     int number_of_dimensional_moments = dimensional_moments->number_of_dimensional_moments();
     
-    // Copy source flux
-    vector<double> y(x);
+    // Move source flux into the workspace
+    vector<double> &y = workspace_;
+    y.swap(x);
     x.assign(number_of_points * number_of_nodes * number_of_groups * number_of_moments * number_of_dimensional_moments, 0);
-    #pragma omp parallel for schedule(dynamic, 10)
-    for (int i = 0; i < number_of_points; ++i)
+    #pragma omp parallel
+    {
+        // Flux mixed over the basis functions, reused for each point
+        vector<double> mixed_flux(number_of_groups * number_of_dimensional_moments);
+        
+        #pragma omp for schedule(dynamic, 10)
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            // Apply without expanding the cross section, if possible
+            shared_ptr<Cross_Section> const sigma_f_cs = spatial_discretization_->weight(i)->material()->sigma_f();
+            shared_ptr<Mixed_Cross_Section> const mixed_sigma_f = dynamic_pointer_cast<Mixed_Cross_Section>(sigma_f_cs);
+            if (mixed_sigma_f)
+            {
+                apply_mixed(i,
+                            *mixed_sigma_f,
+                            y,
+                            x,
+                            mixed_flux);
+            }
+            else
+            {
+                apply_dense(i,
+                            *sigma_f_cs,
+                            y,
+                            x);
+            }
+        } // weight functions
+    }
+}
+
+void Full_Fission::
+apply_dense(int i,
+            Cross_Section const &sigma_f_cs,
+            vector<double> const &y,
+            vector<double> &x) const
+{
+    // Get size information
+    int number_of_nodes = spatial_discretization_->number_of_nodes();
+    int number_of_groups = energy_discretization_->number_of_groups();
+    int number_of_moments = angular_discretization_->number_of_moments();
+    int number_of_dimensional_moments = spatial_discretization_->dimensional_moments()->number_of_dimensional_moments();
+    
+    // Get cross section information
+    shared_ptr<Weight_Function> weight = spatial_discretization_->weight(i);
+    vector<double> const &sigma_f = sigma_f_cs.data();
+    int const number_of_basis_functions = weight->number_of_basis_functions();
+    vector<int> const &basis_function_indices = weight->basis_function_indices();
+    
+    // Perform fission
+    int const m = 0;
+    for (int gt = 0; gt < number_of_groups; ++gt)
+    {
+        for (int n = 0; n < number_of_nodes; ++n)
+        {
+            for (int d = 0; d < number_of_dimensional_moments; ++d)
+            {
+                double sum = 0;
+                
+                for (int j = 0; j < number_of_basis_functions; ++j)
+                {
+                    int b = basis_function_indices[j];
+                    
+                    for (int gf = 0; gf < number_of_groups; ++gf)
+                    {
+                        int k_phi_from = n + number_of_nodes * (gf + number_of_groups * (m + number_of_moments * b));
+                        int k_sigma = d + number_of_dimensional_moments * (gf + number_of_groups * (gt + number_of_groups * j));
+                        
+                        sum += sigma_f[k_sigma] * y[k_phi_from];
+                    } // from group
+                } // basis functions
+                
+                int k_phi_to = n + number_of_nodes * (d + number_of_dimensional_moments * (gt + number_of_groups * (m + number_of_moments * i)));
+                
+                x[k_phi_to] = sum;
+            } // dimensional moments
+        } // nodes
+    } // to group
+}
+
+void Full_Fission::
+apply_mixed(int i,
+            Mixed_Cross_Section const &sigma_f,
+            vector<double> const &y,
+            vector<double> &x,
+            vector<double> &mixed_flux) const
+{
+    // Get size information
+    int number_of_nodes = spatial_discretization_->number_of_nodes();
+    int number_of_groups = energy_discretization_->number_of_groups();
+    int number_of_moments = angular_discretization_->number_of_moments();
+    int number_of_dimensional_moments = spatial_discretization_->dimensional_moments()->number_of_dimensional_moments();
+    
+    // Get cross section information
+    shared_ptr<Weight_Function> weight = spatial_discretization_->weight(i);
+    vector<double> const &coefficients = sigma_f.coefficients();
+    int const number_of_basis_functions = weight->number_of_basis_functions();
+    vector<int> const &basis_function_indices = weight->basis_function_indices();
+    
+    // Perform fission for each component, which is applied once to the
+    // flux mixed over the basis functions instead of once per basis function
+    int const m = 0;
+    for (int r = 0; r < sigma_f.number_of_components(); ++r)
     {
-        // Get cross section information
-        shared_ptr<Weight_Function> weight = spatial_discretization_->weight(i);
-        shared_ptr<Cross_Section> const sigma_f_cs = weight->material()->sigma_f();
-        vector<double> const sigma_f = sigma_f_cs->data();
-        int const number_of_basis_functions = weight->number_of_basis_functions();
-        vector<int> const basis_function_indices = weight->basis_function_indices();
+        vector<double> const &component = sigma_f.component(r)->data();
         
-        // Perform scattering
-        int const m = 0;
-        for (int gt = 0; gt < number_of_groups; ++gt)
+        for (int n = 0; n < number_of_nodes; ++n)
         {
-            for (int n = 0; n < number_of_nodes; ++n)
+            // Mix the flux over the basis functions
+            mixed_flux.assign(number_of_groups * number_of_dimensional_moments, 0.);
+            for (int j = 0; j < number_of_basis_functions; ++j)
             {
+                int b = basis_function_indices[j];
+                
                 for (int d = 0; d < number_of_dimensional_moments; ++d)
                 {
-                    double sum = 0;
+                    double coefficient = coefficients[d + number_of_dimensional_moments * (j + number_of_basis_functions * r)];
+                    
+                    for (int gf = 0; gf < number_of_groups; ++gf)
+                    {
+                        int k_phi_from = n + number_of_nodes * (gf + number_of_groups * (m + number_of_moments * b));
                         
-                    for (int j = 0; j < number_of_basis_functions; ++j)
+                        mixed_flux[gf + number_of_groups * d] += coefficient * y[k_phi_from];
+                    } // from group
+                } // dimensional moments
+            } // basis functions
+            
+            // Apply the component cross section
+            for (int gt = 0; gt < number_of_groups; ++gt)
+            {
+                for (int d = 0; d < number_of_dimensional_moments; ++d)
+                {
+                    double sum = 0;
+                    
+                    for (int gf = 0; gf < number_of_groups; ++gf)
                     {
-                        int b = basis_function_indices[j];
-                            
-                        for (int gf = 0; gf < number_of_groups; ++gf)
-                        {
-                            int k_phi_from = n + number_of_nodes * (gf + number_of_groups * (m + number_of_moments * b));
-                            int k_sigma = d + number_of_dimensional_moments * (gf + number_of_groups * (gt + number_of_groups * j));
-                            
-                            sum += sigma_f[k_sigma] * y[k_phi_from];
-                        } // from group
-                    } // basis functions
+                        int k_sigma = gf + number_of_groups * gt;
+                        
+                        sum += component[k_sigma] * mixed_flux[gf + number_of_groups * d];
+                    } // from group
                     
                     int k_phi_to = n + number_of_nodes * (d + number_of_dimensional_moments * (gt + number_of_groups * (m + number_of_moments * i)));
                     
-                    x[k_phi_to] = sum;
+                    x[k_phi_to] += sum;
                 } // dimensional moments
-            } // nodes
-        } // to group
-    } // weight functions
+            } // to group
+        } // nodes
+    } // components
 }
 
 void Full_Fission::
@@ -6,6 +6,9 @@
 
 #include "Full_Scattering_Operator.hh"
 
+class Cross_Section;
+class Mixed_Cross_Section;
+
 /*
   Applies scattering to a moment representation of the flux
 */
@@ -33,6 +36,18 @@ private:
     
     // Apply only within-group scattering
     virtual void apply_coherent(std::vector<double> &x) const override;
+
+    // Apply the cross section of point i, stored in full or as a mixture of
+    // components, to the source flux y
+    void apply_dense(int i,
+                     Cross_Section const &sigma_f,
+                     std::vector<double> const &y,
+                     std::vector<double> &x) const;
+    void apply_mixed(int i,
+                     Mixed_Cross_Section const &sigma_f,
+                     std::vector<double> const &y,
+                     std::vector<double> &x,
+                     std::vector<double> &mixed_flux) const;
 };
 
 #endif
@@ -10,6 +10,7 @@
 #include <vector>
 
 class Angular_Discretization;
+class Cell_Basis_Values;
 template<class T1, class T2> class Conversion;
 class Energy_Discretization;
 class Weak_Spatial_Discretization;
@@ -81,10 +82,8 @@ private:
 
     virtual void apply(std::vector<double> &x) const override;
     
-    void get_flux(std::shared_ptr<Integration_Cell> const cell,
-                  std::vector<double> const &b_val,
-                  std::vector<double> const &coeff,
-                  std::vector<double> &flux) const;
+    // Get the quadrature, basis values and expected solution on the mesh
+    void initialize() const;
     
     int row_size_;
     int column_size_;
@@ -99,8 +98,12 @@ private:
     std::shared_ptr<Energy_Discretization> energy_;
     std::function<std::vector<double>(std::vector<double> const&)> const solution_;
     
+    // Quadrature and basis values of the mesh and the expected solution at
+    // each quadrature point (indexed as l + number_per_point * q over all
+    // cells), computed on first use
     mutable bool initialized_;
-    mutable std::shared_ptr<Integration_Mesh> mesh_;
+    mutable std::shared_ptr<Cell_Basis_Values> cell_values_;
+    mutable std::vector<double> expected_;
 };
 
 #endif
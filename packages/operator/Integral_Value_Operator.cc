@@ -8,6 +8,7 @@
 
 #include "Angular_Discretization.hh"
 #include "Basis_Function.hh"
+#include "Cell_Basis_Values.hh"
 #include "Energy_Discretization.hh"
 #include "Integration_Mesh.hh"
 #include "Weak_Spatial_Discretization.hh"
@@ -52,135 +53,73 @@ check_class_invariants() const
 
     if (initialized_)
     {
-        Assert(mesh_);
+        int number_per_point = angular_->number_of_moments() * energy_->number_of_groups();
+        Assert((row_offsets_.size() - 1) * number_per_point == row_size_);
+        Assert(column_indices_.size() == row_offsets_.back());
+        Assert(values_.size() == row_offsets_.back());
     }
 }
 
 void Integral_Value_Operator::
-apply(vector<double> &x) const
+initialize() const
 {
-    // Get size data
-    int number_of_points = spatial_->number_of_points();
-    int number_of_groups = energy_->number_of_groups();
-    int number_of_moments = angular_->number_of_moments();
-
-    // Initialize if applicable
-    if (!initialized_)
-    {
-        mesh_ = make_shared<Integration_Mesh>(spatial_->dimension(),
-                                              number_of_points,
-                                              integration_options_,
-                                              spatial_->bases(),
-                                              spatial_->weights());
-        initialized_ = true;
-    }
+    // Get basis values at the quadrature points of each cell
+    shared_ptr<Integration_Mesh> const mesh
+        = make_shared<Integration_Mesh>(spatial_->dimension(),
+                                        spatial_->number_of_points(),
+                                        integration_options_,
+                                        spatial_->bases(),
+                                        spatial_->weights());
+    Cell_Basis_Values const cell_values(mesh);
 
     // Ensure row size initialization is correct
-    int number_of_cells = mesh_->number_of_cells();
-    Assert(row_size_ == (number_of_cells
+    Assert(row_size_ == (cell_values.number_of_cells()
                          * angular_->number_of_moments()
                          * energy_->number_of_groups()));
-    
-    // Apply operator
-    vector<double> result(row_size_, 0.);
-    #pragma omp parallel for schedule(dynamic, 10)
-    for (int i = 0; i < number_of_cells; ++i)
-    {
-        // Get cell
-        shared_ptr<Integration_Cell> const cell = mesh_->cell(i);
-        
-        // Get quadrature
-        int number_of_ordinates;
-        vector<vector<double> > ordinates;
-        vector<double> weights;
-        mesh_->get_volume_quadrature(i,
-                                     number_of_ordinates,
-                                     ordinates,
-                                     weights);
 
-        // Get center positions
-        vector<vector<double> > basis_centers;
-        mesh_->get_basis_centers(cell,
-                                 basis_centers);
-        
-        for (int q = 0; q < number_of_ordinates; ++q)
-        {
-            // Get quadrature position and weight
-            double const weight = weights[q];
-            vector<double> const &position = ordinates[q];
-            
-            // Get volume values
-            vector<double> b_val;
-            mesh_->get_basis_values(cell,
-                                    position,
-                                    basis_centers,
-                                    b_val);
-
-            // Get flux
-            vector<double> flux;
-            get_flux(cell,
-                     b_val,
-                     x,
-                     flux);
-
-            // Add to integral
-            for (int m = 0; m < number_of_moments; ++m)
-            {
-                for (int g = 0; g < number_of_groups; ++g)
-                {
-                    int k_res = g + number_of_groups * (m + number_of_moments * i);
-                    int k_flux = g + number_of_groups * m;
-                    
-                    result[k_res] += flux[k_flux] * weight;
-                }
-            }
-        }
-
-        // Get the volume (sum of weights)
-        double volume = 0;
-        for (double weight : weights)
-        {
-            volume += weight;
-        }
-        
-        // Normalize to account for the volume
-        for (int m = 0; m < number_of_moments; ++m)
-        {
-            for (int g = 0; g < number_of_groups; ++g)
-            {
-                int k = g + number_of_groups * (m + number_of_moments * i);
-                result[k] /= volume;
-            }
-        }
-    }
-    
-    // Put result into "x"
-    x.swap(result);
+    // Sum the quadrature into the averaging matrix
+    cell_values.get_averaging_matrix(row_offsets_,
+                                     column_indices_,
+                                     values_);
+    initialized_ = true;
+    check_class_invariants();
 }
 
 void Integral_Value_Operator::
-get_flux(shared_ptr<Integration_Cell> const cell,
-         vector<double> const &b_val,
-         vector<double> const &coeff,
-         vector<double> &flux) const
+apply(vector<double> &x) const
 {
-    // Get size information
-    int const number_of_groups = energy_->number_of_groups();
-    int const number_of_moments = angular_->number_of_moments();
+    apply_from_workspace(x);
+}
 
-    // Calculate flux
-    flux.assign(number_of_groups * number_of_moments, 0.);
-    for (int i = 0; i < cell->number_of_basis_functions; ++i)
+void Integral_Value_Operator::
+apply_out_of_place(vector<double> const &x,
+                   vector<double> &y) const
+{
+    // Initialize if applicable
+    if (!initialized_)
+    {
+        initialize();
+    }
+    
+    // Get size data
+    int const number_of_cells = row_offsets_.size() - 1;
+    int const number_per_point = (angular_->number_of_moments()
+                                  * energy_->number_of_groups());
+    
+    // Apply averaging matrix to all moments and groups at once
+    y.assign(row_size_, 0.);
+    #pragma omp parallel for schedule(dynamic, 10)
+    for (int i = 0; i < number_of_cells; ++i)
     {
-        int const j = cell->basis_indices[i];
-        for (int m = 0; m < number_of_moments; ++m)
+        double *const result = &y[number_per_point * i];
+        for (int k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k)
         {
-            for (int g = 0; g < number_of_groups; ++g)
+            double const value = values_[k];
+            double const *const coefficient = &x[number_per_point * column_indices_[k]];
+            
+            for (int l = 0; l < number_per_point; ++l)
             {
-                int const k_f = g + number_of_groups * m; // Local flux index
-                int const k_c = g + number_of_groups * (m + number_of_moments * j); // Global coefficient index
-
-                flux[k_f] += b_val[i] * coeff[k_c];
+                result[l] += value * coefficient[l];
             }
         }
     }
@@ -38,11 +38,11 @@ public:
 private:
 
     virtual void apply(std::vector<double> &x) const override;
-    
-    void get_flux(std::shared_ptr<Integration_Cell> const cell,
-                  std::vector<double> const &b_val,
-                  std::vector<double> const &coeff,
-                  std::vector<double> &flux) const;
+    virtual void apply_out_of_place(std::vector<double> const &x,
+                                    std::vector<double> &y) const override;
+
+    // Assemble the averaging matrix
+    void initialize() const;
     
     int row_size_;
     int column_size_;
@@ -52,8 +52,12 @@ private:
     std::shared_ptr<Angular_Discretization> angular_;
     std::shared_ptr<Energy_Discretization> energy_;
     
+    // Sparse (cells x basis functions) matrix that takes the coefficients to
+    // the cell averages, assembled on first use
     mutable bool initialized_;
-    mutable std::shared_ptr<Integration_Mesh> mesh_;
+    mutable std::vector<int> row_offsets_;
+    mutable std::vector<int> column_indices_;
+    mutable std::vector<double> values_;
 };
 
 #endif
@@ -10,6 +10,7 @@
 #include "Dimensional_Moments.hh"
 #include "Energy_Discretization.hh"
 #include "Material.hh"
+#include "Material_Table.hh"
 #include "Point.hh"
 #include "Spatial_Discretization.hh"
 
@@ -39,6 +40,7 @@ check_class_invariants() const
     Assert(spatial_);
     Assert(angular_);
     Assert(energy_);
+    Assert(spatial_->material_table());
     
     int number_of_points = spatial_->number_of_points();
     for (int i = 0; i < number_of_points; ++i)
@@ -61,13 +63,13 @@ apply(vector<double> &x) const
     int number_of_dimensional_moments = spatial_->dimensional_moments()->number_of_dimensional_moments();
     double normalization = angular_->angular_normalization();
 
+    Material_Table const &material_table = *spatial_->material_table();
     #pragma omp parallel for
     for (int i = 0; i < number_of_points; ++i)
     {
-        shared_ptr<Cross_Section> internal_source
-            = spatial_->point(i)->material()->internal_source();
-        vector<double> const data = internal_source->data();
-        Cross_Section::Dependencies deps = internal_source->dependencies();
+        double const *data = material_table.view(i).internal_source;
+        Cross_Section::Dependencies deps
+            = material_table.material(i)->internal_source()->dependencies();
 
         int d = 0;
         switch (deps.angular)
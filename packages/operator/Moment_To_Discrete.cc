@@ -4,6 +4,8 @@
     #include <omp.h>
 #endif
 
+#include <Eigen/Dense>
+
 #include "Check.hh"
 #include "Angular_Discretization.hh"
 #include "Energy_Discretization.hh"
@@ -11,6 +13,10 @@
 
 using namespace std;
 
+typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> EMatrix;
+typedef Eigen::Map<EMatrix> EMMatrix;
+typedef Eigen::Map<EMatrix const> ECMMatrix;
+
 Moment_To_Discrete::
 Moment_To_Discrete(shared_ptr<Spatial_Discretization> spatial_discretization,
                    shared_ptr<Angular_Discretization> angular_discretization,
@@ -30,6 +36,9 @@ Moment_To_Discrete(shared_ptr<Spatial_Discretization> spatial_discretization,
                     * angular_discretization->number_of_ordinates());
     row_size_ = psi_size;
     column_size_ = phi_size;
+
+    // Precompute the moment-to-discrete matrix
+    angular_discretization->moment_to_discrete_matrix(moment_to_discrete_);
     
     check_class_invariants();
 }
@@ -37,45 +46,32 @@ Moment_To_Discrete(shared_ptr<Spatial_Discretization> spatial_discretization,
 void Moment_To_Discrete::
 apply(vector<double> &x) const
 {
-    vector<double> y(x);
-    
-    x.resize(row_size());
+    apply_from_workspace(x);
+}
+
+void Moment_To_Discrete::
+apply_out_of_place(vector<double> const &x,
+                   vector<double> &y) const
+{
+    y.resize(row_size());
     
     int number_of_points = spatial_discretization_->number_of_points();
     int number_of_nodes = spatial_discretization_->number_of_nodes();
     int number_of_groups = energy_discretization_->number_of_groups();
     int number_of_moments = angular_discretization_->number_of_moments();
     int number_of_ordinates = angular_discretization_->number_of_ordinates();
-    double angular_normalization = angular_discretization_->angular_normalization();
-    vector<int> const scattering_indices = angular_discretization_->scattering_indices();
+    int local_size = number_of_nodes * number_of_groups;
+    ECMMatrix const moment_to_discrete(&moment_to_discrete_[0], number_of_moments, number_of_ordinates);
 
+    // For each point, the moments form a (nodes * groups) x moments matrix
+    // and the discrete values a (nodes * groups) x ordinates matrix
     #pragma omp parallel for schedule(dynamic, 10)
     for (int i = 0; i < number_of_points; ++i)
     {
-        for (int g = 0; g < number_of_groups; ++g)
-        {
-            for (int n = 0; n < number_of_nodes; ++n)
-            {
-                for (int o = 0; o < number_of_ordinates; ++o)
-                {
-                    double sum = 0;
-                    
-                    for (int m = 0; m < number_of_moments; ++m)
-                    {
-                        int k = n + number_of_nodes * (g + number_of_groups * (m + number_of_moments * i));
-                        int l = scattering_indices[m];
-
-                        double p = angular_discretization_->moment(m, o);
-                        
-                        sum += (2 * static_cast<double>(l) + 1) / angular_normalization * p * y[k];
-                    }
-                    
-                    int k = n + number_of_nodes * (g + number_of_groups * (o + number_of_ordinates * i));
-                    
-                    x[k] = sum;
-                }
-            }
-        }
+        ECMMatrix const phi(&x[local_size * number_of_moments * i], local_size, number_of_moments);
+        EMMatrix psi(&y[local_size * number_of_ordinates * i], local_size, number_of_ordinates);
+        
+        psi.noalias() = phi * moment_to_discrete;
     }
 }
 
@@ -85,4 +81,6 @@ check_class_invariants() const
     Assert(spatial_discretization_);
     Assert(angular_discretization_);
     Assert(energy_discretization_);
+    Assert(moment_to_discrete_.size() == (angular_discretization_->number_of_moments()
+                                          * angular_discretization_->number_of_ordinates()));
 }
@@ -40,6 +40,8 @@ public:
 private:
 
     virtual void apply(std::vector<double> &x) const override;
+    virtual void apply_out_of_place(std::vector<double> const &x,
+                                    std::vector<double> &y) const override;
     
     bool include_dimensional_moments_;
     int row_size_;
@@ -47,6 +49,10 @@ private:
     std::shared_ptr<Spatial_Discretization> spatial_discretization_;
     std::shared_ptr<Angular_Discretization> angular_discretization_;
     std::shared_ptr<Energy_Discretization> energy_discretization_;
+
+    // Moment-to-discrete matrix, (2l + 1) / norm * P_m(o), column-major
+    // with moments as rows and ordinates as columns
+    std::vector<double> moment_to_discrete_;
 };
 
 #endif
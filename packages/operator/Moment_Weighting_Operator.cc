@@ -7,6 +7,7 @@
 #include "Angular_Discretization.hh"
 #include "Dimensional_Moments.hh"
 #include "Energy_Discretization.hh"
+#include "Integral_Store.hh"
 #include "Weak_Spatial_Discretization.hh"
 #include "Weight_Function.hh"
 
@@ -93,14 +94,13 @@ apply(vector<double> &x) const
     for (int i = 0; i < number_of_points; ++i)
     {
         // Get weight function and data
-        shared_ptr<Weight_Function> weight = spatial_->weight(i);
-        int number_of_basis_functions = weight->number_of_basis_functions();
-        Weight_Function::Integrals const integrals = weight->integrals();
-        vector<int> basis_indices = weight->basis_function_indices();
+        Integral_Store::View const integrals = spatial_->integral_store()->view(i);
+        int number_of_basis_functions = integrals.number_of_basis_functions;
+        int const *basis_indices = integrals.basis_function_indices;
 
-        vector<double> const &iv_w = integrals.iv_w;
-        vector<double> const &iv_b_w = integrals.iv_b_w;
-        vector<double> const &iv_b_dw = integrals.iv_b_dw;
+        double const *iv_w = integrals.iv_w;
+        double const *iv_b_w = integrals.iv_b_w;
+        double const *iv_b_dw = integrals.iv_b_dw;
         
         // Get normalization constant
         double const norm = include_normalization ? iv_w[0] : 1;
@@ -12,6 +12,7 @@
 #include "Cross_Section.hh"
 #include "Dimensional_Moments.hh"
 #include "Energy_Discretization.hh"
+#include "Fission_Table.hh"
 #include "Material.hh"
 #include "Point.hh"
 #include "Spatial_Discretization.hh"
@@ -28,6 +29,12 @@ SUPG_Fission(shared_ptr<Spatial_Discretization> spatial_discretization,
                              energy_discretization,
                              options)
 {
+    // Get fission cross sections of the interned materials, factored where possible
+    fission_table_
+        = make_shared<Fission_Table>(energy_discretization->number_of_groups(),
+                                     spatial_discretization->dimensional_moments()->number_of_dimensional_moments(),
+                                     spatial_discretization->material_table());
+    
     check_class_invariants();
 }
 
@@ -37,6 +44,8 @@ check_class_invariants() const
     Assert(spatial_discretization_);
     Assert(angular_discretization_);
     Assert(energy_discretization_);
+    Assert(fission_table_);
+    Assert(fission_table_->number_of_points() == spatial_discretization_->number_of_points());
 
     int number_of_points = spatial_discretization_->number_of_points();
     
@@ -73,165 +82,120 @@ check_class_invariants() const
 
 void SUPG_Fission::
 apply_full(vector<double> &x) const
-{
-    switch (spatial_discretization_->point(0)->material()->sigma_f()->dependencies().energy)
-    {
-    case Cross_Section::Dependencies::Energy::GROUP:
-        group_full(x);
-        break;
-    case Cross_Section::Dependencies::Energy::GROUP_TO_GROUP:
-        group_to_group_full(x);
-        break; 
-    default:
-        Assert(false);
-        break;
-   }
-}
-
-void SUPG_Fission::
-apply_coherent(vector<double> &x) const
-{
-    switch (spatial_discretization_->point(0)->material()->sigma_f()->dependencies().energy)
-    {
-    case Cross_Section::Dependencies::Energy::GROUP:
-        group_coherent(x);
-        break;
-    case Cross_Section::Dependencies::Energy::GROUP_TO_GROUP:
-        group_to_group_coherent(x);
-        break;
-    default:
-        Assert(false);
-        break;
-    }
-}
-
-void SUPG_Fission::
-group_to_group_full(vector<double> &x) const
 {
     // Get size information
     int number_of_points = spatial_discretization_->number_of_points();
     int number_of_nodes = spatial_discretization_->number_of_nodes();
     int number_of_groups = energy_discretization_->number_of_groups();
     int number_of_moments = angular_discretization_->number_of_moments();
+    Fission_Table const &table = *fission_table_;
     
     // Get dimensional moments
     shared_ptr<Dimensional_Moments> dimensional_moments = spatial_discretization_->dimensional_moments();
     int number_of_dimensional_moments = dimensional_moments->number_of_dimensional_moments();
     int number_of_double_dimensional_moments = dimensional_moments->number_of_double_dimensional_moments();
-    vector<int> const dimensional_indices = dimensional_moments->dimensional_indices();
+    vector<int> const &dimensional_indices = dimensional_moments->dimensional_indices();
 
-    // Copy source flux
-    vector<double> y(x);
+    // Move source flux into the workspace
+    vector<double> &y = workspace_;
+    y.swap(x);
     x.assign(number_of_points * number_of_nodes * number_of_groups * number_of_moments * number_of_double_dimensional_moments, 0);
     #pragma omp parallel for schedule(dynamic, 10)
     for (int i = 0; i < number_of_points; ++i)
     {
-        shared_ptr<Cross_Section> sigma_f_cs = spatial_discretization_->point(i)->material()->sigma_f();
-        vector<double> const sigma_f = sigma_f_cs->data();
-        
         int const m = 0;
-        for (int gt = 0; gt < number_of_groups; ++gt)
+        int const t = table.table_index(i);
+        
+        if (table.factored(t))
         {
+            double const *chi = table.chi(t);
+            double const *nu_sigma_f = table.nu_sigma_f(t);
+            
             for (int n = 0; n < number_of_nodes; ++n)
             {
                 for (int d1 = 0; d1 < number_of_dimensional_moments; ++d1)
                 {
                     for (int d2 = 0; d2 < number_of_dimensional_moments; ++d2)
                     {
-                        double sum = 0;
+                        // Calculate fission source
+                        double fission_source = 0;
                         
                         for (int gf = 0; gf < number_of_groups; ++gf)
                         {
                             int k_phi_from = n + number_of_nodes * (d1 + number_of_dimensional_moments * (gf + number_of_groups * (m + number_of_moments * i)));
-                            int k_sigma = d2 + number_of_dimensional_moments * (gf + number_of_groups * gt);
                             
-                            sum += sigma_f[k_sigma] * y[k_phi_from];
+                            fission_source += nu_sigma_f[d2 + number_of_dimensional_moments * gf] * y[k_phi_from];
                         }
-
-                        int d = dimensional_indices[d1 + number_of_dimensional_moments * d2];
-                        int k_phi_to = n + number_of_nodes * (d + number_of_double_dimensional_moments * (gt + number_of_groups * (m + number_of_moments * i)));
                         
-                        x[k_phi_to] += sum;
+                        // Distribute the fission source over the groups
+                        int d = dimensional_indices[d1 + number_of_dimensional_moments * d2];
+                        for (int gt = 0; gt < number_of_groups; ++gt)
+                        {
+                            int k_phi_to = n + number_of_nodes * (d + number_of_double_dimensional_moments * (gt + number_of_groups * (m + number_of_moments * i)));
+                            
+                            x[k_phi_to] += chi[gt] * fission_source;
+                        }
                     }
                 }
             }
         }
-    }
-}
-
-void SUPG_Fission::
-group_to_group_coherent(vector<double> &x) const
-{
-    AssertMsg(false, "coherent not implemented in SUPG_Fission");
-}
-
-void SUPG_Fission::
-group_full(vector<double> &x) const
-{
-    AssertMsg(false, "group_full in SUPG_Fission not tested");
-    
-    int number_of_points = spatial_discretization_->number_of_points();
-    int number_of_nodes = spatial_discretization_->number_of_nodes();
-    int number_of_dimensional_moments = spatial_discretization_->dimensional_moments()->number_of_dimensional_moments();
-    int number_of_groups = energy_discretization_->number_of_groups();
-    int number_of_moments = angular_discretization_->number_of_moments();
-    int number_of_ordinates = angular_discretization_->number_of_ordinates();
-    
-    {
-        int m = 0;
-        int d = 0;
-        #pragma omp parallel for schedule(dynamic, 10)
-        for (int i = 0; i < number_of_points; ++i)
+        else
         {
-            shared_ptr<Material> material = spatial_discretization_->point(i)->material();
-            vector<double> const nu = material->nu()->data();
-            vector<double> const sigma_f = material->sigma_f()->data();
-            vector<double> const chi = material->chi()->data();
+            double const *sigma_f = table.sigma_f(t);
             
-            for (int n = 0; n < number_of_nodes; ++n)
+            for (int gt = 0; gt < number_of_groups; ++gt)
             {
-                // Calculate fission source
-                
-                double fission_source = 0;
-                    
-                for (int g = 0; g < number_of_groups; ++g)
-                {
-                    int k_phi = n + number_of_nodes * (g + number_of_groups * (m + number_of_moments * i));
-                    int k_xs = d + number_of_dimensional_moments * g;
-                    
-                    fission_source += nu[k_xs] * sigma_f[k_xs] * x[k_phi];
-                }
-                    
-                // Assign flux back to the appropriate group and zeroth moment
-                for (int g = 0; g < number_of_groups; ++g)
+                for (int n = 0; n < number_of_nodes; ++n)
                 {
-                    int k_phi = n + number_of_nodes * (g + number_of_groups * (m + number_of_moments * i));
-                    int k_xs = d + number_of_dimensional_moments * g;
-                    
-                    x[k_phi] = chi[k_xs] * fission_source;
+                    for (int d1 = 0; d1 < number_of_dimensional_moments; ++d1)
+                    {
+                        for (int d2 = 0; d2 < number_of_dimensional_moments; ++d2)
+                        {
+                            double sum = 0;
+                            
+                            for (int gf = 0; gf < number_of_groups; ++gf)
+                            {
+                                int k_phi_from = n + number_of_nodes * (d1 + number_of_dimensional_moments * (gf + number_of_groups * (m + number_of_moments * i)));
+                                int k_sigma = d2 + number_of_dimensional_moments * (gf + number_of_groups * gt);
+                                
+                                sum += sigma_f[k_sigma] * y[k_phi_from];
+                            }
+                            
+                            int d = dimensional_indices[d1 + number_of_dimensional_moments * d2];
+                            int k_phi_to = n + number_of_nodes * (d + number_of_double_dimensional_moments * (gt + number_of_groups * (m + number_of_moments * i)));
+                            
+                            x[k_phi_to] += sum;
+                        }
+                    }
                 }
             }
         }
     }
-    
-    // Zero out other moments
-    for (int i = 0; i < number_of_points; ++i)
+}
+
+void SUPG_Fission::
+apply_coherent(vector<double> &x) const
+{
+    switch (spatial_discretization_->point(0)->material()->sigma_f()->dependencies().energy)
     {
-        for (int m = 1; m < number_of_moments; ++m)
-        {
-            for (int g = 0; g < number_of_groups; ++g)
-            {
-                for (int n = 0; n < number_of_nodes; ++n)
-                {
-                    int k_phi = n + number_of_nodes * (g + number_of_groups * (m + number_of_moments * i));
-                    
-                    x[k_phi] = 0;
-                }
-            }
-        }
+    case Cross_Section::Dependencies::Energy::GROUP:
+        group_coherent(x);
+        break;
+    case Cross_Section::Dependencies::Energy::GROUP_TO_GROUP:
+        group_to_group_coherent(x);
+        break;
+    default:
+        Assert(false);
+        break;
     }
 }
 
+void SUPG_Fission::
+group_to_group_coherent(vector<double> &x) const
+{
+    AssertMsg(false, "coherent not implemented in SUPG_Fission");
+}
+
 void SUPG_Fission::
 group_coherent(vector<double> &x) const
 {
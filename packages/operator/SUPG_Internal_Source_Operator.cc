@@ -10,6 +10,7 @@
 #include "Dimensional_Moments.hh"
 #include "Energy_Discretization.hh"
 #include "Material.hh"
+#include "Material_Table.hh"
 #include "Point.hh"
 #include "Spatial_Discretization.hh"
 
@@ -42,6 +43,7 @@ check_class_invariants() const
     Assert(spatial_);
     Assert(angular_);
     Assert(energy_);
+    Assert(spatial_->material_table());
 
     int number_of_points = spatial_->number_of_points();
     for (int i = 0; i < number_of_points; ++i)
@@ -64,13 +66,13 @@ apply(vector<double> &x) const
     int number_of_dimensional_moments = spatial_->dimensional_moments()->number_of_dimensional_moments();
     
     x.assign(number_of_points * number_of_nodes * number_of_moments * number_of_groups * number_of_dimensional_moments, 0);
+    Material_Table const &material_table = *spatial_->material_table();
     #pragma omp parallel for schedule(dynamic, 10)
     for (int i = 0; i < number_of_points; ++i)
     {
-        shared_ptr<Cross_Section> internal_source
-            = spatial_->point(i)->material()->internal_source();
-        vector<double> const data = internal_source->data();
-        Cross_Section::Dependencies deps = internal_source->dependencies();
+        double const *data = material_table.view(i).internal_source;
+        Cross_Section::Dependencies deps
+            = material_table.material(i)->internal_source()->dependencies();
         
         switch (deps.angular)
         {
@@ -4,6 +4,8 @@
     #include <omp.h>
 #endif
 
+#include <Eigen/Dense>
+
 #include "Check.hh"
 #include "Angular_Discretization.hh"
 #include "Dimensional_Moments.hh"
@@ -12,6 +14,10 @@
 
 using namespace std;
 
+typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> EMatrix;
+typedef Eigen::Map<EMatrix> EMMatrix;
+typedef Eigen::Map<EMatrix const> ECMMatrix;
+
 SUPG_Moment_To_Discrete::
 SUPG_Moment_To_Discrete(shared_ptr<Weak_Spatial_Discretization> spatial_discretization,
                         shared_ptr<Angular_Discretization> angular_discretization,
@@ -38,6 +44,9 @@ SUPG_Moment_To_Discrete(shared_ptr<Weak_Spatial_Discretization> spatial_discreti
                                             : dimensional_moments_->number_of_dimensional_moments());
     row_size_ = psi_size;
     column_size_ = phi_size * local_number_of_dimensional_moments_;
+
+    // Precompute the moment-to-discrete matrix
+    angular_discretization->moment_to_discrete_matrix(moment_to_discrete_);
     
     check_class_invariants();
 }
@@ -45,59 +54,75 @@ SUPG_Moment_To_Discrete(shared_ptr<Weak_Spatial_Discretization> spatial_discreti
 void SUPG_Moment_To_Discrete::
 apply(vector<double> &x) const
 {
-    vector<double> y(x);
-    
-    x.resize(row_size());
+    apply_from_workspace(x);
+}
+
+void SUPG_Moment_To_Discrete::
+apply_out_of_place(vector<double> const &x,
+                   vector<double> &y) const
+{
+    y.resize(row_size());
     
     int number_of_points = spatial_discretization_->number_of_points();
     int number_of_nodes = spatial_discretization_->number_of_nodes();
     int number_of_groups = energy_discretization_->number_of_groups();
     int number_of_moments = angular_discretization_->number_of_moments();
     int number_of_ordinates = angular_discretization_->number_of_ordinates();
-    double angular_normalization = angular_discretization_->angular_normalization();
-    vector<int> const scattering_indices = angular_discretization_->scattering_indices();
-    vector<double> const weights = angular_discretization_->weights();
-
-    #pragma omp parallel for schedule(dynamic, 10)
-    for (int i = 0; i < number_of_points; ++i)
+    int local_size = number_of_nodes * local_number_of_dimensional_moments_ * number_of_groups;
+    ECMMatrix const moment_to_discrete(&moment_to_discrete_[0], number_of_moments, number_of_ordinates);
+    
+    #pragma omp parallel
     {
-        double tau = spatial_discretization_->weight(i)->options()->tau;
-        for (int g = 0; g < number_of_groups; ++g)
+        // Dimensional coefficients and angular sums for a single point
+        vector<double> dimensional_coefficients(local_number_of_dimensional_moments_ * number_of_ordinates);
+        vector<double> angular_sum(local_size * number_of_ordinates);
+        
+        #pragma omp for schedule(dynamic, 10)
+        for (int i = 0; i < number_of_points; ++i)
         {
-            for (int n = 0; n < number_of_nodes; ++n)
+            // Get dimensional coefficients for each ordinate
+            double tau = spatial_discretization_->weight(i)->options()->tau;
+            for (int o = 0; o < number_of_ordinates; ++o)
             {
-                for (int o = 0; o < number_of_ordinates; ++o)
+                vector<double> const &direction = angular_discretization_->direction(o);
+                vector<double> const coefficients
+                    = (include_double_dimensional_moments_
+                       ? dimensional_moments_->double_coefficients(tau,
+                                                                   direction)
+                       : dimensional_moments_->coefficients(tau,
+                                                            direction));
+                for (int d = 0; d < local_number_of_dimensional_moments_; ++d)
                 {
-                    // Get dimensional coefficients
-                    vector<double> const direction = angular_discretization_->direction(o);
-                    vector<double> const coefficients
-                        = (include_double_dimensional_moments_
-                           ? dimensional_moments_->double_coefficients(tau,
-                                                                       direction)
-                           : dimensional_moments_->coefficients(tau,
-                                                                direction));
-                    
-                    // Sum over all moments
-                    double dir_sum = 0;
-                    for (int m = 0; m < number_of_moments; ++m)
+                    dimensional_coefficients[d + local_number_of_dimensional_moments_ * o] = coefficients[d];
+                }
+            }
+            
+            // Apply spherical harmonic functions to all nodes, dimensional
+            // moments and groups at once
+            ECMMatrix const phi(&x[local_size * number_of_moments * i], local_size, number_of_moments);
+            EMMatrix sum(&angular_sum[0], local_size, number_of_ordinates);
+            sum.noalias() = phi * moment_to_discrete;
+            
+            // Sum over the dimensional moments
+            for (int o = 0; o < number_of_ordinates; ++o)
+            {
+                double const *coefficients = &dimensional_coefficients[local_number_of_dimensional_moments_ * o];
+                
+                for (int g = 0; g < number_of_groups; ++g)
+                {
+                    for (int n = 0; n < number_of_nodes; ++n)
                     {
-                        // Get dimensional summation for this moment and ordinate
                         double dim_sum = 0;
                         for (int d = 0; d < local_number_of_dimensional_moments_; ++d)
                         {
-                            int k = n + number_of_nodes * (d + local_number_of_dimensional_moments_ * (g + number_of_groups * (m + number_of_moments * i)));
-                            dim_sum += coefficients[d] * y[k];
+                            int k_sum = n + number_of_nodes * (d + local_number_of_dimensional_moments_ * (g + number_of_groups * o));
+                            dim_sum += coefficients[d] * angular_sum[k_sum];
                         }
-                            
-                        // Apply spherical harmonic function
-                        int l = scattering_indices[m];
-                        double p = angular_discretization_->moment(m, o);
-                        dir_sum += (2 * static_cast<double>(l) + 1) / angular_normalization * p * dim_sum;
+                        
+                        // Set the new discrete flux
+                        int k = n + number_of_nodes * (g + number_of_groups * (o + number_of_ordinates * i));
+                        y[k] = dim_sum;
                     }
-
-                    // Set the new discrete flux
-                    int k = n + number_of_nodes * (g + number_of_groups * (o + number_of_ordinates * i));
-                    x[k] = dir_sum;
                 }
             }
         }
@@ -110,4 +135,6 @@ check_class_invariants() const
     Assert(spatial_discretization_);
     Assert(angular_discretization_);
     Assert(energy_discretization_);
+    Assert(moment_to_discrete_.size() == (angular_discretization_->number_of_moments()
+                                          * angular_discretization_->number_of_ordinates()));
 }
@@ -2,6 +2,7 @@
 #define SUPG_Moment_To_Discrete_hh
 
 #include <memory>
+#include <vector>
 
 #include "Vector_Operator.hh"
 
@@ -38,6 +39,8 @@ public:
 private:
 
     virtual void apply(std::vector<double> &x) const override;
+    virtual void apply_out_of_place(std::vector<double> const &x,
+                                    std::vector<double> &y) const override;
 
     bool include_double_dimensional_moments_;
     int row_size_;
@@ -47,6 +50,10 @@ private:
     std::shared_ptr<Weak_Spatial_Discretization> spatial_discretization_;
     std::shared_ptr<Angular_Discretization> angular_discretization_;
     std::shared_ptr<Energy_Discretization> energy_discretization_;
+
+    // Moment-to-discrete matrix, (2l + 1) / norm * P_m(o), column-major
+    // with moments as rows and ordinates as columns
+    std::vector<double> moment_to_discrete_;
 };
 
 #endif
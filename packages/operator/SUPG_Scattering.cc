@@ -14,6 +14,7 @@
 #include "Energy_Discretization.hh"
 #include "Material.hh"
 #include "Point.hh"
+#include "Scattering_Table.hh"
 #include "Spatial_Discretization.hh"
 
 using namespace std;
@@ -28,6 +29,12 @@ SUPG_Scattering(shared_ptr<Spatial_Discretization> spatial_discretization,
                         energy_discretization,
                         options)
 {
+    // Get compressed scattering cross sections of the interned materials
+    scattering_table_
+        = make_shared<Scattering_Table>(energy_discretization->number_of_groups(),
+                                        spatial_discretization->dimensional_moments()->number_of_dimensional_moments(),
+                                        spatial_discretization->material_table());
+    
     check_class_invariants();
 }
 
@@ -37,6 +44,8 @@ check_class_invariants() const
     Assert(spatial_discretization_);
     Assert(angular_discretization_);
     Assert(energy_discretization_);
+    Assert(scattering_table_);
+    Assert(scattering_table_->number_of_points() == spatial_discretization_->number_of_points());
 
     int number_of_points = spatial_discretization_->number_of_points();
     for (int i = 0; i < number_of_points; ++i)
@@ -59,8 +68,8 @@ apply_full(vector<double> &x) const
     int number_of_nodes = spatial_discretization_->number_of_nodes();
     int number_of_groups = energy_discretization_->number_of_groups();
     int number_of_moments = angular_discretization_->number_of_moments();
-    int number_of_scattering_moments = angular_discretization_->number_of_scattering_moments();
-    vector<int> const scattering_indices = angular_discretization_->scattering_indices();
+    vector<int> const &scattering_indices = angular_discretization_->scattering_indices();
+    Scattering_Table const &table = *scattering_table_;
 
     // Get dimensional moments
     shared_ptr<Dimensional_Moments> dimensional_moments = spatial_discretization_->dimensional_moments();
@@ -68,94 +77,54 @@ apply_full(vector<double> &x) const
     int number_of_double_dimensional_moments = dimensional_moments->number_of_double_dimensional_moments();
     vector<int> const dimensional_indices = dimensional_moments->dimensional_indices();
     
-    // Copy source flux
-    vector<double> y(x);
+    // Move source flux into the workspace
+    vector<double> &y = workspace_;
+    y.swap(x);
     x.assign(number_of_points * number_of_nodes * number_of_groups * number_of_moments * number_of_double_dimensional_moments, 0);
     #pragma omp parallel for schedule(dynamic, 10)
     for (int i = 0; i < number_of_points; ++i)
     {
         // Get cross section information
-        shared_ptr<Cross_Section> sigma_s_cs = spatial_discretization_->point(i)->material()->sigma_s();
-        vector<double> const sigma_s = sigma_s_cs->data();
-        Cross_Section::Dependencies::Angular angular_dep = sigma_s_cs->dependencies().angular;
+        int t = table.table_index(i);
+        bool scattering_moments = (table.angular_dependence(t)
+                                   == Cross_Section::Dependencies::Angular::SCATTERING_MOMENTS);
         
-        switch (angular_dep)
-        {
-        case Cross_Section::Dependencies::Angular::SCATTERING_MOMENTS:
+        // Perform scattering, gathering only the nonzero transfers
+        for (int m = 0; m < number_of_moments; ++m)
         {
-            // Perform scattering
-            for (int m = 0; m < number_of_moments; ++m)
+            int l = scattering_moments ? scattering_indices[m] : m;
+            double const *y_from = &y[number_of_nodes * number_of_dimensional_moments * number_of_groups * (m + number_of_moments * i)];
+            
+            for (int gt = 0; gt < number_of_groups; ++gt)
             {
-                int l = scattering_indices[m];
-                
-                for (int gt = 0; gt < number_of_groups; ++gt)
+                for (int d2 = 0; d2 < number_of_dimensional_moments; ++d2)
                 {
-                    for (int n = 0; n < number_of_nodes; ++n)
+                    Scattering_Table::Row const row = table.row(t, l, d2, gt);
+                    
+                    for (int d1 = 0; d1 < number_of_dimensional_moments; ++d1)
                     {
-                        for (int d1 = 0; d1 < number_of_dimensional_moments; ++d1)
+                        int d = dimensional_indices[d1 + number_of_dimensional_moments * d2];
+                        
+                        for (int n = 0; n < number_of_nodes; ++n)
                         {
-                            for (int d2 = 0; d2 < number_of_dimensional_moments; ++d2)
+                            double sum = 0;
+                            
+                            for (int j = 0; j < row.size; ++j)
                             {
-                                double sum = 0;
+                                int k_from = n + number_of_nodes * (d1 + number_of_dimensional_moments * row.groups[j]);
                                 
-                                for (int gf = 0; gf < number_of_groups; ++gf)
-                                {
-                                    int k_phi_from = n + number_of_nodes * (d1 + number_of_dimensional_moments * (gf + number_of_groups * (m + number_of_moments * i)));
-                                    int k_sigma = d2 + number_of_dimensional_moments * (gf + number_of_groups * (gt + number_of_groups * l));
-                                    
-                                    sum += sigma_s[k_sigma] * y[k_phi_from];
-                                }
-
-                                int d = dimensional_indices[d1 + number_of_dimensional_moments * d2];
-                                int k_phi_to = n + number_of_nodes * (d + number_of_double_dimensional_moments * (gt + number_of_groups * (m + number_of_moments * i)));
-                                
-                                x[k_phi_to] += sum;
+                                sum += row.values[j] * y_from[k_from];
                             }
+                            
+                            int k_phi_to = n + number_of_nodes * (d + number_of_double_dimensional_moments * (gt + number_of_groups * (m + number_of_moments * i)));
+                            
+                            x[k_phi_to] += sum;
                         }
                     }
                 }
             }
-            break;
-        } // SCATTERING_MOMENTS
-        case Cross_Section::Dependencies::Angular::MOMENTS:
-        {
-            // Perform scattering
-            for (int m = 0; m < number_of_moments; ++m)
-            {
-                for (int gt = 0; gt < number_of_groups; ++gt)
-                {
-                    for (int n = 0; n < number_of_nodes; ++n)
-                    {
-                        for (int d1 = 0; d1 < number_of_dimensional_moments; ++d1)
-                        {
-                            for (int d2 = 0; d2 < number_of_dimensional_moments; ++d2)
-                            {
-                                double sum = 0;
-                                
-                                for (int gf = 0; gf < number_of_groups; ++gf)
-                                {
-                                    int k_phi_from = n + number_of_nodes * (d1 + number_of_dimensional_moments * (gf + number_of_groups * (m + number_of_moments * i)));
-                                    int k_sigma = d2 + number_of_dimensional_moments * (gf + number_of_groups * (gt + number_of_groups * m));
-                                    
-                                    sum += sigma_s[k_sigma] * y[k_phi_from];
-                                }
-
-                                int d = dimensional_indices[d1 + number_of_dimensional_moments * d2];
-                                int k_phi_to = n + number_of_nodes * (d + number_of_double_dimensional_moments * (gt + number_of_groups * (m + number_of_moments * i)));
-                                
-                                x[k_phi_to] += sum;
-                            }
-                        }
-                    }
-                }
-            }
-            break;
-        } // MOMENTS
-        default:
-            Assert(false);
-            break;
-        } // switch (angular_dep)
-    } // points
+        }
+    }
 }
 
 void SUPG_Scattering::
@@ -14,6 +14,7 @@
 #include "Energy_Discretization.hh"
 #include "Material.hh"
 #include "Point.hh"
+#include "Scattering_Table.hh"
 #include "Spatial_Discretization.hh"
 
 using namespace std;
@@ -28,6 +29,12 @@ Scattering(shared_ptr<Spatial_Discretization> spatial_discretization,
                         energy_discretization,
                         options)
 {
+    // Get compressed scattering cross sections of the interned materials
+    scattering_table_
+        = make_shared<Scattering_Table>(energy_discretization->number_of_groups(),
+                                        spatial_discretization->dimensional_moments()->number_of_dimensional_moments(),
+                                        spatial_discretization->material_table());
+    
     check_class_invariants();
 }
 
@@ -37,6 +44,8 @@ check_class_invariants() const
     Assert(spatial_discretization_);
     Assert(angular_discretization_);
     Assert(energy_discretization_);
+    Assert(scattering_table_);
+    Assert(scattering_table_->number_of_points() == spatial_discretization_->number_of_points());
 
     int number_of_points = spatial_discretization_->number_of_points();
     for (int i = 0; i < number_of_points; ++i)
@@ -58,83 +67,47 @@ apply_full(vector<double> &x) const
     int number_of_nodes = spatial_discretization_->number_of_nodes();
     int number_of_groups = energy_discretization_->number_of_groups();
     int number_of_moments = angular_discretization_->number_of_moments();
-    int number_of_scattering_moments = angular_discretization_->number_of_scattering_moments();
-    int number_of_dimensional_moments = spatial_discretization_->dimensional_moments()->number_of_dimensional_moments();
-    vector<int> const scattering_indices = angular_discretization_->scattering_indices();
+    vector<int> const &scattering_indices = angular_discretization_->scattering_indices();
+    Scattering_Table const &table = *scattering_table_;
 
-    // Copy source flux
-    vector<double> y(x);
+    // Move source flux into the workspace
+    vector<double> &y = workspace_;
+    y.swap(x);
+    x.resize(row_size());
     #pragma omp parallel for schedule(dynamic, 10)
     for (int i = 0; i < number_of_points; ++i)
     {
         int d = 0;
 
         // Get cross section information
-        shared_ptr<Cross_Section> sigma_s_cs = spatial_discretization_->point(i)->material()->sigma_s();
-        vector<double> const sigma_s = sigma_s_cs->data();
-        Cross_Section::Dependencies::Angular angular_dep = sigma_s_cs->dependencies().angular;
+        int t = table.table_index(i);
+        bool scattering_moments = (table.angular_dependence(t)
+                                   == Cross_Section::Dependencies::Angular::SCATTERING_MOMENTS);
         
-        switch (angular_dep)
+        // Perform scattering, gathering only the nonzero transfers
+        for (int m = 0; m < number_of_moments; ++m)
         {
-        case Cross_Section::Dependencies::Angular::SCATTERING_MOMENTS:
-        {
-            // Perform scattering
-            for (int m = 0; m < number_of_moments; ++m)
+            int l = scattering_moments ? scattering_indices[m] : m;
+            double const *y_from = &y[number_of_nodes * number_of_groups * (m + number_of_moments * i)];
+            
+            for (int gt = 0; gt < number_of_groups; ++gt)
             {
-                int l = scattering_indices[m];
-
-                for (int gt = 0; gt < number_of_groups; ++gt)
+                Scattering_Table::Row const row = table.row(t, l, d, gt);
+                
+                for (int n = 0; n < number_of_nodes; ++n)
                 {
-                    for (int n = 0; n < number_of_nodes; ++n)
+                    double sum = 0;
+                    
+                    for (int j = 0; j < row.size; ++j)
                     {
-                        double sum = 0;
-                            
-                        for (int gf = 0; gf < number_of_groups; ++gf)
-                        {
-                            int k_phi_from = n + number_of_nodes * (gf + number_of_groups * (m + number_of_moments * i));
-                            int k_sigma = d + number_of_dimensional_moments * (gf + number_of_groups * (gt + number_of_groups * l));
-                                
-                            sum += sigma_s[k_sigma] * y[k_phi_from];
-                        }
-                            
-                        int k_phi_to = n + number_of_nodes * (gt + number_of_groups * (m + number_of_moments * i));
-                        
-                        x[k_phi_to] = sum;
+                        sum += row.values[j] * y_from[n + number_of_nodes * row.groups[j]];
                     }
-                }
-            }
-            break;
-        } // SCATTERING_MOMENTS
-        case Cross_Section::Dependencies::Angular::MOMENTS:
-        {
-            // Perform scattering
-            for (int m = 0; m < number_of_moments; ++m)
-            {
-                for (int gt = 0; gt < number_of_groups; ++gt)
-                {
-                    for (int n = 0; n < number_of_nodes; ++n)
-                    {
-                        double sum = 0;
-                        
-                        for (int gf = 0; gf < number_of_groups; ++gf)
-                        {
-                            int k_phi_from = n + number_of_nodes * (gf + number_of_groups * (m + number_of_moments * i));
-                            int k_sigma = d + number_of_dimensional_moments * (gf + number_of_groups * (gt + number_of_groups * m));
-                            
-                            sum += sigma_s[k_sigma] * y[k_phi_from];
-                        }
-                            
-                        int k_phi_to = n + number_of_nodes * (gt + number_of_groups * (m + number_of_moments * i));
                     
-                        x[k_phi_to] = sum;
-                    }
+                    int k_phi_to = n + number_of_nodes * (gt + number_of_groups * (m + number_of_moments * i));
+                    
+                    x[k_phi_to] = sum;
                 }
             }
-            break;
-        } // MOMENTS
-        default:
-            Assert(false);
-            break;
         }
     }
 }
@@ -149,7 +122,7 @@ apply_coherent(vector<double> &x) const
     int number_of_moments = angular_discretization_->number_of_moments();
     int number_of_scattering_moments = angular_discretization_->number_of_scattering_moments();
     int number_of_dimensional_moments = spatial_discretization_->dimensional_moments()->number_of_dimensional_moments();
-    vector<int> const scattering_indices = angular_discretization_->scattering_indices();
+    vector<int> const &scattering_indices = angular_discretization_->scattering_indices();
     
     for (int i = 0; i < number_of_points; ++i)
     {
@@ -157,7 +130,7 @@ apply_coherent(vector<double> &x) const
 
         // Get data
         shared_ptr<Cross_Section> sigma_s_cs = spatial_discretization_->point(i)->material()->sigma_s();
-        vector<double> const sigma_s = sigma_s_cs->data();
+        vector<double> const &sigma_s = sigma_s_cs->data();
         Cross_Section::Dependencies::Angular angular_dep = sigma_s_cs->dependencies().angular;
         
         switch (angular_dep)
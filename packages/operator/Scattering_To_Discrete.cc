@@ -0,0 +1,257 @@
+#include "Scattering_To_Discrete.hh"
+
+#if defined(ENABLE_OPENMP)
+    #include <omp.h>
+#endif
+
+#include <Eigen/Dense>
+
+#include "Angular_Discretization.hh"
+#include "Check.hh"
+#include "Cross_Section.hh"
+#include "Dimensional_Moments.hh"
+#include "Energy_Discretization.hh"
+#include "Fission_Table.hh"
+#include "Material.hh"
+#include "Point.hh"
+#include "Scattering_Table.hh"
+#include "Spatial_Discretization.hh"
+
+using namespace std;
+
+typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> EMatrix;
+typedef Eigen::Map<EMatrix> EMMatrix;
+typedef Eigen::Map<EMatrix const> ECMMatrix;
+
+Scattering_To_Discrete::
+Scattering_To_Discrete(shared_ptr<Spatial_Discretization> spatial_discretization,
+                       shared_ptr<Angular_Discretization> angular_discretization,
+                       shared_ptr<Energy_Discretization> energy_discretization,
+                       Options options):
+    Vector_Operator(),
+    options_(options),
+    spatial_discretization_(spatial_discretization),
+    angular_discretization_(angular_discretization),
+    energy_discretization_(energy_discretization)
+{
+    int number_of_points = spatial_discretization->number_of_points();
+    int number_of_nodes = spatial_discretization->number_of_nodes();
+    int number_of_groups = energy_discretization->number_of_groups();
+    int number_of_moments = angular_discretization->number_of_moments();
+    int number_of_ordinates = angular_discretization->number_of_ordinates();
+    row_size_ = number_of_points * number_of_nodes * number_of_groups * number_of_ordinates;
+    column_size_ = number_of_points * number_of_nodes * number_of_groups * number_of_moments;
+
+    // Precompute the moment-to-discrete coefficients
+    angular_discretization->moment_to_discrete_matrix(moment_to_discrete_);
+
+    // Get compressed scattering cross sections of the interned materials
+    if (options.include_scattering)
+    {
+        scattering_table_
+            = make_shared<Scattering_Table>(number_of_groups,
+                                            spatial_discretization->dimensional_moments()->number_of_dimensional_moments(),
+                                            spatial_discretization->material_table());
+    }
+
+    // Get fission cross sections, factored where possible
+    if (options.include_fission)
+    {
+        fission_table_
+            = make_shared<Fission_Table>(number_of_groups,
+                                         spatial_discretization->dimensional_moments()->number_of_dimensional_moments(),
+                                         spatial_discretization->material_table());
+    }
+
+    check_class_invariants();
+}
+
+void Scattering_To_Discrete::
+apply(vector<double> &x) const
+{
+    apply_from_workspace(x);
+}
+
+void Scattering_To_Discrete::
+apply_out_of_place(vector<double> const &x,
+                   vector<double> &y) const
+{
+    y.resize(row_size());
+
+    int number_of_points = spatial_discretization_->number_of_points();
+    int number_of_nodes = spatial_discretization_->number_of_nodes();
+    int number_of_groups = energy_discretization_->number_of_groups();
+    int number_of_moments = angular_discretization_->number_of_moments();
+    int number_of_ordinates = angular_discretization_->number_of_ordinates();
+    int local_size = number_of_nodes * number_of_groups;
+    ECMMatrix const moment_to_discrete(&moment_to_discrete_[0], number_of_moments, number_of_ordinates);
+
+    #pragma omp parallel
+    {
+        // Moment source for a single point, reused for each point
+        vector<double> source(local_size * number_of_moments);
+
+        #pragma omp for schedule(dynamic, 10)
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            // Get scattering and fission source moments
+            source.assign(local_size * number_of_moments, 0.);
+            if (options_.include_scattering)
+            {
+                add_scattering(i, x, source);
+            }
+            if (options_.include_fission)
+            {
+                add_fission(i, x, source);
+            }
+
+            // Convert moments to discrete source
+            ECMMatrix const phi(&source[0], local_size, number_of_moments);
+            EMMatrix psi(&y[local_size * number_of_ordinates * i], local_size, number_of_ordinates);
+
+            psi.noalias() = phi * moment_to_discrete;
+        }
+    }
+}
+
+void Scattering_To_Discrete::
+add_scattering(int i,
+               vector<double> const &x,
+               vector<double> &source) const
+{
+    int number_of_nodes = spatial_discretization_->number_of_nodes();
+    int number_of_groups = energy_discretization_->number_of_groups();
+    int number_of_moments = angular_discretization_->number_of_moments();
+    vector<int> const &scattering_indices = angular_discretization_->scattering_indices();
+    Scattering_Table const &table = *scattering_table_;
+    int d = 0;
+
+    // Get cross section information
+    int t = table.table_index(i);
+    bool scattering_moments = (table.angular_dependence(t)
+                               == Cross_Section::Dependencies::Angular::SCATTERING_MOMENTS);
+
+    // Perform scattering, gathering only the nonzero transfers
+    for (int m = 0; m < number_of_moments; ++m)
+    {
+        int l = scattering_moments ? scattering_indices[m] : m;
+        double const *x_from = &x[number_of_nodes * number_of_groups * (m + number_of_moments * i)];
+
+        for (int gt = 0; gt < number_of_groups; ++gt)
+        {
+            Scattering_Table::Row const row = table.row(t, l, d, gt);
+
+            for (int n = 0; n < number_of_nodes; ++n)
+            {
+                double sum = 0;
+
+                for (int j = 0; j < row.size; ++j)
+                {
+                    sum += row.values[j] * x_from[n + number_of_nodes * row.groups[j]];
+                }
+
+                int k_source = n + number_of_nodes * (gt + number_of_groups * m);
+
+                source[k_source] += sum;
+            }
+        }
+    }
+}
+
+void Scattering_To_Discrete::
+add_fission(int i,
+            vector<double> const &x,
+            vector<double> &source) const
+{
+    int number_of_nodes = spatial_discretization_->number_of_nodes();
+    int number_of_groups = energy_discretization_->number_of_groups();
+    int number_of_moments = angular_discretization_->number_of_moments();
+    int number_of_dimensional_moments = spatial_discretization_->dimensional_moments()->number_of_dimensional_moments();
+    Fission_Table const &table = *fission_table_;
+    int m = 0;
+    int d = 0;
+
+    // Fission only contributes to the zeroth moment
+    int t = table.table_index(i);
+    double const *x_from = &x[number_of_nodes * number_of_groups * (m + number_of_moments * i)];
+    if (table.factored(t))
+    {
+        double const *chi = table.chi(t);
+        double const *nu_sigma_f = table.nu_sigma_f(t);
+
+        for (int n = 0; n < number_of_nodes; ++n)
+        {
+            double fission_source = 0;
+
+            for (int g = 0; g < number_of_groups; ++g)
+            {
+                fission_source += nu_sigma_f[d + number_of_dimensional_moments * g] * x_from[n + number_of_nodes * g];
+            }
+
+            for (int g = 0; g < number_of_groups; ++g)
+            {
+                int k_source = n + number_of_nodes * g;
+
+                source[k_source] += chi[g] * fission_source;
+            }
+        }
+    }
+    else
+    {
+        double const *sigma_f = table.sigma_f(t);
+
+        for (int gt = 0; gt < number_of_groups; ++gt)
+        {
+            for (int n = 0; n < number_of_nodes; ++n)
+            {
+                double sum = 0;
+
+                for (int gf = 0; gf < number_of_groups; ++gf)
+                {
+                    int k_sigma = d + number_of_dimensional_moments * (gf + number_of_groups * gt);
+
+                    sum += sigma_f[k_sigma] * x_from[n + number_of_nodes * gf];
+                }
+
+                int k_source = n + number_of_nodes * gt;
+
+                source[k_source] += sum;
+            }
+        }
+    }
+}
+
+void Scattering_To_Discrete::
+check_class_invariants() const
+{
+    Assert(spatial_discretization_);
+    Assert(angular_discretization_);
+    Assert(energy_discretization_);
+    Assert(moment_to_discrete_.size() == (angular_discretization_->number_of_moments()
+                                          * angular_discretization_->number_of_ordinates()));
+
+    int number_of_points = spatial_discretization_->number_of_points();
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        shared_ptr<Material> material = spatial_discretization_->point(i)->material();
+        if (options_.include_scattering)
+        {
+            Assert(scattering_table_);
+            Cross_Section::Dependencies dep = material->sigma_s()->dependencies();
+            Assert(dep.angular == Cross_Section::Dependencies::Angular::SCATTERING_MOMENTS
+                   || dep.angular == Cross_Section::Dependencies::Angular::MOMENTS);
+            Assert(dep.energy == Cross_Section::Dependencies::Energy::GROUP_TO_GROUP);
+        }
+        if (options_.include_fission)
+        {
+            Assert(fission_table_);
+            Cross_Section::Dependencies dep = material->sigma_f()->dependencies();
+            Assert(dep.angular == Cross_Section::Dependencies::Angular::NONE);
+            if (dep.energy == Cross_Section::Dependencies::Energy::GROUP)
+            {
+                Assert(material->nu()->dependencies().energy == Cross_Section::Dependencies::Energy::GROUP);
+                Assert(material->chi()->dependencies().energy == Cross_Section::Dependencies::Energy::GROUP);
+            }
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef Scattering_To_Discrete_hh
+#define Scattering_To_Discrete_hh
+
+#include <memory>
+#include <vector>
+
+#include "Vector_Operator.hh"
+
+class Angular_Discretization;
+class Energy_Discretization;
+class Fission_Table;
+class Scattering_Table;
+class Spatial_Discretization;
+
+/*
+  Applies scattering and fission to a moment representation of the flux and
+  converts the result to the discrete angular source
+
+  Equivalent to Moment_To_Discrete * (Scattering + Fission), but each point
+  is processed in a single pass, so the moment-sized intermediate vectors of
+  the separate operators are never formed
+*/
+class Scattering_To_Discrete : public Vector_Operator
+{
+public:
+
+    struct Options
+    {
+        bool include_scattering = true;
+        bool include_fission = true;
+    };
+
+    // Constructor
+    Scattering_To_Discrete(std::shared_ptr<Spatial_Discretization> spatial_discretization,
+                           std::shared_ptr<Angular_Discretization> angular_discretization,
+                           std::shared_ptr<Energy_Discretization> energy_discretization,
+                           Options options);
+
+    virtual void check_class_invariants() const override;
+
+    virtual int row_size() const override
+    {
+        return row_size_;
+    }
+    virtual int column_size() const override
+    {
+        return column_size_;
+    }
+    virtual std::string description() const override
+    {
+        return "Scattering_To_Discrete";
+    }
+
+private:
+
+    virtual void apply(std::vector<double> &x) const override;
+    virtual void apply_out_of_place(std::vector<double> const &x,
+                                    std::vector<double> &y) const override;
+
+    // Add scattering or fission for point i to the local moment source
+    void add_scattering(int i,
+                        std::vector<double> const &x,
+                        std::vector<double> &source) const;
+    void add_fission(int i,
+                     std::vector<double> const &x,
+                     std::vector<double> &source) const;
+
+    Options options_;
+    int row_size_;
+    int column_size_;
+    std::shared_ptr<Spatial_Discretization> spatial_discretization_;
+    std::shared_ptr<Angular_Discretization> angular_discretization_;
+    std::shared_ptr<Energy_Discretization> energy_discretization_;
+
+    // Compressed scattering cross sections of each point
+    std::shared_ptr<Scattering_Table> scattering_table_;
+
+    // Fission cross sections of each point, factored where possible
+    std::shared_ptr<Fission_Table> fission_table_;
+
+    // Moment-to-discrete matrix, (2l + 1) / norm * P_m(o), column-major
+    // with moments as rows and ordinates as columns
+    std::vector<double> moment_to_discrete_;
+};
+
+#endif
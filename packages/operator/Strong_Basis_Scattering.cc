@@ -12,6 +12,7 @@
 #include "Cross_Section.hh"
 #include "Energy_Discretization.hh"
 #include "Material.hh"
+#include "Scattering_Table.hh"
 #include "Weak_Spatial_Discretization.hh"
 #include "Weight_Function.hh"
 
@@ -27,6 +28,12 @@ Strong_Basis_Scattering(shared_ptr<Weak_Spatial_Discretization> spatial_discreti
                              energy_discretization,
                              options)
 {
+    // Get compressed scattering cross sections of the interned materials
+    scattering_table_
+        = make_shared<Scattering_Table>(energy_discretization->number_of_groups(),
+                                        1, // dimensional moments
+                                        spatial_discretization->material_table());
+    
     check_class_invariants();
 }
 
@@ -40,6 +47,8 @@ check_class_invariants() const
            == Weak_Spatial_Discretization_Options::Weighting::BASIS);
     Assert(spatial_discretization_->options()->discretization
            == Weak_Spatial_Discretization_Options::Discretization::STRONG);
+    Assert(scattering_table_);
+    Assert(scattering_table_->number_of_points() == spatial_discretization_->number_of_points());
     
     int number_of_points = spatial_discretization_->number_of_points();
     for (int i = 0; i < number_of_points; ++i)
@@ -57,16 +66,16 @@ void Strong_Basis_Scattering::
 apply_full(vector<double> &x) const
 {
     // Get size information
-    int dimension = spatial_discretization_->dimension();
     int number_of_points = spatial_discretization_->number_of_points();
     int number_of_nodes = spatial_discretization_->number_of_nodes();
     int number_of_groups = energy_discretization_->number_of_groups();
     int number_of_moments = angular_discretization_->number_of_moments();
-    int number_of_scattering_moments = angular_discretization_->number_of_scattering_moments();
-    vector<int> const scattering_indices = angular_discretization_->scattering_indices();
+    vector<int> const &scattering_indices = angular_discretization_->scattering_indices();
+    Scattering_Table const &table = *scattering_table_;
     
-    // Copy source flux
-    vector<double> y(x);
+    // Move source flux into the workspace
+    vector<double> &y = workspace_;
+    y.swap(x);
     x.assign(number_of_points * number_of_nodes * number_of_groups * number_of_moments, 0);
     #pragma omp parallel for schedule(dynamic, 10)
     for (int i = 0; i < number_of_points; ++i)
@@ -74,8 +83,8 @@ apply_full(vector<double> &x) const
         // Get weight function and connectivity information
         shared_ptr<Weight_Function> weight = spatial_discretization_->weight(i);
         int const number_of_basis_functions = weight->number_of_basis_functions();
-        vector<int> const basis_function_indices = weight->basis_function_indices();
-        Weight_Function::Values const values = weight->values();
+        vector<int> const &basis_function_indices = weight->basis_function_indices();
+        Weight_Function::Values const &values = weight->values();
         
         // Perform scattering
         for (int m = 0; m < number_of_moments; ++m)
@@ -84,33 +93,30 @@ apply_full(vector<double> &x) const
             
             for (int gt = 0; gt < number_of_groups; ++gt)
             {
-                for (int n = 0; n < number_of_nodes; ++n)
+                for (int j = 0; j < number_of_basis_functions; ++j)
                 {
-                    double sum = 0;
-                        
-                    for (int j = 0; j < number_of_basis_functions; ++j)
+                    // Get summation constants and other basis data
+                    int b = basis_function_indices[j];
+                    double mult = values.v_b[j];
+                    double const *y_from = &y[number_of_nodes * number_of_groups * (m + number_of_moments * b)];
+                    
+                    // Get nonzero transfers for the basis function's cross section
+                    Scattering_Table::Row const row = table.row(table.table_index(b), l, 0, gt);
+                    
+                    for (int n = 0; n < number_of_nodes; ++n)
                     {
-                        // Get summation constants and other basis data
-                        int b = basis_function_indices[j];
-                        double mult = values.v_b[j];
+                        double sum = 0;
                         
-                        // Get cross section information: stored in weight functions but weighted by basis functions
-                        vector<double> const sigma_s
-                            = spatial_discretization_->weight(b)->material()->sigma_s()->data();
-                            
-                        for (int gf = 0; gf < number_of_groups; ++gf)
+                        for (int k = 0; k < row.size; ++k)
                         {
-                            int k_phi_from = n + number_of_nodes * (gf + number_of_groups * (m + number_of_moments * b));
-                            int k_sigma = gf + number_of_groups * (gt + number_of_groups * l);
-                                
-                            sum += sigma_s[k_sigma] * mult * y[k_phi_from];
+                            sum += row.values[k] * y_from[n + number_of_nodes * row.groups[k]];
                         } // from group
-                    } // basis functions
                         
-                    int k_phi_to = n + number_of_nodes * (gt + number_of_groups * (m + number_of_moments * i));
+                        int k_phi_to = n + number_of_nodes * (gt + number_of_groups * (m + number_of_moments * i));
                         
-                    x[k_phi_to] = sum;
-                } // nodes
+                        x[k_phi_to] += mult * sum;
+                    } // nodes
+                } // basis functions
             } // to group
         } // moments
     } // weight functions
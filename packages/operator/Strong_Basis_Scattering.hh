@@ -6,6 +6,8 @@
 
 #include "Full_Scattering_Operator.hh"
 
+class Scattering_Table;
+
 /*
   Applies scattering to a moment representation of the flux
 */
@@ -33,6 +35,9 @@ private:
     
     // Apply only within-group scattering
     virtual void apply_coherent(std::vector<double> &x) const override;
+
+    // Compressed scattering cross sections of each point
+    std::shared_ptr<Scattering_Table> scattering_table_;
 };
 
 #endif
@@ -28,6 +28,22 @@ public:
         
         return x;
     }
+
+    // Apply the operator to x, putting the result in y
+    // Does not allocate if y already has enough capacity
+    std::vector<double> &operator()(std::vector<double> const &x,
+                                    std::vector<double> &y)
+    {
+        Check(x.size() == column_size());
+        Check(&x != &y);
+        
+        apply_out_of_place(x, y);
+        number_of_evaluations_ += 1;
+        
+        Check(y.size() == row_size());
+        
+        return y;
+    }
     
     // Output size
     virtual int row_size() const = 0;
@@ -40,6 +56,17 @@ public:
     {
         return (row_size() == column_size());
     }
+
+    // Set the relative tolerance of iterative solves within the operator
+    // Composite operators pass the tolerance on to their components
+    virtual void set_inner_tolerance(double tolerance)
+    {
+    }
+
+    // Return iterative solves within the operator to their configured tolerance
+    virtual void reset_inner_tolerance()
+    {
+    }
     
     virtual void check_class_invariants() const = 0;
     virtual std::string description() const = 0;
@@ -47,10 +74,32 @@ public:
     {
         return number_of_evaluations_;
     }
+
+protected:
+
+    // Apply in place through apply_out_of_place, with the input moved to the
+    // workspace so that neither vector is reallocated once both are large enough
+    void apply_from_workspace(std::vector<double> &x) const
+    {
+        workspace_.swap(x);
+        apply_out_of_place(workspace_, x);
+    }
+    
+    // Storage reused between applications of the operator
+    mutable std::vector<double> workspace_;
     
 private:
     
     virtual void apply(std::vector<double> &x) const = 0;
+
+    // Apply to x, putting the result in y
+    // By default, copies x into y and applies the operator in place
+    virtual void apply_out_of_place(std::vector<double> const &x,
+                                    std::vector<double> &y) const
+    {
+        y.assign(x.begin(), x.end());
+        apply(y);
+    }
     
     int number_of_evaluations_;
 };
@@ -17,17 +17,28 @@ Vector_Operator_Difference(shared_ptr<Vector_Operator> op1,
 void Vector_Operator_Difference::
 apply(vector<double> &x) const
 {
-    vector<double> y(x);
-    
+    vector<double> &y = workspace_;
+    (*op2_)(x, y);
     (*op1_)(x);
-    (*op2_)(y);
-
     for (int i = 0; i < row_size(); ++i)
     {
         x[i] -= y[i];
     }
 }
 
+void Vector_Operator_Difference::
+apply_out_of_place(vector<double> const &x,
+                   vector<double> &y) const
+{
+    vector<double> &z = workspace_;
+    (*op1_)(x, y);
+    (*op2_)(x, z);
+    for (int i = 0; i < row_size(); ++i)
+    {
+        y[i] -= z[i];
+    }
+}
+
 void Vector_Operator_Difference::
 check_class_invariants() const
 {
@@ -21,6 +21,14 @@ apply(vector<double> &x) const
     (*op1_)(x);
 }
 
+void Vector_Operator_Product::
+apply_out_of_place(vector<double> const &x,
+                   vector<double> &y) const
+{
+    (*op2_)(x, workspace_);
+    (*op1_)(workspace_, y);
+}
+
 void Vector_Operator_Product::
 check_class_invariants() const
 {
@@ -29,11 +29,23 @@ public:
     virtual void check_class_invariants() const override;
 
     virtual std::string description() const override;
+    virtual void set_inner_tolerance(double tolerance) override
+    {
+        op1_->set_inner_tolerance(tolerance);
+        op2_->set_inner_tolerance(tolerance);
+    }
+    virtual void reset_inner_tolerance() override
+    {
+        op1_->reset_inner_tolerance();
+        op2_->reset_inner_tolerance();
+    }
     
     
 private:
 
     virtual void apply(std::vector<double> &x) const override;
+    virtual void apply_out_of_place(std::vector<double> const &x,
+                                    std::vector<double> &y) const override;
     
     std::shared_ptr<Vector_Operator> op1_;
     std::shared_ptr<Vector_Operator> op2_;
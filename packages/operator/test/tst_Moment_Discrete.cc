@@ -184,6 +184,17 @@ int test_moment_discrete(int dimension,
             cout << endl;
             checksum += 1;
         }
+
+        // Repeat without modifying the original vector
+        vector<double> phi_out;
+        (*DM)(phi, phi_out);
+        if (!ce::approx(phi, phi_out, tolerance))
+        {
+            cout << "out-of-place moment discrete from phi failed for test ";
+            cout << i;
+            cout << endl;
+            checksum += 1;
+        }
     }
     
     return checksum;
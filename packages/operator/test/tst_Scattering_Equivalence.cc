@@ -13,9 +13,12 @@
 #include "Discrete_Normalization_Operator.hh"
 #include "Energy_Discretization.hh"
 #include "Fission.hh"
+#include "Full_Fission.hh"
+#include "Full_Scattering.hh"
 #include "LDFE_Quadrature.hh"
 #include "Material.hh"
 #include "Material_Factory.hh"
+#include "Mixed_Cross_Section.hh"
 #include "Moment_To_Discrete.hh"
 #include "Moment_Weighting_Operator.hh"
 #include "Random_Number_Generator.hh"
@@ -24,6 +27,7 @@
 #include "SUPG_Moment_To_Discrete.hh"
 #include "SUPG_Scattering.hh"
 #include "Scattering.hh"
+#include "Scattering_To_Discrete.hh"
 #include "Vector_Operator_Functions.hh"
 #include "Weak_Spatial_Discretization.hh"
 #include "Weak_Spatial_Discretization_Factory.hh"
@@ -265,7 +269,7 @@ get_solid_geometry(vector<shared_ptr<Material> > materials,
 
 shared_ptr<Weak_Spatial_Discretization_Options>
 get_weak_options(bool supg,
-                 bool use_flux,
+                 Weak_Spatial_Discretization_Options::Weighting weighting,
                  int num_dimensional_points,
                  shared_ptr<Angular_Discretization> angular,
                  shared_ptr<Energy_Discretization> energy,
@@ -285,25 +289,21 @@ get_weak_options(bool supg,
         weak_options->include_supg = true;
     }
 
-    if (use_flux)
+    weak_options->weighting = weighting;
+    if (weighting == Weak_Spatial_Discretization_Options::Weighting::FLUX)
     {
         int number_of_groups = energy->number_of_groups();
         int number_of_moments = angular->number_of_moments();
         int number_of_points = num_dimensional_points * num_dimensional_points;
-        weak_options->weighting = Weak_Spatial_Discretization_Options::Weighting::FLUX;
         weak_options->flux_coefficients.assign(number_of_groups * number_of_moments * number_of_points, 1.);
     }
-    else
-    {
-        weak_options->weighting = Weak_Spatial_Discretization_Options::Weighting::FLAT;
-    }
 
     return weak_options;
 }
 
 void
 get_discretizations(bool supg,
-                    bool use_flux,
+                    Weak_Spatial_Discretization_Options::Weighting weighting,
                     bool equivalent_materials,
                     int num_dimensional_points,
                     double tau,
@@ -355,7 +355,7 @@ get_discretizations(bool supg,
     // Initialize spatial options
     shared_ptr<Weak_Spatial_Discretization_Options> weak_options
         = get_weak_options(supg,
-                           use_flux,
+                           weighting,
                            num_dimensional_points,
                            angular,
                            energy,
@@ -378,6 +378,7 @@ get_discretizations(bool supg,
 
 void
 get_standard_operator(bool use_flux,
+                      bool fused,
                       int num_dimensional_points,
                       shared_ptr<Angular_Discretization> &angular,
                       shared_ptr<Energy_Discretization> &energy,
@@ -387,7 +388,9 @@ get_standard_operator(bool use_flux,
 {
     // Get discretizations
     get_discretizations(false, // supg
-                        use_flux,
+                        (use_flux
+                         ? Weak_Spatial_Discretization_Options::Weighting::FLUX
+                         : Weak_Spatial_Discretization_Options::Weighting::FLAT),
                         false, // equivalent_materials,
                         num_dimensional_points,
                         0.0, // tau
@@ -413,9 +416,21 @@ get_standard_operator(bool use_flux,
         = make_shared<Moment_Weighting_Operator>(spatial,
                                                  angular,
                                                  energy);
+    shared_ptr<Scattering_To_Discrete> MSF
+        = make_shared<Scattering_To_Discrete>(spatial,
+                                              angular,
+                                              energy,
+                                              Scattering_To_Discrete::Options());
     
     // Combine combined operator
-    oper = M * (S + F) * W;
+    if (fused)
+    {
+        oper = MSF * W;
+    }
+    else
+    {
+        oper = M * (S + F) * W;
+    }
 }
                                                   
 void
@@ -430,7 +445,9 @@ get_supg_operator(bool use_flux,
 {
     // Get discretizations
     get_discretizations(true, // supg
-                        use_flux,
+                        (use_flux
+                         ? Weak_Spatial_Discretization_Options::Weighting::FLUX
+                         : Weak_Spatial_Discretization_Options::Weighting::FLAT),
                         false, // equivalent_materials
                         num_dimensional_points,
                         tau,
@@ -596,17 +613,19 @@ check_all_operators(int num_dimensional_points)
 
     // Initialize discretizations and operators
     cout << "initializing operators" << endl;
-    int num_cases = 4;
+    int num_cases = 5;
     vector<shared_ptr<Angular_Discretization> > angular(num_cases);
     vector<shared_ptr<Energy_Discretization> > energy(num_cases);
     vector<shared_ptr<Constructive_Solid_Geometry> > solid(num_cases);
     vector<shared_ptr<Weak_Spatial_Discretization> > spatial(num_cases);
     vector<shared_ptr<Vector_Operator> > oper(num_cases);
-    vector<bool> use_flux = {false, true, false, true};
-    vector<string> desc = {"standard", "flux", "supg", "supg_flux"};
-    for (int i = 0; i < 2; ++i)
+    vector<bool> use_flux = {false, true, false, true, false};
+    vector<bool> fused = {false, false, false, false, true};
+    vector<string> desc = {"standard", "flux", "supg", "supg_flux", "fused"};
+    for (int i : {0, 1, 4})
     {
         get_standard_operator(use_flux[i],
+                              fused[i],
                               num_dimensional_points,
                               angular[i],
                               energy[i],
@@ -762,12 +781,143 @@ check_supg_operators(int num_dimensional_points)
     return checksum;
 }
 
+int
+check_full_operators(int num_dimensional_points)
+{
+    // Set preliminary values
+    int checksum = 0;
+    cout << "check_full_operators running for ";
+    cout << num_dimensional_points;
+    cout << " dimensional points";
+    cout << endl;
+
+    // Get fully-weighted discretization, which stores mixed cross sections
+    cout << "creating full weighting operators" << endl;
+    shared_ptr<Angular_Discretization> angular;
+    shared_ptr<Energy_Discretization> energy;
+    shared_ptr<Constructive_Solid_Geometry> solid;
+    shared_ptr<Weak_Spatial_Discretization> spatial;
+    get_discretizations(false, // supg
+                        Weak_Spatial_Discretization_Options::Weighting::FULL,
+                        false, // equivalent_materials
+                        num_dimensional_points,
+                        0.0, // tau
+                        angular,
+                        energy,
+                        solid,
+                        spatial);
+    shared_ptr<Vector_Operator> S
+        = make_shared<Full_Scattering>(spatial,
+                                       angular,
+                                       energy);
+    shared_ptr<Vector_Operator> F
+        = make_shared<Full_Fission>(spatial,
+                                    angular,
+                                    energy);
+    
+    // Get random coefficients
+    vector<double> coefficients;
+    get_random_coefficients(angular,
+                            energy,
+                            spatial,
+                            coefficients);
+
+    // Apply the operators to the mixed cross sections
+    cout << "applying mixed operators" << endl;
+    vector<double> mixed_scattering = coefficients;
+    (*S)(mixed_scattering);
+    vector<double> mixed_fission = coefficients;
+    (*F)(mixed_fission);
+    
+    // Replace the mixed cross sections by their expanded data
+    int number_of_points = spatial->number_of_points();
+    int number_of_mixtures = 0;
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        shared_ptr<Weight_Function> weight = spatial->weight(i);
+        shared_ptr<Material> material = weight->material();
+        shared_ptr<Mixed_Cross_Section> mixed_sigma_s
+            = dynamic_pointer_cast<Mixed_Cross_Section>(material->sigma_s());
+        shared_ptr<Mixed_Cross_Section> mixed_sigma_f
+            = dynamic_pointer_cast<Mixed_Cross_Section>(material->sigma_f());
+        Assert(mixed_sigma_s);
+        Assert(mixed_sigma_f);
+        if (mixed_sigma_s->number_of_components() > 1)
+        {
+            number_of_mixtures += 1;
+        }
+        
+        vector<double> sigma_s_data;
+        mixed_sigma_s->expand(sigma_s_data);
+        vector<double> sigma_f_data;
+        mixed_sigma_f->expand(sigma_f_data);
+        shared_ptr<Cross_Section> sigma_s
+            = make_shared<Cross_Section>(mixed_sigma_s->dependencies(),
+                                         angular,
+                                         energy,
+                                         sigma_s_data);
+        shared_ptr<Cross_Section> sigma_f
+            = make_shared<Cross_Section>(mixed_sigma_f->dependencies(),
+                                         angular,
+                                         energy,
+                                         sigma_f_data);
+        weight->set_material(make_shared<Material>(material->index(),
+                                                   angular,
+                                                   energy,
+                                                   material->sigma_t(),
+                                                   sigma_s,
+                                                   material->nu(),
+                                                   sigma_f,
+                                                   material->chi(),
+                                                   material->internal_source(),
+                                                   material->norm()));
+    }
+
+    // Make sure some weight functions span both regions
+    if (number_of_mixtures == 0)
+    {
+        cout << "no weight functions span more than one region" << endl;
+        checksum += 1;
+    }
+    
+    // Apply the operators to the expanded cross sections
+    cout << "applying dense operators" << endl;
+    vector<double> dense_scattering = coefficients;
+    (*S)(dense_scattering);
+    vector<double> dense_fission = coefficients;
+    (*F)(dense_fission);
+    
+    // Check to ensure that the mixed and dense paths returned the same results
+    double tolerance = 1e-12;
+    if (ce::approx(mixed_scattering, dense_scattering, tolerance))
+    {
+        cout << "test_passed" << endl;
+    }
+    else
+    {
+        cout << "full scattering results differ" << endl;
+        checksum += 1;
+    }
+    if (ce::approx(mixed_fission, dense_fission, tolerance))
+    {
+        cout << "test_passed" << endl;
+    }
+    else
+    {
+        cout << "full fission results differ" << endl;
+        checksum += 1;
+    }
+
+    return checksum;
+}
+
 int main()
 {
     int checksum = 0;
 
     checksum += check_all_operators(9);
     checksum += check_supg_operators(9);
+    checksum += check_full_operators(9);
     
     return checksum;
 }
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "Cartesian_Plane.hh"
+#include "Conversion.hh"
 #include "Heat_Transfer_Integration.hh"
 #include "Heat_Transfer_Factory.hh"
 #include "Heat_Transfer_Solve.hh"
@@ -150,9 +151,14 @@ void run_test(XML_Node input_node,
                                                  spatial);
 
     // Initialize heat transfer solver
+    Heat_Transfer_Solve::Options solve_options;
+    solve_options.solver
+        = solve_options.solver_conversion()->convert(heat_node.get_attribute<string>("solver",
+                                                                                     "amesos"));
     shared_ptr<Heat_Transfer_Solve> solver
         = make_shared<Heat_Transfer_Solve>(integration,
-                                           spatial);
+                                           spatial,
+                                           solve_options);
 
     // Solve problem
     shared_ptr<Heat_Transfer_Solution> solution
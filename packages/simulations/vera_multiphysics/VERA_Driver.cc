@@ -210,7 +210,8 @@ run_heat(bool include_crack,
     // Get heat transfer solver
     shared_ptr<Heat_Transfer_Solve> solver
         = make_shared<Heat_Transfer_Solve>(integration,
-                                           spatial);
+                                           spatial,
+                                           Heat_Transfer_Solve::Options());
     shared_ptr<Heat_Transfer_Solution> solution
         = solver->solve();
 
@@ -0,0 +1,122 @@
+#include "Anderson_Acceleration.hh"
+
+#include <cmath>
+
+#include <Eigen/Dense>
+
+#include "Check.hh"
+#include "XML_Node.hh"
+
+using namespace std;
+
+Anderson_Acceleration::
+Anderson_Acceleration(Options options):
+    options_(options),
+    number_of_restarts_(0)
+{
+    Assert(options_.depth >= 0);
+    reset();
+}
+
+void Anderson_Acceleration::
+reset()
+{
+    residual_norm_ = -1;
+    g_last_.clear();
+    f_last_.clear();
+    dg_.clear();
+    df_.clear();
+}
+
+void Anderson_Acceleration::
+update(vector<double> const &x_old,
+       vector<double> &x)
+{
+    if (options_.depth == 0)
+    {
+        return;
+    }
+    
+    int const size = x.size();
+    Assert(x_old.size() == size);
+    
+    // Get residual of plain update
+    vector<double> f(size);
+    double residual_norm = 0;
+    for (int i = 0; i < size; ++i)
+    {
+        f[i] = x[i] - x_old[i];
+        residual_norm += f[i] * f[i];
+    }
+    residual_norm = sqrt(residual_norm);
+
+    // Restart if the residual increases
+    if (residual_norm_ >= 0 && residual_norm > residual_norm_)
+    {
+        number_of_restarts_ += 1;
+        reset();
+    }
+    residual_norm_ = residual_norm;
+    
+    // Add differences to history
+    if (!g_last_.empty())
+    {
+        vector<double> dg(size);
+        vector<double> df(size);
+        for (int i = 0; i < size; ++i)
+        {
+            dg[i] = x[i] - g_last_[i];
+            df[i] = f[i] - f_last_[i];
+        }
+        dg_.push_back(dg);
+        df_.push_back(df);
+        if (dg_.size() > options_.depth)
+        {
+            dg_.pop_front();
+            df_.pop_front();
+        }
+    }
+    g_last_ = x;
+    f_last_ = f;
+    
+    int const number_of_differences = df_.size();
+    if (number_of_differences == 0)
+    {
+        return;
+    }
+    
+    // Find coefficients that minimize the residual
+    Eigen::MatrixXd df_mat(size, number_of_differences);
+    for (int j = 0; j < number_of_differences; ++j)
+    {
+        df_mat.col(j) = Eigen::Map<Eigen::VectorXd const>(&df_[j][0], size);
+    }
+    Eigen::Map<Eigen::VectorXd const> f_vec(&f[0], size);
+    Eigen::VectorXd gamma = df_mat.colPivHouseholderQr().solve(f_vec);
+    
+    // Use plain update if the coefficients are not reasonable
+    if (!gamma.allFinite() || gamma.lpNorm<Eigen::Infinity>() > options_.max_coefficient)
+    {
+        number_of_restarts_ += 1;
+        reset();
+        return;
+    }
+    
+    // Get accelerated update
+    for (int j = 0; j < number_of_differences; ++j)
+    {
+        vector<double> const &dg = dg_[j];
+        for (int i = 0; i < size; ++i)
+        {
+            x[i] -= gamma(j) * dg[i];
+        }
+    }
+}
+
+void Anderson_Acceleration::
+output(XML_Node output_node) const
+{
+    output_node.set_attribute(options_.depth, "depth");
+    output_node.set_attribute(options_.max_coefficient, "max_coefficient");
+    output_node.set_attribute(number_of_restarts_, "number_of_restarts");
+}
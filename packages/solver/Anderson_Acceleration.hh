@@ -0,0 +1,59 @@
+#ifndef Anderson_Acceleration_hh
+#define Anderson_Acceleration_hh
+
+#include <deque>
+#include <vector>
+
+class XML_Node;
+
+/*
+  Anderson acceleration for the fixed-point iteration x = G(x)
+
+  Stores the differences of the last "depth" iterates and residuals
+  f = G(x) - x, and replaces each plain update G(x) with the combination
+  of previous updates that minimizes the residual in the least-squares
+  sense. If the combination coefficients exceed max_coefficient or the
+  residual grows, the history is discarded and the plain update is used.
+*/
+class Anderson_Acceleration
+{
+public:
+
+    struct Options
+    {
+        int depth = 5; // Number of previous iterates to store (0 for none)
+        double max_coefficient = 1e4;
+    };
+
+    // Constructor
+    Anderson_Acceleration(Options options);
+
+    // Clear stored history
+    void reset();
+    
+    // Replace the plain update x = G(x_old) with the accelerated update
+    void update(std::vector<double> const &x_old,
+                std::vector<double> &x);
+
+    // Number of times the plain update was used after a safeguard failure
+    int number_of_restarts() const
+    {
+        return number_of_restarts_;
+    }
+
+    // Output data to XML file
+    void output(XML_Node output_node) const;
+    
+private:
+
+    // Data
+    Options options_;
+    int number_of_restarts_;
+    double residual_norm_;
+    std::vector<double> g_last_;
+    std::vector<double> f_last_;
+    std::deque<std::vector<double> > dg_;
+    std::deque<std::vector<double> > df_;
+};
+
+#endif
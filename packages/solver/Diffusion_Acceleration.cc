@@ -0,0 +1,297 @@
+#include "Diffusion_Acceleration.hh"
+
+#include "Angular_Discretization.hh"
+#include "Basis_Function.hh"
+#include "Boundary_Source.hh"
+#include "Check.hh"
+#include "Cross_Section.hh"
+#include "Eigen_Sparse_Solver.hh"
+#include "Energy_Discretization.hh"
+#include "Heat_Transfer_Data.hh"
+#include "Heat_Transfer_Integration.hh"
+#include "Integral_Store.hh"
+#include "Material.hh"
+#include "Mixed_Cross_Section.hh"
+#include "Solid_Geometry.hh"
+#include "Transport_Discretization.hh"
+#include "Weak_Spatial_Discretization.hh"
+#include "Weight_Function.hh"
+
+using namespace std;
+
+/*
+  Diffusion coefficients for one group, constant over the Voronoi cell of
+  each point
+*/
+class Diffusion_Acceleration::Diffusion_Data : public Heat_Transfer_Data
+{
+public:
+
+    Diffusion_Data(shared_ptr<Weak_Spatial_Discretization> spatial_discretization,
+                   vector<double> const &diffusion,
+                   vector<double> const &absorption):
+        Heat_Transfer_Data(),
+        spatial_discretization_(spatial_discretization),
+        solid_geometry_(spatial_discretization->weight(0)->solid_geometry()),
+        diffusion_(diffusion),
+        absorption_(absorption)
+    {
+    }
+    
+    virtual double conduction(vector<double> const &position) const override
+    {
+        return diffusion_[spatial_discretization_->nearest_point(position)];
+    }
+    virtual double convection(vector<double> const &position) const override
+    {
+        // Zero current on reflecting boundaries, otherwise Marshak vacuum boundary
+        if (spatial_discretization_->has_reflection()
+            && solid_geometry_->boundary_source(position)->has_reflection())
+        {
+            return 0;
+        }
+        return 0.5;
+    }
+    virtual double source(vector<double> const &position) const override
+    {
+        return 0;
+    }
+    virtual double temperature_inf(vector<double> const &position) const override
+    {
+        return 0;
+    }
+    virtual double absorption(vector<double> const &position) const override
+    {
+        return absorption_[spatial_discretization_->nearest_point(position)];
+    }
+
+private:
+    
+    shared_ptr<Weak_Spatial_Discretization> spatial_discretization_;
+    shared_ptr<Solid_Geometry> solid_geometry_;
+    vector<double> diffusion_;
+    vector<double> absorption_;
+};
+
+Diffusion_Acceleration::
+Diffusion_Acceleration(shared_ptr<Weak_Spatial_Discretization> spatial_discretization,
+                       shared_ptr<Angular_Discretization> angular_discretization,
+                       shared_ptr<Energy_Discretization> energy_discretization,
+                       shared_ptr<Transport_Discretization> transport_discretization):
+    Square_Vector_Operator(),
+    spatial_discretization_(spatial_discretization),
+    angular_discretization_(angular_discretization),
+    energy_discretization_(energy_discretization),
+    transport_discretization_(transport_discretization)
+{
+    check_class_invariants();
+    initialize_solvers();
+}
+
+int Diffusion_Acceleration::
+size() const
+{
+    return (transport_discretization_->phi_size()
+            + transport_discretization_->number_of_augments());
+}
+
+double Diffusion_Acceleration::
+point_cross_section(shared_ptr<Cross_Section> cross_section,
+                    int k_energy) const
+{
+    int const dimensional_size = cross_section->dimensional_size();
+    int const spatial_size = cross_section->spatial_size();
+    
+    // For a mixture, average the coefficients of each component over the
+    // basis functions instead of expanding the data
+    shared_ptr<Mixed_Cross_Section> const mixed
+        = dynamic_pointer_cast<Mixed_Cross_Section>(cross_section);
+    if (mixed)
+    {
+        vector<double> const &coefficients = mixed->coefficients();
+        double sum = 0;
+        for (int r = 0; r < mixed->number_of_components(); ++r)
+        {
+            double coefficient = 0;
+            for (int j = 0; j < spatial_size; ++j)
+            {
+                coefficient += coefficients[dimensional_size * (j + spatial_size * r)];
+            }
+            sum += coefficient * mixed->component(r)->data()[k_energy];
+        }
+        return sum / spatial_size;
+    }
+    
+    // Spatial dependence is slowest, followed by angular moment zero
+    vector<double> const &data = cross_section->data();
+    int stride = data.size() / spatial_size;
+    double sum = 0;
+    for (int j = 0; j < spatial_size; ++j)
+    {
+        sum += data[dimensional_size * k_energy + stride * j];
+    }
+    return sum / spatial_size;
+}
+
+void Diffusion_Acceleration::
+initialize_solvers()
+{
+    int number_of_points = spatial_discretization_->number_of_points();
+    int number_of_groups = energy_discretization_->number_of_groups();
+    
+    // Get total and within-group isotropic scattering cross sections
+    sigma_t_.resize(number_of_points * number_of_groups);
+    sigma_s_.resize(number_of_points * number_of_groups);
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        shared_ptr<Material> material = spatial_discretization_->weight(i)->material();
+        shared_ptr<Cross_Section> sigma_t = material->sigma_t();
+        shared_ptr<Cross_Section> sigma_s = material->sigma_s();
+        Assert(sigma_t->dependencies().energy == Cross_Section::Dependencies::Energy::GROUP);
+        Assert(sigma_s->dependencies().energy == Cross_Section::Dependencies::Energy::GROUP_TO_GROUP);
+        
+        for (int g = 0; g < number_of_groups; ++g)
+        {
+            int k = g + number_of_groups * i;
+            sigma_t_[k] = point_cross_section(sigma_t,
+                                              g);
+            sigma_s_[k] = point_cross_section(sigma_s,
+                                              g + number_of_groups * g);
+        }
+    }
+    
+    // Get matrix pattern, which is the same for all groups
+    vector<int> const &number_of_basis_functions = spatial_discretization_->number_of_basis_functions();
+    vector<int> row_offsets(number_of_points + 1, 0);
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        row_offsets[i + 1] = row_offsets[i] + number_of_basis_functions[i];
+    }
+    vector<int> column_indices(row_offsets[number_of_points]);
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        vector<int> const &indices = spatial_discretization_->weight(i)->basis_function_indices();
+        copy(indices.begin(), indices.end(), column_indices.begin() + row_offsets[i]);
+    }
+    pattern_ = make_shared<Eigen_Sparse_Pattern<double> >(number_of_points,
+                                                          row_offsets,
+                                                          column_indices);
+
+    // Assemble and factor diffusion matrix for each group
+    shared_ptr<Heat_Transfer_Integration_Options> integration_options
+        = make_shared<Heat_Transfer_Integration_Options>();
+    integration_options->geometry = Heat_Transfer_Integration_Options::Geometry::CARTESIAN;
+    solvers_.resize(number_of_groups);
+    for (int g = 0; g < number_of_groups; ++g)
+    {
+        vector<double> diffusion(number_of_points);
+        vector<double> absorption(number_of_points);
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            int k = g + number_of_groups * i;
+            diffusion[i] = 1. / (3. * sigma_t_[k]);
+            absorption[i] = sigma_t_[k] - sigma_s_[k];
+        }
+        shared_ptr<Diffusion_Data> data
+            = make_shared<Diffusion_Data>(spatial_discretization_,
+                                          diffusion,
+                                          absorption);
+        Heat_Transfer_Integration integration(integration_options,
+                                              data,
+                                              spatial_discretization_);
+        
+        vector<vector<double> > const &matrix = integration.matrix();
+        vector<double> values(row_offsets[number_of_points]);
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            copy(matrix[i].begin(), matrix[i].end(), values.begin() + row_offsets[i]);
+        }
+        solvers_[g] = make_shared<Eigen_Sparse_Solver<double> >(pattern_);
+        solvers_[g]->initialize(values);
+    }
+}
+
+void Diffusion_Acceleration::
+apply(vector<double> &x) const
+{
+    int number_of_points = spatial_discretization_->number_of_points();
+    int number_of_nodes = spatial_discretization_->number_of_nodes();
+    int number_of_groups = energy_discretization_->number_of_groups();
+    int number_of_moments = angular_discretization_->number_of_moments();
+    shared_ptr<Integral_Store> const integral_store = spatial_discretization_->integral_store();
+    
+    // Copy change in flux and zero out result
+    vector<double> y(x);
+    x.assign(size(), 0);
+    
+    vector<double> rhs(number_of_points);
+    vector<double> lhs(number_of_points);
+    for (int g = 0; g < number_of_groups; ++g)
+    {
+        for (int n = 0; n < number_of_nodes; ++n)
+        {
+            // Get scattering source of the error
+            for (int i = 0; i < number_of_points; ++i)
+            {
+                Integral_Store::View const integrals = integral_store->view(i);
+                
+                double sum = 0;
+                for (int j = 0; j < integrals.number_of_basis_functions; ++j)
+                {
+                    int b = integrals.basis_function_indices[j];
+                    int k_phi = n + number_of_nodes * (g + number_of_groups * number_of_moments * b);
+                    sum += integrals.iv_b_w[j] * y[k_phi];
+                }
+                rhs[i] = sigma_s_[g + number_of_groups * i] * sum;
+            }
+
+            // Solve diffusion problem
+            solvers_[g]->solve(rhs,
+                               lhs);
+
+            // Put correction into scalar flux
+            for (int i = 0; i < number_of_points; ++i)
+            {
+                int k_phi = n + number_of_nodes * (g + number_of_groups * number_of_moments * i);
+                x[k_phi] = lhs[i];
+            }
+        }
+    }
+
+    // Put isotropic correction into reflected angular flux, which would
+    // otherwise reintroduce the error on the next sweep
+    if (transport_discretization_->has_reflection())
+    {
+        int phi_size = transport_discretization_->phi_size();
+        int number_of_boundary_points = spatial_discretization_->number_of_boundary_points();
+        int number_of_ordinates = angular_discretization_->number_of_ordinates();
+        double angular_normalization = angular_discretization_->angular_normalization();
+        for (int b = 0; b < number_of_boundary_points; ++b)
+        {
+            int i = spatial_discretization_->boundary_basis(b)->index();
+            for (int o = 0; o < number_of_ordinates; ++o)
+            {
+                for (int g = 0; g < number_of_groups; ++g)
+                {
+                    for (int n = 0; n < number_of_nodes; ++n)
+                    {
+                        int k_b = phi_size + n + number_of_nodes * (g + number_of_groups * (o + number_of_ordinates * b));
+                        int k_phi = n + number_of_nodes * (g + number_of_groups * number_of_moments * i);
+                        x[k_b] = x[k_phi] / angular_normalization;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Diffusion_Acceleration::
+check_class_invariants() const
+{
+    Assert(spatial_discretization_);
+    Assert(angular_discretization_);
+    Assert(energy_discretization_);
+    Assert(transport_discretization_);
+    AssertMsg(!spatial_discretization_->options()->include_supg,
+              "diffusion acceleration does not support SUPG");
+}
@@ -0,0 +1,77 @@
+#ifndef Diffusion_Acceleration_hh
+#define Diffusion_Acceleration_hh
+
+#include <memory>
+#include <vector>
+
+#include "Square_Vector_Operator.hh"
+
+class Angular_Discretization;
+class Cross_Section;
+class Energy_Discretization;
+class Heat_Transfer_Integration;
+template<class Scalar> class Eigen_Sparse_Pattern;
+template<class Scalar> class Eigen_Sparse_Solver;
+class Transport_Discretization;
+class Weak_Spatial_Discretization;
+
+/*
+  Diffusion synthetic acceleration for source iteration and Krylov solves
+
+  Takes the change in the flux over one transport sweep and returns the
+  diffusion estimate of the remaining error in the scalar flux,
+  
+    -div D grad f + (sigma_t - sigma_s0) f = sigma_s0 (phi_new - phi_old),
+
+  with D = 1 / (3 sigma_t), zero current on reflecting boundaries and a
+  Marshak vacuum condition on the rest of the boundary. The diffusion problem
+  for each group uses the weak meshless heat transfer assembly with the same
+  basis and weight functions as the transport problem, with cross sections
+  taken from the nearest point. Each group's matrix is factored once when the
+  operator is created. Higher moments of the result are zero, and the
+  reflected angular flux augments get the isotropic part of the correction.
+  SUPG is not supported, as the correction has no dimensional moments.
+*/
+class Diffusion_Acceleration : public Square_Vector_Operator
+{
+public:
+
+    // Constructor
+    Diffusion_Acceleration(std::shared_ptr<Weak_Spatial_Discretization> spatial_discretization,
+                           std::shared_ptr<Angular_Discretization> angular_discretization,
+                           std::shared_ptr<Energy_Discretization> energy_discretization,
+                           std::shared_ptr<Transport_Discretization> transport_discretization);
+
+    virtual int size() const override;
+    virtual void check_class_invariants() const override;
+    virtual std::string description() const override
+    {
+        return "Diffusion_Acceleration";
+    }
+    
+private:
+
+    // Heat transfer data for the diffusion problem of one group
+    class Diffusion_Data;
+    
+    virtual void apply(std::vector<double> &x) const override;
+
+    // Get the group cross section of point i, averaged over basis functions
+    double point_cross_section(std::shared_ptr<Cross_Section> cross_section,
+                               int k_energy) const;
+
+    // Assemble and factor the diffusion matrix for each group
+    void initialize_solvers();
+    
+    // Data
+    std::shared_ptr<Weak_Spatial_Discretization> spatial_discretization_;
+    std::shared_ptr<Angular_Discretization> angular_discretization_;
+    std::shared_ptr<Energy_Discretization> energy_discretization_;
+    std::shared_ptr<Transport_Discretization> transport_discretization_;
+    std::vector<double> sigma_t_; // point-group
+    std::vector<double> sigma_s_; // point-group, within-group isotropic scattering
+    std::shared_ptr<Eigen_Sparse_Pattern<double> > pattern_;
+    std::vector<std::shared_ptr<Eigen_Sparse_Solver<double> > > solvers_; // group
+};
+
+#endif
@@ -0,0 +1,51 @@
+#include "Inner_Tolerance.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Check.hh"
+
+using namespace std;
+
+Inner_Tolerance::
+Inner_Tolerance(Options options):
+    options_(options)
+{
+    Assert(options_.gamma > 0 && options_.gamma <= 1);
+    Assert(options_.alpha > 1 && options_.alpha <= 2);
+    Assert(options_.min_tolerance > 0);
+    Assert(options_.max_tolerance >= options_.min_tolerance);
+    reset();
+}
+
+void Inner_Tolerance::
+reset()
+{
+    tolerance_ = options_.max_tolerance;
+    error_ = -1;
+}
+
+double Inner_Tolerance::
+update(double error)
+{
+    double tolerance = options_.max_tolerance;
+    if (error_ > 0)
+    {
+        // Follow the rate of convergence of the outer error
+        tolerance = options_.gamma * pow(error / error_, options_.alpha);
+        
+        // Avoid decreasing the tolerance faster than the outer error
+        double const safeguard = options_.gamma * pow(tolerance_, options_.alpha);
+        if (safeguard > 0.1)
+        {
+            tolerance = max(tolerance, safeguard);
+        }
+    }
+
+    // Keep the inner error below the outer change
+    tolerance = min(tolerance, options_.gamma * error);
+    
+    tolerance_ = max(options_.min_tolerance, min(options_.max_tolerance, tolerance));
+    error_ = error;
+    return tolerance_;
+}
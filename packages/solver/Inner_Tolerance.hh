@@ -0,0 +1,48 @@
+#ifndef Inner_Tolerance_hh
+#define Inner_Tolerance_hh
+
+/*
+  Tolerance for inexact inner solves, driven by the outer error
+
+  Follows Eisenstat and Walker: the tolerance tracks the rate at which the
+  outer error decreases, eta_k = gamma (e_k / e_{k-1})^alpha, with a
+  safeguard against decreasing it too quickly. The tolerance is also kept
+  below gamma e_k so that the inner error does not dominate the change in
+  the outer iterate, and is bounded by the minimum and maximum tolerances.
+*/
+class Inner_Tolerance
+{
+public:
+
+    struct Options
+    {
+        double gamma = 0.9;
+        double alpha = 2.0;
+        double min_tolerance = 1e-8;
+        double max_tolerance = 1e-2;
+    };
+
+    // Constructor
+    Inner_Tolerance(Options options);
+
+    // Return to the maximum tolerance and clear the stored error
+    void reset();
+
+    // Current tolerance
+    double tolerance() const
+    {
+        return tolerance_;
+    }
+
+    // Get the tolerance for the next inner solve given the current outer error
+    double update(double error);
+    
+private:
+
+    // Data
+    Options options_;
+    double tolerance_;
+    double error_; // Negative before the first update
+};
+
+#endif
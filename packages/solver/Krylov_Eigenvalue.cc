@@ -42,7 +42,8 @@ Krylov_Eigenvalue(Options options,
                     shared_ptr<Transport_Discretization> transport_discretization,
                   shared_ptr<Vector_Operator> fission_operator,
                   shared_ptr<Vector_Operator> flux_operator,
-                  vector<shared_ptr<Vector_Operator> > value_operators):
+                  vector<shared_ptr<Vector_Operator> > value_operators,
+                  shared_ptr<Vector_Operator> preconditioner):
     Solver(options.solver_print,
            Solver::Type::K_EIGENVALUE),
     options_(options),
@@ -52,7 +53,8 @@ Krylov_Eigenvalue(Options options,
     transport_discretization_(transport_discretization),
     fission_operator_(fission_operator),
     flux_operator_(flux_operator),
-    value_operators_(value_operators)
+    value_operators_(value_operators),
+    preconditioner_(preconditioner)
 {
     check_class_invariants();
 }
@@ -81,6 +83,7 @@ solve()
         options.kspace = options_.kspace;
         options.solver_print = options_.solver_print;
         options.tolerance = options_.tolerance;
+        options.preconditioner = preconditioner_;
         shared_ptr<Aztec_Inverse_Operator> inverse_operator
             = make_shared<Aztec_Inverse_Operator>(options,
                                                   flux_operator_,
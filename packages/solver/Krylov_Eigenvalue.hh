@@ -37,7 +37,8 @@ public:
                       std::shared_ptr<Transport_Discretization> transport_discretization,
                       std::shared_ptr<Vector_Operator> fission_operator,
                       std::shared_ptr<Vector_Operator> flux_operator,
-                      std::vector<std::shared_ptr<Vector_Operator> > value_operators);
+                      std::vector<std::shared_ptr<Vector_Operator> > value_operators,
+                      std::shared_ptr<Vector_Operator> preconditioner = std::shared_ptr<Vector_Operator>());
     
     virtual void solve() override;
     virtual void output(XML_Node output_node) const override;
@@ -58,6 +59,7 @@ protected:
     std::shared_ptr<Vector_Operator> fission_operator_;
     std::shared_ptr<Vector_Operator> flux_operator_;
     std::vector<std::shared_ptr<Vector_Operator> > value_operators_;
+    std::shared_ptr<Vector_Operator> preconditioner_; // optional
     
     // Output data
     std::shared_ptr<Result> result_;
@@ -1,5 +1,6 @@
 #include "Krylov_Steady_State.hh"
 
+#include "Anderson_Acceleration.hh"
 #include "Angular_Discretization.hh"
 #include "Aztec_Inverse_Operator.hh"
 #include "Convergence_Measure.hh"
@@ -21,7 +22,8 @@ Krylov_Steady_State(Options options,
                     shared_ptr<Convergence_Measure> convergence,
                     shared_ptr<Vector_Operator> source_operator,
                     shared_ptr<Vector_Operator> flux_operator,
-                    vector<shared_ptr<Vector_Operator> > value_operators):
+                    vector<shared_ptr<Vector_Operator> > value_operators,
+                    shared_ptr<Vector_Operator> preconditioner):
     Solver(options.solver_print,
            Solver::Type::STEADY_STATE),
     options_(options),
@@ -32,7 +34,8 @@ Krylov_Steady_State(Options options,
     convergence_(convergence),
     source_operator_(source_operator),
     flux_operator_(flux_operator),
-    value_operators_(value_operators)
+    value_operators_(value_operators),
+    preconditioner_(preconditioner)
 {
     convergence_->set_tolerance(options.tolerance);
     check_class_invariants();
@@ -55,6 +58,9 @@ solve()
         double error = 1;
         double error_old = 1;
         vector<double> q_old;
+        Anderson_Acceleration::Options anderson_options;
+        anderson_options.depth = options_.anderson_depth;
+        Anderson_Acceleration anderson(anderson_options);
         for (int it = 0; it < options_.max_source_iterations; ++it)
         {
             print_iteration(it);
@@ -78,6 +84,10 @@ solve()
                 print_convergence();
                 break;
             }
+
+            // Accelerate next iterate
+            anderson.update(q_old,
+                            q);
         }
     }
     else
@@ -101,6 +111,7 @@ solve()
     options.kspace = options_.kspace;
     options.solver_print = options_.solver_print;
     options.tolerance = options_.tolerance;
+    options.preconditioner = preconditioner_;
     shared_ptr<Aztec_Inverse_Operator> solver
         = make_shared<Aztec_Inverse_Operator>(options,
                                               flux_operator_);
@@ -138,6 +149,8 @@ output(XML_Node output_node) const
                               "solver_print");
     output_node.set_attribute(options_.tolerance,
                               "tolerance");
+    output_node.set_attribute(options_.anderson_depth,
+                              "anderson_depth");
     
     // Output results
     output_result(output_node,
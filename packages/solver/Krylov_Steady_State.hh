@@ -23,6 +23,7 @@ public:
         int kspace = 20; // Number of past guesses to store
         int solver_print = 0;
         double tolerance = 1e-10;
+        int anderson_depth = 0; // Anderson acceleration history (0 for none)
     };
 
     Krylov_Steady_State(Options options,
@@ -33,7 +34,8 @@ public:
                         std::shared_ptr<Convergence_Measure> convergence,
                         std::shared_ptr<Vector_Operator> source_operator,
                         std::shared_ptr<Vector_Operator> flux_operator,
-                        std::vector<std::shared_ptr<Vector_Operator> > value_operators);
+                        std::vector<std::shared_ptr<Vector_Operator> > value_operators,
+                        std::shared_ptr<Vector_Operator> preconditioner = std::shared_ptr<Vector_Operator>());
     
     virtual void solve() override;
     virtual void output(XML_Node output_node) const override;
@@ -55,6 +57,7 @@ protected:
     std::shared_ptr<Vector_Operator> source_operator_;
     std::shared_ptr<Vector_Operator> flux_operator_;
     std::vector<std::shared_ptr<Vector_Operator> > value_operators_;
+    std::shared_ptr<Vector_Operator> preconditioner_; // optional
     
     // Output data
     std::shared_ptr<Result> result_;
@@ -0,0 +1,528 @@
+#include "Multigroup_Gauss_Seidel.hh"
+
+#include "Angular_Discretization.hh"
+#include "Aztec_Inverse_Operator.hh"
+#include "Check.hh"
+#include "Conversion.hh"
+#include "Convergence_Measure.hh"
+#include "Cross_Section.hh"
+#include "Energy_Discretization.hh"
+#include "Material.hh"
+#include "Mixed_Cross_Section.hh"
+#include "Sweep_Operator.hh"
+#include "Transport_Discretization.hh"
+#include "Vector_Operator.hh"
+#include "Weak_Spatial_Discretization.hh"
+#include "Weight_Function.hh"
+#include "XML_Node.hh"
+
+using namespace std;
+
+namespace // anonymous
+{
+    // The components of a mixture, or otherwise the cross section itself,
+    // so that mixtures need not be expanded to find their nonzero groups
+    vector<shared_ptr<Cross_Section> > cross_section_parts(shared_ptr<Cross_Section> cross_section)
+    {
+        shared_ptr<Mixed_Cross_Section> const mixed
+            = dynamic_pointer_cast<Mixed_Cross_Section>(cross_section);
+        if (!mixed)
+        {
+            return {cross_section};
+        }
+        
+        vector<shared_ptr<Cross_Section> > components(mixed->number_of_components());
+        for (int r = 0; r < mixed->number_of_components(); ++r)
+        {
+            components[r] = mixed->component(r);
+        }
+        return components;
+    }
+}
+
+Multigroup_Gauss_Seidel::
+Multigroup_Gauss_Seidel(Options options,
+                        shared_ptr<Weak_Spatial_Discretization> spatial_discretization,
+                        shared_ptr<Angular_Discretization> angular_discretization,
+                        shared_ptr<Energy_Discretization> energy_discretization,
+                        shared_ptr<Transport_Discretization> transport_discretization,
+                        shared_ptr<Convergence_Measure> convergence,
+                        shared_ptr<Sweep_Operator> sweep_operator,
+                        shared_ptr<Vector_Operator> source_operator,
+                        shared_ptr<Vector_Operator> flux_operator,
+                        vector<shared_ptr<Vector_Operator> > value_operators):
+    Solver(options.solver_print,
+           Solver::Type::STEADY_STATE),
+    options_(options),
+    spatial_discretization_(spatial_discretization),
+    angular_discretization_(angular_discretization),
+    energy_discretization_(energy_discretization),
+    transport_discretization_(transport_discretization),
+    convergence_(convergence),
+    sweep_operator_(sweep_operator),
+    source_operator_(source_operator),
+    flux_operator_(flux_operator),
+    value_operators_(value_operators)
+{
+    convergence_->set_tolerance(options.tolerance);
+    check_class_invariants();
+    initialize_group_structure();
+}
+
+void Multigroup_Gauss_Seidel::
+initialize_group_structure()
+{
+    int number_of_points = spatial_discretization_->number_of_points();
+    int number_of_nodes = spatial_discretization_->number_of_nodes();
+    int number_of_groups = energy_discretization_->number_of_groups();
+    int phi_size = transport_discretization_->phi_size();
+    int number_of_augments = transport_discretization_->number_of_augments();
+    
+    // Find groups that receive upscatter and groups that cause it
+    first_upscatter_group_ = -1;
+    last_upscatter_group_ = -1;
+    bool has_fission = false;
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        shared_ptr<Material> material = spatial_discretization_->weight(i)->material();
+        shared_ptr<Cross_Section> sigma_s = material->sigma_s();
+        Assert(sigma_s->dependencies().energy == Cross_Section::Dependencies::Energy::GROUP_TO_GROUP);
+        
+        // A mixture couples the groups that any of its components couple
+        for (shared_ptr<Cross_Section> const &cross_section : cross_section_parts(sigma_s))
+        {
+            vector<double> const &data = cross_section->data();
+            int const dimensional_size = cross_section->dimensional_size();
+            int const energy_size = cross_section->energy_size();
+            int const size = data.size();
+            for (int k = 0; k < size; ++k)
+            {
+                // Energy index is gf + number_of_groups * gt
+                int const e = (k / dimensional_size) % energy_size;
+                int const gf = e % number_of_groups;
+                int const gt = e / number_of_groups;
+                if (gf > gt && data[k] != 0)
+                {
+                    if (first_upscatter_group_ < 0 || gt < first_upscatter_group_)
+                    {
+                        first_upscatter_group_ = gt;
+                    }
+                    if (gf > last_upscatter_group_)
+                    {
+                        last_upscatter_group_ = gf;
+                    }
+                }
+            }
+        }
+
+        for (shared_ptr<Cross_Section> const &cross_section : cross_section_parts(material->sigma_f()))
+        {
+            for (double value : cross_section->data())
+            {
+                if (value != 0)
+                {
+                    has_fission = true;
+                }
+            }
+        }
+    }
+
+    // Fission couples all groups
+    if (has_fission)
+    {
+        first_upscatter_group_ = 0;
+        last_upscatter_group_ = number_of_groups - 1;
+    }
+    
+    // Get entries of phi and augments for each group
+    group_indices_.assign(number_of_groups, vector<int>());
+    for (int k = 0; k < phi_size; ++k)
+    {
+        group_indices_[(k / number_of_nodes) % number_of_groups].push_back(k);
+    }
+    for (int k = 0; k < number_of_augments; ++k)
+    {
+        group_indices_[(k / number_of_nodes) % number_of_groups].push_back(phi_size + k);
+    }
+    group_iterations_.assign(number_of_groups, 0);
+    
+    // Get within-group inverse operators
+    if (options_.group_solver == Options::Group_Solver::KRYLOV)
+    {
+        Aztec_Inverse_Operator::Options inverse_options;
+        inverse_options.max_iterations = options_.max_group_iterations;
+        inverse_options.kspace = options_.kspace;
+        inverse_options.solver_print = options_.solver_print;
+        inverse_options.tolerance = options_.tolerance;
+        group_inverses_.resize(number_of_groups);
+        for (int g = 0; g < number_of_groups; ++g)
+        {
+            shared_ptr<Vector_Operator> group_operator
+                = make_shared<Group_Operator>(group_indices_[g],
+                                              flux_operator_);
+            group_inverses_[g]
+                = make_shared<Aztec_Inverse_Operator>(inverse_options,
+                                                      group_operator);
+        }
+    }
+}
+
+void Multigroup_Gauss_Seidel::
+get_source(vector<double> &q)
+{
+    int phi_size = transport_discretization_->phi_size();
+    int number_of_augments = transport_discretization_->number_of_augments();
+    
+    // Calculate first-flight source
+    q.assign(phi_size + number_of_augments, 0);
+    print_name("Initial source iteration");
+    if (transport_discretization_->has_reflection())
+    {
+        double error = 1;
+        double error_old = 1;
+        vector<double> q_old;
+        for (int it = 0; it < options_.max_source_iterations; ++it)
+        {
+            print_iteration(it);
+            
+            // Perform sweep to get new phi
+            q_old = q;
+            (*source_operator_)(q);
+            
+            // Get error
+            error_old = error;
+            error = convergence_->error(q,
+                                        q_old);
+            print_error(error);
+
+            // Check convergence
+            bool converged = convergence_->check(error,
+                                                 error_old);
+            if (converged)
+            {
+                result_->source_iterations = it + 1;
+                print_convergence();
+                break;
+            }
+        }
+    }
+    else
+    {
+        // Without reflection, only one application of operator is needed
+        print_iteration(0);
+        (*source_operator_)(q); 
+        print_error(0);
+        print_convergence();
+    }
+
+    // Zero out augments of first-flight source
+    for (int i = phi_size; i < phi_size + number_of_augments; ++i)
+    {
+        q[i] = 0;
+    }
+}
+
+void Multigroup_Gauss_Seidel::
+solve()
+{
+    int phi_size = transport_discretization_->phi_size();
+    int number_of_groups = energy_discretization_->number_of_groups();
+    
+    // Initialize result
+    result_ = make_shared<Result>();
+    group_iterations_.assign(number_of_groups, 0);
+    
+    // Get first-flight source
+    vector<double> q;
+    get_source(q);
+    vector<double> x(q);
+    
+    // Solve groups that only receive downscatter from lower groups
+    int const last_downscatter_group = (first_upscatter_group_ < 0
+                                        ? number_of_groups
+                                        : first_upscatter_group_);
+    for (int g = 0; g < last_downscatter_group; ++g)
+    {
+        solve_group(g,
+                    q,
+                    x);
+    }
+
+    // Iterate over groups coupled by upscatter
+    if (first_upscatter_group_ >= 0)
+    {
+        print_name("Multigroup Gauss-Seidel");
+        vector<double> x_old;
+        double error = 1;
+        double error_old = 1;
+        for (int it = 0; it < options_.max_iterations; ++it)
+        {
+            print_iteration(it);
+            
+            x_old = x;
+            for (int g = first_upscatter_group_; g <= last_upscatter_group_; ++g)
+            {
+                solve_group(g,
+                            q,
+                            x);
+            }
+
+            // Get error
+            error_old = error;
+            error = convergence_->error(x,
+                                        x_old);
+            print_error(error);
+
+            // Check convergence
+            bool converged = convergence_->check(error,
+                                                 error_old);
+            if (converged)
+            {
+                result_->total_iterations = it + 1;
+                print_convergence();
+                break;
+            }
+        }
+
+        // If total iterations has not been changed, the result did not converge
+        if (result_->total_iterations == -1)
+        {
+            result_->total_iterations = options_.max_iterations;
+            print_failure();
+        }
+        
+        // Solve groups below the upscatter groups
+        for (int g = last_upscatter_group_ + 1; g < number_of_groups; ++g)
+        {
+            solve_group(g,
+                        q,
+                        x);
+        }
+    }
+    else
+    {
+        result_->total_iterations = 1;
+    }
+
+    // Get total within-group iterations
+    result_->inverse_iterations = 0;
+    for (int g = 0; g < number_of_groups; ++g)
+    {
+        result_->inverse_iterations += group_iterations_[g];
+    }
+    
+    // Remove augments from result
+    x.resize(phi_size);
+
+    // Store coefficients
+    result_->coefficients = x;
+
+    // Get result
+    int number_of_values = value_operators_.size();
+    result_->phi.resize(number_of_values);
+    for (int i = 0; i < number_of_values; ++i)
+    {
+        vector<double> &phi = result_->phi[i];
+        phi = x;
+        (*value_operators_[i])(phi);
+    }
+}
+
+void Multigroup_Gauss_Seidel::
+solve_group(int g,
+            vector<double> const &q,
+            vector<double> &x)
+{
+    // Only sweep this group
+    sweep_operator_->set_active_group(g);
+    
+    switch (options_.group_solver)
+    {
+    case Options::Group_Solver::SOURCE_ITERATION:
+        solve_group_source_iteration(g,
+                                     q,
+                                     x);
+        break;
+    case Options::Group_Solver::KRYLOV:
+        solve_group_krylov(g,
+                           q,
+                           x);
+        break;
+    }
+
+    sweep_operator_->set_active_group(-1);
+}
+
+void Multigroup_Gauss_Seidel::
+solve_group_source_iteration(int g,
+                             vector<double> const &q,
+                             vector<double> &x)
+{
+    vector<int> const &indices = group_indices_[g];
+    int const group_size = indices.size();
+    
+    vector<double> y;
+    vector<double> x_g(group_size);
+    vector<double> x_g_old(group_size);
+    double error = 1;
+    double error_old = 1;
+    for (int it = 0; it < options_.max_group_iterations; ++it)
+    {
+        // Perform sweep for this group, using current values of other groups
+        // The moment operators in the flux operator still act on all groups
+        y = x;
+        (*flux_operator_)(y);
+        
+        // Add first-flight source and update this group
+        for (int l = 0; l < group_size; ++l)
+        {
+            int const k = indices[l];
+            x_g_old[l] = x[k];
+            x_g[l] = y[k] + q[k];
+            x[k] = x_g[l];
+        }
+        group_iterations_[g] += 1;
+        
+        // Check convergence
+        error_old = error;
+        error = convergence_->error(x_g,
+                                    x_g_old);
+        if (convergence_->check(error,
+                                error_old))
+        {
+            return;
+        }
+    }
+}
+
+void Multigroup_Gauss_Seidel::
+solve_group_krylov(int g,
+                   vector<double> const &q,
+                   vector<double> &x)
+{
+    vector<int> const &indices = group_indices_[g];
+    int const group_size = indices.size();
+
+    // Get source from other groups
+    vector<double> y(x);
+    for (int l = 0; l < group_size; ++l)
+    {
+        y[indices[l]] = 0;
+    }
+    (*flux_operator_)(y);
+
+    // Gather right hand side for this group
+    vector<double> b(group_size);
+    for (int l = 0; l < group_size; ++l)
+    {
+        int const k = indices[l];
+        b[l] = y[k] + q[k];
+    }
+
+    // Solve within-group problem and scatter the result
+    int const iterations = group_inverses_[g]->number_of_iterations();
+    (*group_inverses_[g])(b);
+    group_iterations_[g] += group_inverses_[g]->number_of_iterations() - iterations;
+    for (int l = 0; l < group_size; ++l)
+    {
+        x[indices[l]] = b[l];
+    }
+}
+
+void Multigroup_Gauss_Seidel::
+output(XML_Node output_node) const
+{
+    // Output options
+    output_node.set_attribute(options_.group_solver_conversion()->convert(options_.group_solver),
+                              "group_solver");
+    output_node.set_attribute(options_.max_source_iterations,
+                              "max_source_iterations");
+    output_node.set_attribute(options_.max_iterations,
+                              "max_iterations");
+    output_node.set_attribute(options_.max_group_iterations,
+                              "max_group_iterations");
+    output_node.set_attribute(options_.kspace,
+                              "kspace");
+    output_node.set_attribute(options_.solver_print,
+                              "solver_print");
+    output_node.set_attribute(options_.tolerance,
+                              "tolerance");
+    output_node.set_attribute(first_upscatter_group_,
+                              "first_upscatter_group");
+    output_node.set_attribute(last_upscatter_group_,
+                              "last_upscatter_group");
+    output_node.set_child_vector(group_iterations_,
+                                 "group_iterations",
+                                 "group");
+    
+    // Output results
+    output_result(output_node,
+                  result_);
+}
+
+void Multigroup_Gauss_Seidel::
+check_class_invariants() const
+{
+    Assert(spatial_discretization_);
+    Assert(angular_discretization_);
+    Assert(energy_discretization_);
+    Assert(transport_discretization_);
+    Assert(convergence_);
+    Assert(sweep_operator_);
+    Assert(source_operator_);
+    Assert(flux_operator_);
+    for (std::shared_ptr<Vector_Operator> oper : value_operators_)
+    {
+        Assert(oper);
+    }
+}
+
+shared_ptr<Conversion<Multigroup_Gauss_Seidel::Options::Group_Solver, string> > Multigroup_Gauss_Seidel::Options::
+group_solver_conversion() const
+{
+    vector<pair<Group_Solver, string> > conversions
+        = {{Group_Solver::SOURCE_ITERATION, "source_iteration"},
+           {Group_Solver::KRYLOV, "krylov"}};
+    return make_shared<Conversion<Group_Solver, string> >(conversions);
+}
+
+Multigroup_Gauss_Seidel::Group_Operator::
+Group_Operator(vector<int> const &indices,
+               shared_ptr<Vector_Operator> flux_operator):
+    Square_Vector_Operator(),
+    indices_(indices),
+    flux_operator_(flux_operator)
+{
+    check_class_invariants();
+}
+
+void Multigroup_Gauss_Seidel::Group_Operator::
+apply(vector<double> &x) const
+{
+    int const group_size = indices_.size();
+    
+    // Scatter the values of this group into the full vector
+    vector<double> y(flux_operator_->row_size(), 0);
+    for (int l = 0; l < group_size; ++l)
+    {
+        y[indices_[l]] = x[l];
+    }
+    (*flux_operator_)(y);
+
+    // Gather and subtract result for this group
+    for (int l = 0; l < group_size; ++l)
+    {
+        x[l] -= y[indices_[l]];
+    }
+}
+
+void Multigroup_Gauss_Seidel::Group_Operator::
+check_class_invariants() const
+{
+    Assert(flux_operator_);
+    Assert(flux_operator_->square());
+    for (int k : indices_)
+    {
+        Assert(k >= 0 && k < flux_operator_->row_size());
+    }
+}
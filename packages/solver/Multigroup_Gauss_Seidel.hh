@@ -0,0 +1,166 @@
+#ifndef Multigroup_Gauss_Seidel_hh
+#define Multigroup_Gauss_Seidel_hh
+
+#include "Solver.hh"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Square_Vector_Operator.hh"
+
+class Angular_Discretization;
+class Aztec_Inverse_Operator;
+class Convergence_Measure;
+template<class T1, class T2> class Conversion;
+class Energy_Discretization;
+class Sweep_Operator;
+class Transport_Discretization;
+class Weak_Spatial_Discretization;
+
+/*
+  Solves the steady-state problem one group at a time
+
+  The group coupling is found from the scattering and fission cross sections.
+  Groups that only receive downscatter are solved once in order. Only the
+  groups between the first group to receive upscatter and the last group to
+  cause it are iterated together. Each group is converged with its own
+  within-group source iteration or Krylov solve, with the sweep restricted to
+  that group.
+
+  Only the sweep is restricted: each within-group iteration applies the full
+  flux operator, so the moment-to-discrete, scattering and discrete-to-moment
+  operators and the augments act on all groups. The cost of an iteration is
+  one group's sweep plus these moment operations on the full vector.
+*/
+class Multigroup_Gauss_Seidel : public Solver
+{
+public:
+
+    struct Options
+    {
+        // Within-group solver type
+        enum class Group_Solver
+        {
+            SOURCE_ITERATION,
+            KRYLOV
+        };
+        std::shared_ptr<Conversion<Group_Solver, std::string> > group_solver_conversion() const;
+        
+        Group_Solver group_solver = Group_Solver::SOURCE_ITERATION;
+        int max_source_iterations = 5000;
+        int max_iterations = 1000; // Outer iterations over the upscatter groups
+        int max_group_iterations = 5000;
+        int kspace = 20; // Number of past guesses to store
+        int solver_print = 0;
+        double tolerance = 1e-10;
+    };
+    
+    Multigroup_Gauss_Seidel(Options options,
+                            std::shared_ptr<Weak_Spatial_Discretization> spatial_discretization,
+                            std::shared_ptr<Angular_Discretization> angular_discretization,
+                            std::shared_ptr<Energy_Discretization> energy_discretization,
+                            std::shared_ptr<Transport_Discretization> transport_discretization,
+                            std::shared_ptr<Convergence_Measure> convergence,
+                            std::shared_ptr<Sweep_Operator> sweep_operator,
+                            std::shared_ptr<Vector_Operator> source_operator,
+                            std::shared_ptr<Vector_Operator> flux_operator,
+                            std::vector<std::shared_ptr<Vector_Operator> > value_operators);
+    
+    virtual void solve() override;
+    virtual std::shared_ptr<Result> result() const override
+    {
+        return result_;
+    }
+    virtual void output(XML_Node output_node) const override;
+    
+    virtual void check_class_invariants() const override;
+
+    // First and last groups that are iterated together, or -1 if none
+    int first_upscatter_group() const
+    {
+        return first_upscatter_group_;
+    }
+    int last_upscatter_group() const
+    {
+        return last_upscatter_group_;
+    }
+    
+private:
+
+    // Within-group operator: I - F restricted to the entries of one group,
+    // so the operator and its inverse have the size of the group
+    class Group_Operator : public Square_Vector_Operator
+    {
+    public:
+        
+        Group_Operator(std::vector<int> const &indices,
+                       std::shared_ptr<Vector_Operator> flux_operator);
+        
+        virtual int size() const override
+        {
+            return indices_.size();
+        }
+        virtual void check_class_invariants() const override;
+        virtual std::string description() const override
+        {
+            return "Multigroup_Gauss_Seidel::Group_Operator";
+        }
+        virtual void set_inner_tolerance(double tolerance) override
+        {
+            flux_operator_->set_inner_tolerance(tolerance);
+        }
+        virtual void reset_inner_tolerance() override
+        {
+            flux_operator_->reset_inner_tolerance();
+        }
+        
+    private:
+
+        virtual void apply(std::vector<double> &x) const override;
+        
+        std::vector<int> indices_;
+        std::shared_ptr<Vector_Operator> flux_operator_;
+    };
+    
+    // Find the groups coupled by upscatter or fission
+    void initialize_group_structure();
+
+    // Get the first-flight source
+    void get_source(std::vector<double> &q);
+    
+    // Converge group g with the other groups fixed
+    void solve_group(int g,
+                     std::vector<double> const &q,
+                     std::vector<double> &x);
+    void solve_group_source_iteration(int g,
+                                      std::vector<double> const &q,
+                                      std::vector<double> &x);
+    void solve_group_krylov(int g,
+                            std::vector<double> const &q,
+                            std::vector<double> &x);
+    
+    // Input data
+    Options options_;
+    std::shared_ptr<Weak_Spatial_Discretization> spatial_discretization_;
+    std::shared_ptr<Angular_Discretization> angular_discretization_;
+    std::shared_ptr<Energy_Discretization> energy_discretization_;
+    std::shared_ptr<Transport_Discretization> transport_discretization_;
+    std::shared_ptr<Convergence_Measure> convergence_;
+    std::shared_ptr<Sweep_Operator> sweep_operator_;
+    std::shared_ptr<Vector_Operator> source_operator_;
+    std::shared_ptr<Vector_Operator> flux_operator_;
+    std::vector<std::shared_ptr<Vector_Operator> > value_operators_;
+
+    // Group data
+    int first_upscatter_group_;
+    int last_upscatter_group_;
+    std::vector<std::vector<int> > group_indices_; // entries of phi and augments for each group
+    std::vector<int> group_iterations_;
+    std::vector<std::shared_ptr<Aztec_Inverse_Operator> > group_inverses_; // Krylov only
+    
+    // Output data
+    std::shared_ptr<Result> result_;
+};
+
+#endif
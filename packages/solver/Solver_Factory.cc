@@ -21,8 +21,10 @@
 #include "Moment_To_Discrete.hh"
 #include "Moment_Value_Operator.hh"
 #include "Moment_Weighting_Operator.hh"
+#include "Multigroup_Gauss_Seidel.hh"
 #include "Resize_Operator.hh"
 #include "Scattering.hh"
+#include "Scattering_To_Discrete.hh"
 #include "Source_Iteration.hh"
 #include "Strong_Basis_Fission.hh"
 #include "Strong_Basis_Scattering.hh"
@@ -43,6 +45,21 @@ Solver_Factory(shared_ptr<Weak_Spatial_Discretization> spatial,
                shared_ptr<Angular_Discretization> angular,
                shared_ptr<Energy_Discretization> energy,
                shared_ptr<Transport_Discretization> transport):
+    Solver_Factory(spatial,
+                   angular,
+                   energy,
+                   transport,
+                   Options())
+{
+}
+
+Solver_Factory::
+Solver_Factory(shared_ptr<Weak_Spatial_Discretization> spatial,
+               shared_ptr<Angular_Discretization> angular,
+               shared_ptr<Energy_Discretization> energy,
+               shared_ptr<Transport_Discretization> transport,
+               Options options):
+    options_(options),
     spatial_(spatial),
     angular_(angular),
     energy_(energy),
@@ -142,19 +159,6 @@ get_standard_source_operators(shared_ptr<Sweep_Operator> Linv,
                                           angular_,
                                           energy_);
     
-    // Get Scattering operators
-    Scattering_Operator::Options scattering_options;
-    shared_ptr<Vector_Operator> S
-        = make_shared<Scattering>(spatial_,
-                                  angular_,
-                                  energy_,
-                                  scattering_options);
-    shared_ptr<Vector_Operator> F
-        = make_shared<Fission>(spatial_,
-                               angular_,
-                               energy_,
-                               scattering_options);
-    
     // Get weighting operator
     Weighting_Operator::Options weighting_options;
     shared_ptr<Vector_Operator> Wm
@@ -178,12 +182,6 @@ get_standard_source_operators(shared_ptr<Sweep_Operator> Linv,
         D = make_shared<Augmented_Operator>(number_of_augments,
                                             D,
                                             false);
-        S = make_shared<Augmented_Operator>(number_of_augments,
-                                            S,
-                                            false);
-        F = make_shared<Augmented_Operator>(number_of_augments,
-                                            F,
-                                            true);
         Wm = make_shared<Augmented_Operator>(number_of_augments,
                                              Wm,
                                              false);
@@ -203,8 +201,52 @@ get_standard_source_operators(shared_ptr<Sweep_Operator> Linv,
     // Get combined operators
     source_operator
         = D * LinvB * M * Q;
-    flux_operator
-        = D * LinvI * M * (S + F) * Wm;
+    if (options_.fuse_operators)
+    {
+        // Fused scattering, fission and moment-to-discrete operator
+        Scattering_To_Discrete::Options fused_options;
+        shared_ptr<Vector_Operator> MSF
+            = make_shared<Scattering_To_Discrete>(spatial_,
+                                                  angular_,
+                                                  energy_,
+                                                  fused_options);
+        if (number_of_augments > 0)
+        {
+            MSF = make_shared<Augmented_Operator>(number_of_augments,
+                                                  MSF,
+                                                  false);
+        }
+        
+        flux_operator
+            = D * LinvI * MSF * Wm;
+    }
+    else
+    {
+        // Separate scattering and fission operators
+        Scattering_Operator::Options scattering_options;
+        shared_ptr<Vector_Operator> S
+            = make_shared<Scattering>(spatial_,
+                                      angular_,
+                                      energy_,
+                                      scattering_options);
+        shared_ptr<Vector_Operator> F
+            = make_shared<Fission>(spatial_,
+                                   angular_,
+                                   energy_,
+                                   scattering_options);
+        if (number_of_augments > 0)
+        {
+            S = make_shared<Augmented_Operator>(number_of_augments,
+                                                S,
+                                                false);
+            F = make_shared<Augmented_Operator>(number_of_augments,
+                                                F,
+                                                true);
+        }
+        
+        flux_operator
+            = D * LinvI * M * (S + F) * Wm;
+    }
 }
 
 void Solver_Factory::
@@ -673,29 +715,12 @@ get_standard_eigenvalue_operators(shared_ptr<Sweep_Operator> Linv,
     int phi_size = transport_->phi_size();
     int number_of_augments = transport_->number_of_augments();
     
-    // Get moment-to-discrete and discrete-to-moment operators
-    shared_ptr<Vector_Operator> M
-        = make_shared<Moment_To_Discrete>(spatial_,
-                                          angular_,
-                                          energy_);
+    // Get discrete-to-moment operator
     shared_ptr<Vector_Operator> D
         = make_shared<Discrete_To_Moment>(spatial_,
                                           angular_,
                                           energy_);
     
-    // Get Scattering operators
-    Scattering_Operator::Options scattering_options;
-    shared_ptr<Vector_Operator> S
-        = make_shared<Scattering>(spatial_,
-                                  angular_,
-                                  energy_,
-                                  scattering_options);
-    shared_ptr<Vector_Operator> F
-        = make_shared<Fission>(spatial_,
-                               angular_,
-                               energy_,
-                               scattering_options);
-    
     // Get weighting operator
     Weighting_Operator::Options weighting_options;
     shared_ptr<Vector_Operator> W
@@ -707,18 +732,9 @@ get_standard_eigenvalue_operators(shared_ptr<Sweep_Operator> Linv,
     // Add augments to operators
     if (number_of_augments > 0)
     {
-        M = make_shared<Augmented_Operator>(number_of_augments,
-                                            M,
-                                            false);
         D = make_shared<Augmented_Operator>(number_of_augments,
                                             D,
                                             false);
-        S = make_shared<Augmented_Operator>(number_of_augments,
-                                            S,
-                                            false);
-        F = make_shared<Augmented_Operator>(number_of_augments,
-                                            F,
-                                            true);
         W = make_shared<Augmented_Operator>(number_of_augments,
                                             W,
                                             false);
@@ -730,10 +746,74 @@ get_standard_eigenvalue_operators(shared_ptr<Sweep_Operator> Linv,
                                               Linv);
     
     // Get combined operators
-    fission_operator
-        = D * LinvI * M * F * W;
-    flux_operator
-        = D * LinvI * M * S * W;
+    if (options_.fuse_operators)
+    {
+        // Fused fission or scattering and moment-to-discrete operators
+        Scattering_To_Discrete::Options fission_options;
+        fission_options.include_scattering = false;
+        Scattering_To_Discrete::Options scattering_options;
+        scattering_options.include_fission = false;
+        shared_ptr<Vector_Operator> MF
+            = make_shared<Scattering_To_Discrete>(spatial_,
+                                                  angular_,
+                                                  energy_,
+                                                  fission_options);
+        shared_ptr<Vector_Operator> MS
+            = make_shared<Scattering_To_Discrete>(spatial_,
+                                                  angular_,
+                                                  energy_,
+                                                  scattering_options);
+        if (number_of_augments > 0)
+        {
+            MF = make_shared<Augmented_Operator>(number_of_augments,
+                                                 MF,
+                                                 true);
+            MS = make_shared<Augmented_Operator>(number_of_augments,
+                                                 MS,
+                                                 false);
+        }
+        
+        fission_operator
+            = D * LinvI * MF * W;
+        flux_operator
+            = D * LinvI * MS * W;
+    }
+    else
+    {
+        // Separate moment-to-discrete, scattering and fission operators
+        shared_ptr<Vector_Operator> M
+            = make_shared<Moment_To_Discrete>(spatial_,
+                                              angular_,
+                                              energy_);
+        Scattering_Operator::Options scattering_options;
+        shared_ptr<Vector_Operator> S
+            = make_shared<Scattering>(spatial_,
+                                      angular_,
+                                      energy_,
+                                      scattering_options);
+        shared_ptr<Vector_Operator> F
+            = make_shared<Fission>(spatial_,
+                                   angular_,
+                                   energy_,
+                                   scattering_options);
+        if (number_of_augments > 0)
+        {
+            M = make_shared<Augmented_Operator>(number_of_augments,
+                                                M,
+                                                false);
+            S = make_shared<Augmented_Operator>(number_of_augments,
+                                                S,
+                                                false);
+            F = make_shared<Augmented_Operator>(number_of_augments,
+                                                F,
+                                                true);
+        }
+        
+        fission_operator
+            = D * LinvI * M * F * W;
+        flux_operator
+            = D * LinvI * M * S * W;
+    }
 }
 
 void Solver_Factory::
@@ -1125,6 +1205,39 @@ get_krylov_steady_state(shared_ptr<Sweep_Operator> Linv,
     
 }
 
+std::shared_ptr<Multigroup_Gauss_Seidel> Solver_Factory::
+get_multigroup_gauss_seidel(shared_ptr<Sweep_Operator> Linv,
+                            shared_ptr<Convergence_Measure> convergence) const
+{
+    // Get combined operators
+    shared_ptr<Vector_Operator> source_operator;
+    shared_ptr<Vector_Operator> flux_operator;
+    get_source_operators(Linv,
+                         source_operator,
+                         flux_operator);
+    
+    // Get value operators
+    vector<shared_ptr<Vector_Operator> > value_operators
+        = {make_shared<Moment_Value_Operator>(spatial_,
+                                              angular_,
+                                              energy_,
+                                              false)}; // no weighting
+    
+    // Get multigroup solver
+    Multigroup_Gauss_Seidel::Options iteration_options;
+    iteration_options.solver_print = 0;
+    return make_shared<Multigroup_Gauss_Seidel>(iteration_options,
+                                                spatial_,
+                                                angular_,
+                                                energy_,
+                                                transport_,
+                                                convergence,
+                                                Linv,
+                                                source_operator,
+                                                flux_operator,
+                                                value_operators); 
+}
+
 std::shared_ptr<Krylov_Eigenvalue> Solver_Factory::
 get_krylov_eigenvalue(shared_ptr<Sweep_Operator> Linv) const
 {
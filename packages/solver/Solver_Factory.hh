@@ -8,6 +8,7 @@ class Convergence_Measure;
 class Energy_Discretization;
 class Krylov_Eigenvalue;
 class Krylov_Steady_State;
+class Multigroup_Gauss_Seidel;
 class Source_Iteration;
 class Sweep_Operator;
 class Transport_Discretization;
@@ -17,11 +18,23 @@ class Weak_Spatial_Discretization;
 class Solver_Factory
 {
 public:
+
+    struct Options
+    {
+        // Replace M * (S + F) chains with a single per-point operator
+        // where possible; the unfused chain is kept for verification
+        bool fuse_operators = true;
+    };
     
     Solver_Factory(std::shared_ptr<Weak_Spatial_Discretization> spatial,
                    std::shared_ptr<Angular_Discretization> angular,
                    std::shared_ptr<Energy_Discretization> energy,
                    std::shared_ptr<Transport_Discretization> transport);
+    Solver_Factory(std::shared_ptr<Weak_Spatial_Discretization> spatial,
+                   std::shared_ptr<Angular_Discretization> angular,
+                   std::shared_ptr<Energy_Discretization> energy,
+                   std::shared_ptr<Transport_Discretization> transport,
+                   Options options);
 
     // Get combined source operators
     void get_source_operators(std::shared_ptr<Sweep_Operator> Linv,
@@ -81,9 +94,12 @@ public:
     std::shared_ptr<Krylov_Steady_State> get_krylov_steady_state(std::shared_ptr<Sweep_Operator> Linv,
                                                                  std::shared_ptr<Convergence_Measure> convergence) const;
     std::shared_ptr<Krylov_Eigenvalue> get_krylov_eigenvalue(std::shared_ptr<Sweep_Operator> Linv) const;
+    std::shared_ptr<Multigroup_Gauss_Seidel> get_multigroup_gauss_seidel(std::shared_ptr<Sweep_Operator> Linv,
+                                                                         std::shared_ptr<Convergence_Measure> convergence) const;
     
 private:
     
+    Options options_;
     std::shared_ptr<Weak_Spatial_Discretization> spatial_;
     std::shared_ptr<Angular_Discretization> angular_;
     std::shared_ptr<Energy_Discretization> energy_;
@@ -1,17 +1,21 @@
 #include "Solver_Parser.hh"
 
 #include "Arbitrary_Moment_Value_Operator.hh"
+#include "Conversion.hh"
+#include "Diffusion_Acceleration.hh"
 #include "Identity_Operator.hh"
 #include "Integral_Value_Operator.hh"
 #include "Krylov_Eigenvalue.hh"
 #include "Krylov_Steady_State.hh"
 #include "Linf_Convergence.hh"
 #include "Moment_Value_Operator.hh"
+#include "Multigroup_Gauss_Seidel.hh"
 #include "Solver_Factory.hh"
 #include "Source_Iteration.hh"
 #include "Vector_Operator.hh"
 #include "Vector_Operator_Functions.hh"
 #include "Weak_Spatial_Discretization.hh"
+#include "Wielandt_Eigenvalue.hh"
 #include "XML_Node.hh"
 
 using namespace std;
@@ -117,6 +121,27 @@ get_value_operators(XML_Node input_node) const
     return opers;
 }
 
+shared_ptr<Vector_Operator> Solver_Parser::
+get_acceleration_operator(string acceleration) const
+{
+    if (acceleration == "none")
+    {
+        return shared_ptr<Vector_Operator>();
+    }
+    else if (acceleration == "diffusion")
+    {
+        return make_shared<Diffusion_Acceleration>(spatial_,
+                                                   angular_,
+                                                   energy_,
+                                                   transport_);
+    }
+    else
+    {
+        AssertMsg(false, "acceleration type (" + acceleration + ") not found");
+        return shared_ptr<Vector_Operator>();
+    }
+}
+
 shared_ptr<Source_Iteration> Solver_Parser::
 get_source_iteration(XML_Node input_node,
                      shared_ptr<Sweep_Operator> Linv) const
@@ -143,6 +168,14 @@ get_source_iteration(XML_Node input_node,
     iteration_options.max_iterations = input_node.get_attribute<int>("max_iterations", 5000);
     iteration_options.solver_print = input_node.get_attribute<int>("solver_print", 0);
     iteration_options.tolerance = input_node.get_attribute<double>("tolerance", 1e-10);
+    iteration_options.anderson_depth = input_node.get_attribute<int>("anderson_depth", 0);
+    iteration_options.adaptive_tolerance = input_node.get_attribute<bool>("adaptive_tolerance", false);
+    iteration_options.min_inner_tolerance = input_node.get_attribute<double>("min_inner_tolerance", 1e-8);
+    iteration_options.max_inner_tolerance = input_node.get_attribute<double>("max_inner_tolerance", 1e-2);
+    
+    // Get acceleration
+    shared_ptr<Vector_Operator> acceleration_operator
+        = get_acceleration_operator(input_node.get_attribute<string>("acceleration", "none"));
     
     // Create solver
     return make_shared<Source_Iteration>(iteration_options,
@@ -153,7 +186,8 @@ get_source_iteration(XML_Node input_node,
                                          convergence,
                                          source_operator,
                                          flux_operator,
-                                         value_operators); 
+                                         value_operators,
+                                         acceleration_operator); 
 }
 
 shared_ptr<Krylov_Steady_State> Solver_Parser::
@@ -185,6 +219,15 @@ get_krylov_steady_state(XML_Node input_node,
     iteration_options.kspace = input_node.get_attribute<int>("kspace", 10);
     iteration_options.solver_print = input_node.get_attribute<int>("solver_print", 0);
     iteration_options.tolerance = input_node.get_attribute<double>("tolerance", 1e-10);
+    iteration_options.anderson_depth = input_node.get_attribute<int>("anderson_depth", 0);
+    
+    // Get preconditioner, which adds the acceleration to the residual
+    shared_ptr<Vector_Operator> preconditioner
+        = get_acceleration_operator(input_node.get_attribute<string>("preconditioner", "none"));
+    if (preconditioner)
+    {
+        preconditioner = identity + preconditioner;
+    }
     
     // Create solver
     return make_shared<Krylov_Steady_State>(iteration_options,
@@ -195,7 +238,8 @@ get_krylov_steady_state(XML_Node input_node,
                                             convergence,
                                             source_operator,
                                             flux_operator,
-                                            value_operators); 
+                                            value_operators,
+                                            preconditioner); 
 }
 
 std::shared_ptr<Krylov_Eigenvalue> Solver_Parser::
@@ -217,6 +261,7 @@ get_krylov_eigenvalue(XML_Node input_node,
        = get_value_operators(input_node);
     
     // Get source iteration
+    shared_ptr<Vector_Operator> preconditioner;
     Krylov_Eigenvalue::Options iteration_options;
     iteration_options.explicit_inverse
         = input_node.get_attribute<bool>("explicit_inverse",
@@ -229,6 +274,12 @@ get_krylov_eigenvalue(XML_Node input_node,
         iteration_options.tolerance
             = input_node.get_attribute<double>("tolerance",
                                                iteration_options.tolerance);
+        preconditioner
+            = get_acceleration_operator(input_node.get_attribute<string>("preconditioner", "none"));
+        if (preconditioner)
+        {
+            preconditioner = identity + preconditioner;
+        }
     }
     iteration_options.max_iterations
         = input_node.get_attribute<int>("max_iterations",
@@ -250,5 +301,138 @@ get_krylov_eigenvalue(XML_Node input_node,
                                           transport_,
                                           fission_operator,
                                           flux_operator,
-                                          value_operators); 
+                                          value_operators,
+                                          preconditioner); 
+}
+
+shared_ptr<Wielandt_Eigenvalue> Solver_Parser::
+get_wielandt_eigenvalue(XML_Node input_node,
+                        shared_ptr<Sweep_Operator> Linv) const
+{
+    // Get combined operators
+    shared_ptr<Vector_Operator> fission_operator;
+    shared_ptr<Vector_Operator> flux_operator;
+    factory_->get_eigenvalue_operators(Linv,
+                                       fission_operator,
+                                       flux_operator);
+    shared_ptr<Identity_Operator> identity
+        = make_shared<Identity_Operator>(flux_operator->column_size());
+    flux_operator = identity - flux_operator;
+    
+    // Get value operator
+    vector<shared_ptr<Vector_Operator> > value_operators
+       = get_value_operators(input_node);
+
+    // Get preconditioner
+    shared_ptr<Vector_Operator> preconditioner
+        = get_acceleration_operator(input_node.get_attribute<string>("preconditioner", "none"));
+    if (preconditioner)
+    {
+        preconditioner = identity + preconditioner;
+    }
+    
+    // Get Wielandt iteration
+    Wielandt_Eigenvalue::Options iteration_options;
+    iteration_options.max_inverse_iterations
+        = input_node.get_attribute<int>("max_inverse_iterations",
+                                        iteration_options.max_inverse_iterations);
+    iteration_options.max_iterations
+        = input_node.get_attribute<int>("max_iterations",
+                                        iteration_options.max_iterations);
+    iteration_options.unshifted_iterations
+        = input_node.get_attribute<int>("unshifted_iterations",
+                                        iteration_options.unshifted_iterations);
+    iteration_options.kspace
+        = input_node.get_attribute<int>("kspace",
+                                        iteration_options.kspace);
+    iteration_options.solver_print
+        = input_node.get_attribute<int>("solver_print",
+                                        iteration_options.solver_print);
+    iteration_options.shift
+        = input_node.get_attribute<double>("shift",
+                                           iteration_options.shift);
+    iteration_options.initial_eigenvalue
+        = input_node.get_attribute<double>("initial_eigenvalue",
+                                           iteration_options.initial_eigenvalue);
+    iteration_options.tolerance
+        = input_node.get_attribute<double>("tolerance",
+                                           iteration_options.tolerance);
+    iteration_options.eigenvalue_tolerance
+        = input_node.get_attribute<double>("eigenvalue_tolerance",
+                                           iteration_options.eigenvalue_tolerance);
+    iteration_options.flux_tolerance
+        = input_node.get_attribute<double>("flux_tolerance",
+                                           iteration_options.flux_tolerance);
+    iteration_options.adaptive_tolerance
+        = input_node.get_attribute<bool>("adaptive_tolerance",
+                                         iteration_options.adaptive_tolerance);
+    iteration_options.max_inner_tolerance
+        = input_node.get_attribute<double>("max_inner_tolerance",
+                                           iteration_options.max_inner_tolerance);
+    
+    return make_shared<Wielandt_Eigenvalue>(iteration_options,
+                                            spatial_,
+                                            angular_,
+                                            energy_,
+                                            transport_,
+                                            fission_operator,
+                                            flux_operator,
+                                            value_operators,
+                                            preconditioner);
+}
+
+shared_ptr<Multigroup_Gauss_Seidel> Solver_Parser::
+get_multigroup_gauss_seidel(XML_Node input_node,
+                            shared_ptr<Sweep_Operator> Linv) const
+{
+    // Get combined operators
+    shared_ptr<Vector_Operator> source_operator;
+    shared_ptr<Vector_Operator> flux_operator;
+    factory_->get_source_operators(Linv,
+                                   source_operator,
+                                   flux_operator);
+    
+    // Get value operator
+    vector<shared_ptr<Vector_Operator> > value_operators
+        = get_value_operators(input_node);
+    
+    // Get convergence
+    shared_ptr<Convergence_Measure> convergence
+        = make_shared<Linf_Convergence>();
+    
+    // Get options
+    Multigroup_Gauss_Seidel::Options iteration_options;
+    string group_solver = input_node.get_attribute<string>("group_solver",
+                                                           "source_iteration");
+    iteration_options.group_solver = iteration_options.group_solver_conversion()->convert(group_solver);
+    iteration_options.max_source_iterations
+        = input_node.get_attribute<int>("max_source_iterations",
+                                        iteration_options.max_source_iterations);
+    iteration_options.max_iterations
+        = input_node.get_attribute<int>("max_iterations",
+                                        iteration_options.max_iterations);
+    iteration_options.max_group_iterations
+        = input_node.get_attribute<int>("max_group_iterations",
+                                        iteration_options.max_group_iterations);
+    iteration_options.kspace
+        = input_node.get_attribute<int>("kspace",
+                                        iteration_options.kspace);
+    iteration_options.solver_print
+        = input_node.get_attribute<int>("solver_print",
+                                        iteration_options.solver_print);
+    iteration_options.tolerance
+        = input_node.get_attribute<double>("tolerance",
+                                           iteration_options.tolerance);
+    
+    // Create solver
+    return make_shared<Multigroup_Gauss_Seidel>(iteration_options,
+                                                spatial_,
+                                                angular_,
+                                                energy_,
+                                                transport_,
+                                                convergence,
+                                                Linv,
+                                                source_operator,
+                                                flux_operator,
+                                                value_operators); 
 }
@@ -2,12 +2,14 @@
 #define Solver_Parser_hh
 
 #include <memory>
+#include <string>
 #include <vector>
 
 class Angular_Discretization;
 class Energy_Discretization;
 class Krylov_Steady_State;
 class Krylov_Eigenvalue;
+class Multigroup_Gauss_Seidel;
 class Solver;
 class Solver_Factory;
 class Source_Iteration;
@@ -15,6 +17,7 @@ class Sweep_Operator;
 class Transport_Discretization;
 class Vector_Operator;
 class Weak_Spatial_Discretization;
+class Wielandt_Eigenvalue;
 class XML_Node;
 
 class Solver_Parser
@@ -36,8 +39,18 @@ public:
     std::shared_ptr<Krylov_Eigenvalue>
     get_krylov_eigenvalue(XML_Node input_node,
                           std::shared_ptr<Sweep_Operator> Linv) const;
+    std::shared_ptr<Wielandt_Eigenvalue>
+    get_wielandt_eigenvalue(XML_Node input_node,
+                            std::shared_ptr<Sweep_Operator> Linv) const;
+    std::shared_ptr<Multigroup_Gauss_Seidel>
+    get_multigroup_gauss_seidel(XML_Node input_node,
+                                std::shared_ptr<Sweep_Operator> Linv) const;
 
 private:
+
+    // Get operator for the error after one sweep, or null for "none"
+    std::shared_ptr<Vector_Operator>
+    get_acceleration_operator(std::string acceleration) const;
     
     std::shared_ptr<Weak_Spatial_Discretization> spatial_;
     std::shared_ptr<Angular_Discretization> angular_;
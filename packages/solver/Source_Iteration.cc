@@ -1,8 +1,10 @@
 #include "Source_Iteration.hh"
 
+#include "Anderson_Acceleration.hh"
 #include "Angular_Discretization.hh"
 #include "Convergence_Measure.hh"
 #include "Energy_Discretization.hh"
+#include "Inner_Tolerance.hh"
 #include "Spatial_Discretization.hh"
 #include "Transport_Discretization.hh"
 #include "Vector_Operator.hh"
@@ -19,7 +21,8 @@ Source_Iteration(Options options,
                  shared_ptr<Convergence_Measure> convergence,
                  shared_ptr<Vector_Operator> source_operator,
                  shared_ptr<Vector_Operator> flux_operator,
-                 vector<shared_ptr<Vector_Operator> > value_operators):
+                 vector<shared_ptr<Vector_Operator> > value_operators,
+                 shared_ptr<Vector_Operator> acceleration_operator):
     Solver(options.solver_print,
            Solver::Type::STEADY_STATE),
     options_(options),
@@ -30,7 +33,8 @@ Source_Iteration(Options options,
     convergence_(convergence),
     source_operator_(source_operator),
     flux_operator_(flux_operator),
-    value_operators_(value_operators)
+    value_operators_(value_operators),
+    acceleration_operator_(acceleration_operator)
 {
     convergence_->set_tolerance(options.tolerance);
 }
@@ -43,6 +47,11 @@ solve()
 
     // Initialize result
     result_ = make_shared<Result>();
+
+    // Get options for adaptive inner tolerance
+    Inner_Tolerance::Options tolerance_options;
+    tolerance_options.min_tolerance = options_.min_inner_tolerance;
+    tolerance_options.max_tolerance = options_.max_inner_tolerance;
     
     // Calculate first-flight source
     vector<double> q(phi_size + number_of_augments, 0);
@@ -52,6 +61,14 @@ solve()
         double error = 1;
         double error_old = 1;
         vector<double> q_old;
+        Anderson_Acceleration::Options anderson_options;
+        anderson_options.depth = options_.anderson_depth;
+        Anderson_Acceleration anderson(anderson_options);
+        Inner_Tolerance inner_tolerance(tolerance_options);
+        if (options_.adaptive_tolerance)
+        {
+            source_operator_->set_inner_tolerance(inner_tolerance.tolerance());
+        }
         for (int it = 0; it < options_.max_source_iterations; ++it)
         {
             print_iteration(it);
@@ -75,6 +92,20 @@ solve()
                 print_convergence();
                 break;
             }
+
+            // Accelerate next iterate
+            anderson.update(q_old,
+                            q);
+
+            // Update inner tolerance for the next sweep
+            if (options_.adaptive_tolerance)
+            {
+                source_operator_->set_inner_tolerance(inner_tolerance.update(error));
+            }
+        }
+        if (options_.adaptive_tolerance)
+        {
+            source_operator_->reset_inner_tolerance();
         }
     }
     else
@@ -99,6 +130,14 @@ solve()
     {
         vector<double> x_old;
         double error_old = 1;
+        Anderson_Acceleration::Options anderson_options;
+        anderson_options.depth = options_.anderson_depth;
+        Anderson_Acceleration anderson(anderson_options);
+        Inner_Tolerance inner_tolerance(tolerance_options);
+        if (options_.adaptive_tolerance)
+        {
+            flux_operator_->set_inner_tolerance(inner_tolerance.tolerance());
+        }
         for (int it = 0; it < options_.max_iterations; ++it)
         {
             print_iteration(it);
@@ -112,6 +151,21 @@ solve()
             {
                 x[i] += q[i];
             }
+
+            // Add estimate of remaining error from acceleration
+            if (acceleration_operator_)
+            {
+                vector<double> dx(x.size());
+                for (int i = 0; i < dx.size(); ++i)
+                {
+                    dx[i] = x[i] - x_old[i];
+                }
+                (*acceleration_operator_)(dx);
+                for (int i = 0; i < dx.size(); ++i)
+                {
+                    x[i] += dx[i];
+                }
+            }
             
             // Get error
             error_old = error;
@@ -128,6 +182,20 @@ solve()
                 print_convergence();
                 break;
             }
+
+            // Accelerate next iterate
+            anderson.update(x_old,
+                            x);
+
+            // Update inner tolerance for the next sweep
+            if (options_.adaptive_tolerance)
+            {
+                flux_operator_->set_inner_tolerance(inner_tolerance.update(error));
+            }
+        }
+        if (options_.adaptive_tolerance)
+        {
+            flux_operator_->reset_inner_tolerance();
         }
     }
     // If total iterations has not been changed, the result did not converge
@@ -166,6 +234,21 @@ output(XML_Node output_node) const
                               "solver_print");
     output_node.set_attribute(options_.tolerance,
                               "tolerance");
+    output_node.set_attribute(options_.anderson_depth,
+                              "anderson_depth");
+    output_node.set_attribute(options_.adaptive_tolerance,
+                              "adaptive_tolerance");
+    if (options_.adaptive_tolerance)
+    {
+        output_node.set_attribute(options_.min_inner_tolerance,
+                                  "min_inner_tolerance");
+        output_node.set_attribute(options_.max_inner_tolerance,
+                                  "max_inner_tolerance");
+    }
+    output_node.set_attribute(acceleration_operator_
+                              ? acceleration_operator_->description()
+                              : string("none"),
+                              "acceleration");
     
     // Output results
     output_result(output_node,
@@ -186,4 +269,8 @@ check_class_invariants() const
     {
         Assert(oper);
     }
+    if (acceleration_operator_)
+    {
+        Assert(acceleration_operator_->square());
+    }
 }
@@ -20,6 +20,13 @@ public:
         int max_iterations = 5000;
         int solver_print = 0;
         double tolerance = 1e-10;
+        int anderson_depth = 0; // Anderson acceleration history (0 for none)
+
+        // Loosen the tolerance of the inner sweep solves while the outer
+        // error is large, tightening to min_inner_tolerance as it converges
+        bool adaptive_tolerance = false;
+        double min_inner_tolerance = 1e-8;
+        double max_inner_tolerance = 1e-2;
     };
     
     Source_Iteration(Options options,
@@ -30,7 +37,8 @@ public:
                      std::shared_ptr<Convergence_Measure> convergence,
                      std::shared_ptr<Vector_Operator> source_operator,
                      std::shared_ptr<Vector_Operator> flux_operator,
-                     std::vector<std::shared_ptr<Vector_Operator> > value_operators);
+                     std::vector<std::shared_ptr<Vector_Operator> > value_operators,
+                     std::shared_ptr<Vector_Operator> acceleration_operator = std::shared_ptr<Vector_Operator>());
     
     virtual void solve() override;
     virtual std::shared_ptr<Result> result() const override
@@ -53,7 +61,7 @@ private:
     std::shared_ptr<Vector_Operator> source_operator_;
     std::shared_ptr<Vector_Operator> flux_operator_;
     std::vector<std::shared_ptr<Vector_Operator> > value_operators_;
-    
+    std::shared_ptr<Vector_Operator> acceleration_operator_; // optional
     
     // Output data
     std::shared_ptr<Result> result_;
@@ -0,0 +1,266 @@
+#include "Wielandt_Eigenvalue.hh"
+
+#include <cmath>
+#include <iostream>
+
+#include "Angular_Discretization.hh"
+#include "Aztec_Inverse_Operator.hh"
+#include "Check.hh"
+#include "Energy_Discretization.hh"
+#include "Inner_Tolerance.hh"
+#include "Spatial_Discretization.hh"
+#include "Transport_Discretization.hh"
+#include "Vector_Functions.hh"
+#include "Vector_Operator.hh"
+#include "XML_Node.hh"
+
+using namespace std;
+
+namespace vf = Vector_Functions;
+
+Wielandt_Eigenvalue::
+Wielandt_Eigenvalue(Options options,
+                    shared_ptr<Spatial_Discretization> spatial_discretization,
+                    shared_ptr<Angular_Discretization> angular_discretization,
+                    shared_ptr<Energy_Discretization> energy_discretization,
+                    shared_ptr<Transport_Discretization> transport_discretization,
+                    shared_ptr<Vector_Operator> fission_operator,
+                    shared_ptr<Vector_Operator> flux_operator,
+                    vector<shared_ptr<Vector_Operator> > value_operators,
+                    shared_ptr<Vector_Operator> preconditioner):
+    Solver(options.solver_print,
+           Solver::Type::K_EIGENVALUE),
+    options_(options),
+    spatial_discretization_(spatial_discretization),
+    angular_discretization_(angular_discretization),
+    energy_discretization_(energy_discretization),
+    transport_discretization_(transport_discretization),
+    fission_operator_(fission_operator),
+    flux_operator_(flux_operator),
+    value_operators_(value_operators),
+    preconditioner_(preconditioner)
+{
+    check_class_invariants();
+}
+
+void Wielandt_Eigenvalue::
+solve()
+{
+    int phi_size = transport_discretization_->phi_size();
+    int size = flux_operator_->row_size();
+
+    // Initialize result
+    result_ = make_shared<Result>();
+
+    // Get shifted operator and its inverse
+    shared_ptr<Shifted_Operator> shifted_operator
+        = make_shared<Shifted_Operator>(fission_operator_,
+                                        flux_operator_);
+    Aztec_Inverse_Operator::Options inverse_options;
+    inverse_options.max_iterations = options_.max_inverse_iterations;
+    inverse_options.kspace = options_.kspace;
+    inverse_options.solver_print = options_.solver_print;
+    inverse_options.tolerance = options_.tolerance;
+    inverse_options.preconditioner = preconditioner_;
+    shared_ptr<Aztec_Inverse_Operator> inverse_operator
+        = make_shared<Aztec_Inverse_Operator>(inverse_options,
+                                              shifted_operator);
+
+    // Initialize flux with unit norm
+    vector<double> x(size, 1. / sqrt(static_cast<double>(size)));
+    vector<double> fx(x);
+    (*fission_operator_)(fx);
+    double k = options_.initial_eigenvalue;
+
+    // Initialize inner tolerance
+    Inner_Tolerance::Options tolerance_options;
+    tolerance_options.min_tolerance = options_.tolerance;
+    tolerance_options.max_tolerance = options_.max_inner_tolerance;
+    Inner_Tolerance inner_tolerance(tolerance_options);
+
+    print_name("Wielandt eigenvalue iteration");
+    vector<double> r(size);
+    vector<double> y(size);
+    vector<double> fy(size);
+    for (int it = 0; it < options_.max_iterations; ++it)
+    {
+        print_iteration(it);
+
+        // Update shift
+        double const inverse_shift
+            = it < options_.unshifted_iterations ? 0. : 1. / (k + options_.shift);
+        double const scale = 1. / k - inverse_shift;
+        shifted_operator->set_inverse_shift(inverse_shift);
+        if (options_.adaptive_tolerance)
+        {
+            inverse_operator->set_inner_tolerance(inner_tolerance.tolerance());
+        }
+
+        // Solve for the correction to x, so that the inner tolerance is
+        // relative to the outer residual:
+        // (M - F/k_s) d = (1/k - 1/k_s) F x - (M - F/k_s) x
+        r = x;
+        (*shifted_operator)(r);
+        for (int i = 0; i < size; ++i)
+        {
+            r[i] = scale * fx[i] - r[i];
+        }
+        (*inverse_operator)(r);
+        for (int i = 0; i < size; ++i)
+        {
+            y[i] = x[i] + r[i];
+        }
+
+        // Update eigenvalue from the ratio of the fission sources:
+        // 1/k_new - 1/k_s = (1/k - 1/k_s) / c, with y = c x at convergence
+        fy = y;
+        (*fission_operator_)(fy);
+        double const c = vf::dot(fy, fx) / vf::dot(fx, fx);
+        Assert(c > 0);
+        double const k_old = k;
+        k = 1. / (inverse_shift + scale / c);
+
+        // Normalize new flux
+        double const norm = vf::magnitude(y);
+        double flux_error = 0;
+        for (int i = 0; i < size; ++i)
+        {
+            double const x_new = y[i] / norm;
+            flux_error += (x_new - x[i]) * (x_new - x[i]);
+            x[i] = x_new;
+            fx[i] = fy[i] / norm;
+        }
+        flux_error = sqrt(flux_error);
+        double const eigenvalue_error = abs(k - k_old) / abs(k);
+        print_eigenvalue(k);
+        print_error(flux_error);
+        inner_tolerance.update(flux_error);
+
+        // Check convergence
+        if (eigenvalue_error < options_.eigenvalue_tolerance
+            && flux_error < options_.flux_tolerance)
+        {
+            result_->total_iterations = it + 1;
+            print_convergence();
+            break;
+        }
+    }
+
+    // If total iterations has not been changed, the result did not converge
+    if (result_->total_iterations == -1)
+    {
+        result_->total_iterations = options_.max_iterations;
+        print_failure();
+    }
+    result_->inverse_iterations = inverse_operator->number_of_iterations();
+    result_->k_eigenvalue = k;
+
+    // Get eigenvector
+    vector<double> &coefficients = result_->coefficients;
+    coefficients.assign(x.begin(), x.begin() + phi_size);
+
+    // Get flux
+    int number_of_values = value_operators_.size();
+    result_->phi.resize(number_of_values);
+    for (int i = 0; i < number_of_values; ++i)
+    {
+        vector<double> &phi = result_->phi[i];
+        phi = coefficients;
+        (*value_operators_[i])(phi);
+    }
+}
+
+void Wielandt_Eigenvalue::
+output(XML_Node output_node) const
+{
+    // Output options
+    output_node.set_attribute(options_.max_inverse_iterations,
+                              "max_inverse_iterations");
+    output_node.set_attribute(options_.max_iterations,
+                              "max_iterations");
+    output_node.set_attribute(options_.unshifted_iterations,
+                              "unshifted_iterations");
+    output_node.set_attribute(options_.kspace,
+                              "kspace");
+    output_node.set_attribute(options_.solver_print,
+                              "solver_print");
+    output_node.set_attribute(options_.shift,
+                              "shift");
+    output_node.set_attribute(options_.initial_eigenvalue,
+                              "initial_eigenvalue");
+    output_node.set_attribute(options_.tolerance,
+                              "tolerance");
+    output_node.set_attribute(options_.eigenvalue_tolerance,
+                              "eigenvalue_tolerance");
+    output_node.set_attribute(options_.flux_tolerance,
+                              "flux_tolerance");
+    output_node.set_attribute(options_.adaptive_tolerance,
+                              "adaptive_tolerance");
+    if (options_.adaptive_tolerance)
+    {
+        output_node.set_attribute(options_.max_inner_tolerance,
+                                  "max_inner_tolerance");
+    }
+
+    // Output results
+    output_result(output_node,
+                  result_);
+}
+
+void Wielandt_Eigenvalue::
+check_class_invariants() const
+{
+    Assert(spatial_discretization_);
+    Assert(angular_discretization_);
+    Assert(energy_discretization_);
+    Assert(transport_discretization_);
+    Assert(fission_operator_);
+    Assert(flux_operator_);
+    Assert(fission_operator_->square());
+    Assert(flux_operator_->square());
+    Assert(fission_operator_->row_size() == flux_operator_->row_size());
+    for (shared_ptr<Vector_Operator> oper : value_operators_)
+    {
+        Assert(oper);
+    }
+    Assert(options_.shift > 0);
+    Assert(options_.initial_eigenvalue > 0);
+}
+
+Wielandt_Eigenvalue::Shifted_Operator::
+Shifted_Operator(shared_ptr<Vector_Operator> fission_operator,
+                 shared_ptr<Vector_Operator> flux_operator):
+    Square_Vector_Operator(),
+    inverse_shift_(0),
+    fission_operator_(fission_operator),
+    flux_operator_(flux_operator)
+{
+    check_class_invariants();
+}
+
+void Wielandt_Eigenvalue::Shifted_Operator::
+apply(vector<double> &x) const
+{
+    if (inverse_shift_ == 0)
+    {
+        (*flux_operator_)(x);
+        return;
+    }
+
+    vector<double> y(x);
+    (*fission_operator_)(y);
+    (*flux_operator_)(x);
+    for (int i = 0; i < x.size(); ++i)
+    {
+        x[i] -= inverse_shift_ * y[i];
+    }
+}
+
+void Wielandt_Eigenvalue::Shifted_Operator::
+check_class_invariants() const
+{
+    Assert(fission_operator_);
+    Assert(flux_operator_);
+    Assert(fission_operator_->square());
+    Assert(flux_operator_->square());
+}
@@ -0,0 +1,128 @@
+#ifndef Wielandt_Eigenvalue_hh
+#define Wielandt_Eigenvalue_hh
+
+#include "Solver.hh"
+
+#include <memory>
+#include <vector>
+
+#include "Square_Vector_Operator.hh"
+
+class Angular_Discretization;
+class Aztec_Inverse_Operator;
+class Energy_Discretization;
+class Spatial_Discretization;
+class Transport_Discretization;
+
+/*
+  Power iteration for the fundamental mode with a Wielandt shift
+
+  Each outer iteration solves (M - F/k_s) y = (1/k - 1/k_s) F x with GMRES,
+  where M is the flux operator and F is the fission operator. The shift k_s
+  is kept a fixed distance above the running eigenvalue estimate, which
+  reduces the dominance ratio of the shifted problem. The first few
+  iterations are unshifted so that the estimate is reasonable before the
+  shift is applied.
+*/
+class Wielandt_Eigenvalue : public Solver
+{
+public:
+
+    struct Options
+    {
+        int max_inverse_iterations = 1000;
+        int max_iterations = 1000;
+        int unshifted_iterations = 3; // Power iterations before the shift is applied
+        int kspace = 20; // Number of past guesses to store
+        int solver_print = 0;
+        double shift = 0.1; // Difference between k_s and the eigenvalue estimate
+        double initial_eigenvalue = 1.0;
+        double tolerance = 1e-6; // Inner GMRES tolerance, relative to the outer residual
+        double eigenvalue_tolerance = 1e-8;
+        double flux_tolerance = 1e-6;
+
+        // Loosen the inner tolerance while the flux error is large,
+        // tightening to the inner tolerance above as it converges
+        bool adaptive_tolerance = false;
+        double max_inner_tolerance = 1e-2;
+    };
+
+    Wielandt_Eigenvalue(Options options,
+                        std::shared_ptr<Spatial_Discretization> spatial_discretization,
+                        std::shared_ptr<Angular_Discretization> angular_discretization,
+                        std::shared_ptr<Energy_Discretization> energy_discretization,
+                        std::shared_ptr<Transport_Discretization> transport_discretization,
+                        std::shared_ptr<Vector_Operator> fission_operator,
+                        std::shared_ptr<Vector_Operator> flux_operator,
+                        std::vector<std::shared_ptr<Vector_Operator> > value_operators,
+                        std::shared_ptr<Vector_Operator> preconditioner = std::shared_ptr<Vector_Operator>());
+
+    virtual void solve() override;
+    virtual void output(XML_Node output_node) const override;
+    virtual void check_class_invariants() const override;
+    virtual std::shared_ptr<Result> result() const override
+    {
+        return result_;
+    }
+
+private:
+
+    // Shifted operator M - F/k_s
+    class Shifted_Operator : public Square_Vector_Operator
+    {
+    public:
+
+        Shifted_Operator(std::shared_ptr<Vector_Operator> fission_operator,
+                         std::shared_ptr<Vector_Operator> flux_operator);
+
+        // Set the inverse of the shift, 1/k_s
+        void set_inverse_shift(double inverse_shift)
+        {
+            inverse_shift_ = inverse_shift;
+        }
+
+        virtual int size() const override
+        {
+            return flux_operator_->row_size();
+        }
+        virtual void check_class_invariants() const override;
+        virtual std::string description() const override
+        {
+            return "Wielandt_Eigenvalue::Shifted_Operator";
+        }
+        virtual void set_inner_tolerance(double tolerance) override
+        {
+            fission_operator_->set_inner_tolerance(tolerance);
+            flux_operator_->set_inner_tolerance(tolerance);
+        }
+        virtual void reset_inner_tolerance() override
+        {
+            fission_operator_->reset_inner_tolerance();
+            flux_operator_->reset_inner_tolerance();
+        }
+
+    private:
+
+        virtual void apply(std::vector<double> &x) const override;
+
+        double inverse_shift_;
+        std::shared_ptr<Vector_Operator> fission_operator_;
+        std::shared_ptr<Vector_Operator> flux_operator_;
+    };
+
+    // Input data
+    Options options_;
+    std::shared_ptr<Spatial_Discretization> spatial_discretization_;
+    std::shared_ptr<Angular_Discretization> angular_discretization_;
+    std::shared_ptr<Energy_Discretization> energy_discretization_;
+    std::shared_ptr<Transport_Discretization> transport_discretization_;
+    std::shared_ptr<Vector_Operator> fission_operator_;
+    std::shared_ptr<Vector_Operator> flux_operator_;
+    std::vector<std::shared_ptr<Vector_Operator> > value_operators_;
+    std::shared_ptr<Vector_Operator> preconditioner_; // optional
+
+    // Output data
+    std::shared_ptr<Result> result_;
+};
+
+#endif
@@ -13,23 +13,29 @@
 #include "Constructive_Solid_Geometry.hh"
 #include "Constructive_Solid_Geometry_Parser.hh"
 #include "Cross_Section.hh"
+#include "Diffusion_Acceleration.hh"
 #include "Discrete_Value_Operator.hh"
 #include "Energy_Discretization.hh"
 #include "Energy_Discretization_Parser.hh"
+#include "Identity_Operator.hh"
 #include "Krylov_Eigenvalue.hh"
 #include "Krylov_Steady_State.hh"
 #include "Linf_Convergence.hh"
 #include "Material.hh"
 #include "Material_Factory.hh"
 #include "Material_Parser.hh"
+#include "Moment_Value_Operator.hh"
+#include "Multigroup_Gauss_Seidel.hh"
 #include "Region.hh"
 #include "Solver_Factory.hh"
 #include "Source_Iteration.hh"
 #include "Transport_Discretization.hh"
+#include "Vector_Operator_Functions.hh"
 #include "Weak_Meshless_Sweep.hh"
 #include "Weak_Spatial_Discretization.hh"
 #include "Weak_Spatial_Discretization_Factory.hh"
 #include "Weak_Spatial_Discretization_Parser.hh"
+#include "Wielandt_Eigenvalue.hh"
 
 namespace ce = Check_Equality;
 using namespace std;
@@ -45,6 +51,8 @@ void get_one_region(bool basis_mls,
                     int angular_rule,
                     int num_dimensional_points,
                     double radius_num_intervals,
+                    int number_of_groups,
+                    bool downscatter_only,
                     double sigma_t,
                     double sigma_s,
                     double chi_nu_sigma_f,
@@ -71,21 +79,38 @@ void get_one_region(bool basis_mls,
                                                          angular_rule);
     
     // Get energy discretization
-    int number_of_groups = 1;
     energy = make_shared<Energy_Discretization>(number_of_groups);
     
-    // Get material
+    // Get material, with scattering and fission spread evenly over the
+    // groups so that the group-summed cross sections are unchanged
+    // Without upscatter, each group receives sigma_s evenly from itself and
+    // the groups above it, which keeps the flux the same in each group
+    vector<double> sigma_s_data(number_of_groups * number_of_groups, 0); // gf + number_of_groups * gt
+    for (int gt = 0; gt < number_of_groups; ++gt)
+    {
+        for (int gf = 0; gf < number_of_groups; ++gf)
+        {
+            if (!downscatter_only)
+            {
+                sigma_s_data[gf + number_of_groups * gt] = sigma_s / number_of_groups;
+            }
+            else if (gf <= gt)
+            {
+                sigma_s_data[gf + number_of_groups * gt] = sigma_s / (gt + 1);
+            }
+        }
+    }
     materials.resize(1);
     Material_Factory material_factory(angular,
                                       energy);
     materials[0]
         = material_factory.get_standard_material(0, // index
-                                                 {sigma_t},
-                                                 {sigma_s}, // sigma_s
-                                                 {1}, // nu
-                                                 {chi_nu_sigma_f}, // sigma_f
-                                                 {1}, // chi
-                                                 {internal_source});
+                                                 vector<double>(number_of_groups, sigma_t),
+                                                 sigma_s_data,
+                                                 vector<double>(number_of_groups, 1), // nu
+                                                 vector<double>(number_of_groups, chi_nu_sigma_f), // sigma_f
+                                                 vector<double>(number_of_groups, 1. / number_of_groups), // chi
+                                                 vector<double>(number_of_groups, internal_source));
     
     // Get boundary source
     boundary_sources.resize(1);
@@ -182,17 +207,150 @@ void get_one_region(bool basis_mls,
             = solver_factory.get_krylov_steady_state(sweeper,
                                                      convergence);
     }
+    else if (method == "krylov_steady_state_diffusion")
+    {
+        shared_ptr<Vector_Operator> source_operator;
+        shared_ptr<Vector_Operator> flux_operator;
+        solver_factory.get_source_operators(sweeper,
+                                            source_operator,
+                                            flux_operator);
+        shared_ptr<Identity_Operator> identity
+            = make_shared<Identity_Operator>(flux_operator->column_size());
+        flux_operator = identity - flux_operator;
+        vector<shared_ptr<Vector_Operator> > value_operators
+            = {make_shared<Moment_Value_Operator>(spatial,
+                                                  angular,
+                                                  energy,
+                                                  false)}; // no weighting
+        
+        // Precondition by adding the diffusion correction to the residual,
+        // as in Solver_Parser
+        shared_ptr<Vector_Operator> preconditioner
+            = identity + make_shared<Diffusion_Acceleration>(spatial,
+                                                             angular,
+                                                             energy,
+                                                             transport);
+        Krylov_Steady_State::Options iteration_options;
+        solver
+            = make_shared<Krylov_Steady_State>(iteration_options,
+                                               spatial,
+                                               angular,
+                                               energy,
+                                               transport,
+                                               convergence,
+                                               source_operator,
+                                               flux_operator,
+                                               value_operators,
+                                               preconditioner);
+    }
     else if (method == "source_iteration")
     {
         solver
             = solver_factory.get_source_iteration(sweeper,
                                                   convergence);
     }
+    else if (method == "source_iteration_diffusion"
+             || method == "source_iteration_anderson")
+    {
+        shared_ptr<Vector_Operator> source_operator;
+        shared_ptr<Vector_Operator> flux_operator;
+        solver_factory.get_source_operators(sweeper,
+                                            source_operator,
+                                            flux_operator);
+        vector<shared_ptr<Vector_Operator> > value_operators
+            = {make_shared<Moment_Value_Operator>(spatial,
+                                                  angular,
+                                                  energy,
+                                                  false)}; // no weighting
+        shared_ptr<Vector_Operator> acceleration_operator;
+        Source_Iteration::Options iteration_options;
+        if (method == "source_iteration_diffusion")
+        {
+            acceleration_operator
+                = make_shared<Diffusion_Acceleration>(spatial,
+                                                      angular,
+                                                      energy,
+                                                      transport);
+        }
+        else
+        {
+            iteration_options.anderson_depth = 5;
+        }
+        solver
+            = make_shared<Source_Iteration>(iteration_options,
+                                            spatial,
+                                            angular,
+                                            energy,
+                                            transport,
+                                            convergence,
+                                            source_operator,
+                                            flux_operator,
+                                            value_operators,
+                                            acceleration_operator);
+    }
+    else if (method == "multigroup_gauss_seidel")
+    {
+        solver
+            = solver_factory.get_multigroup_gauss_seidel(sweeper,
+                                                         convergence);
+    }
+    else if (method == "multigroup_gauss_seidel_krylov")
+    {
+        shared_ptr<Vector_Operator> source_operator;
+        shared_ptr<Vector_Operator> flux_operator;
+        solver_factory.get_source_operators(sweeper,
+                                            source_operator,
+                                            flux_operator);
+        vector<shared_ptr<Vector_Operator> > value_operators
+            = {make_shared<Moment_Value_Operator>(spatial,
+                                                  angular,
+                                                  energy,
+                                                  false)}; // no weighting
+        Multigroup_Gauss_Seidel::Options iteration_options;
+        iteration_options.group_solver = Multigroup_Gauss_Seidel::Options::Group_Solver::KRYLOV;
+        solver
+            = make_shared<Multigroup_Gauss_Seidel>(iteration_options,
+                                                   spatial,
+                                                   angular,
+                                                   energy,
+                                                   transport,
+                                                   convergence,
+                                                   sweeper,
+                                                   source_operator,
+                                                   flux_operator,
+                                                   value_operators);
+    }
     else if (method == "krylov_eigenvalue")
     {
         solver
             = solver_factory.get_krylov_eigenvalue(sweeper);
     }
+    else if (method == "wielandt_eigenvalue")
+    {
+        shared_ptr<Vector_Operator> fission_operator;
+        shared_ptr<Vector_Operator> flux_operator;
+        solver_factory.get_eigenvalue_operators(sweeper,
+                                                fission_operator,
+                                                flux_operator);
+        shared_ptr<Identity_Operator> identity
+            = make_shared<Identity_Operator>(flux_operator->column_size());
+        flux_operator = identity - flux_operator;
+        vector<shared_ptr<Vector_Operator> > value_operators
+            = {make_shared<Moment_Value_Operator>(spatial,
+                                                  angular,
+                                                  energy,
+                                                  false)}; // no weighting
+        Wielandt_Eigenvalue::Options iteration_options;
+        solver
+            = make_shared<Wielandt_Eigenvalue>(iteration_options,
+                                               spatial,
+                                               angular,
+                                               energy,
+                                               transport,
+                                               fission_operator,
+                                               flux_operator,
+                                               value_operators);
+    }
     else
     {
         AssertMsg(false, "iteration method not found");
@@ -210,6 +368,8 @@ int test_infinite(bool basis_mls,
                   int angular_rule,
                   int num_dimensional_points,
                   double radius_num_intervals,
+                  int number_of_groups,
+                  bool downscatter_only,
                   double sigma_t,
                   double sigma_s,
                   double chi_nu_sigma_f,
@@ -217,7 +377,8 @@ int test_infinite(bool basis_mls,
                   double boundary_source,
                   double alpha,
                   double length,
-                  double tolerance)
+                  double tolerance,
+                  int *total_iterations = nullptr)
 {
     int checksum = 0;
     
@@ -245,6 +406,8 @@ int test_infinite(bool basis_mls,
                    angular_rule,
                    num_dimensional_points,
                    radius_num_intervals,
+                   number_of_groups,
+                   downscatter_only,
                    sigma_t,
                    sigma_s,
                    chi_nu_sigma_f,
@@ -267,6 +430,10 @@ int test_infinite(bool basis_mls,
     solver->solve();
     shared_ptr<Solver::Result> result
         = solver->result();
+    if (total_iterations)
+    {
+        *total_iterations = result->total_iterations;
+    }
     
     // Print and check results
     bool print = true;
@@ -284,6 +451,20 @@ int test_infinite(bool basis_mls,
             checksum += 1;
         }
 
+        // Check that flux is constant, as its normalization is arbitrary
+        int phi_size = transport->phi_size();
+        int num_values = result->phi.size();
+        for (int j = 0; j < num_values; ++j)
+        {
+            vector<double> const &phi = result->phi[j];
+            vector<double> solution_vec(phi_size, phi[0]);
+            if (!ce::approx(solution_vec, phi, tolerance * abs(phi[0])))
+            {
+                checksum += 1;
+                cerr << "flux incorrect" << endl;
+            }
+        }
+
         // Print results
         if (print)
         {
@@ -367,6 +548,32 @@ int run_tests()
                                   16, // ordinates
                                   5, // number of points
                                   3, // number of intervals
+                                  1, // number of groups
+                                  false, // downscatter only
+                                  2.0, // sigma_t
+                                  0.8, // sigma_s
+                                  1.1, // nu_sigma_f
+                                  0.0, // internal source
+                                  0.0, // boundary source
+                                  1.0, // alpha
+                                  2.0, // length
+                                  1e-4); // tolerance
+
+        // Test 1D eigenvalue with Wielandt iteration
+        cout << description << "eigenvalue, wielandt" << endl;
+        checksum += test_infinite(true, // mls basis
+                                  true, // mls weight
+                                  "wendland11", // basis type
+                                  "wendland11", // weight type
+                                  weight_options,
+                                  weak_options,
+                                  "wielandt_eigenvalue",
+                                  1, // dimension
+                                  16, // ordinates
+                                  5, // number of points
+                                  3, // number of intervals
+                                  1, // number of groups
+                                  false, // downscatter only
                                   2.0, // sigma_t
                                   0.8, // sigma_s
                                   1.1, // nu_sigma_f
@@ -389,6 +596,8 @@ int run_tests()
                                   16, // ordinates
                                   5, // number of points
                                   3, // number of intervals
+                                  1, // number of groups
+                                  false, // downscatter only
                                   2.0, // sigma_t
                                   0.8, // sigma_s
                                   1.1, // nu_sigma_f
@@ -411,6 +620,8 @@ int run_tests()
                                   16, // ordinates
                                   5, // number of points
                                   3, // number of intervals
+                                  1, // number of groups
+                                  false, // downscatter only
                                   2.0, // sigma_t
                                   0.8, // sigma_s
                                   1.1, // nu_sigma_f
@@ -419,6 +630,177 @@ int run_tests()
                                   0.0, // alpha
                                   2.0, // length
                                   1e-4); // tolerance
+
+        // Test 1D diffusion and Anderson acceleration, which should reduce
+        // the number of source iterations for a scattering ratio near one
+        // Diffusion acceleration gives no correction to the dimensional
+        // moments that SUPG adds to the flux, so it requires the standard
+        // weighting
+        if (!weak_options->include_supg)
+        {
+            cout << description << "steady state with reflecting boundaries, source iteration" << endl;
+            int unaccelerated_iterations = 0;
+            checksum += test_infinite(true, // mls basis
+                                      true, // mls weight
+                                      "wendland11", // basis type
+                                      "wendland11", // weight type
+                                      weight_options,
+                                      weak_options,
+                                      "source_iteration",
+                                      1, // dimension
+                                      16, // ordinates
+                                      5, // number of points
+                                      3, // number of intervals
+                                      1, // number of groups
+                                      false, // downscatter only
+                                      1.0, // sigma_t
+                                      0.9, // sigma_s
+                                      0.0, // nu_sigma_f
+                                      1.0, // internal source
+                                      0.0, // boundary source
+                                      1.0, // alpha
+                                      2.0, // length
+                                      1e-4, // tolerance
+                                      &unaccelerated_iterations);
+            
+            vector<string> accelerated_methods = {"source_iteration_diffusion",
+                                                  "source_iteration_anderson"};
+            for (string accelerated_method : accelerated_methods)
+            {
+                cout << description << "steady state with reflecting boundaries, " << accelerated_method << endl;
+                int accelerated_iterations = 0;
+                checksum += test_infinite(true, // mls basis
+                                          true, // mls weight
+                                          "wendland11", // basis type
+                                          "wendland11", // weight type
+                                          weight_options,
+                                          weak_options,
+                                          accelerated_method,
+                                          1, // dimension
+                                          16, // ordinates
+                                          5, // number of points
+                                          3, // number of intervals
+                                          1, // number of groups
+                                          false, // downscatter only
+                                          1.0, // sigma_t
+                                          0.9, // sigma_s
+                                          0.0, // nu_sigma_f
+                                          1.0, // internal source
+                                          0.0, // boundary source
+                                          1.0, // alpha
+                                          2.0, // length
+                                          1e-4, // tolerance
+                                          &accelerated_iterations);
+                
+                if (accelerated_iterations >= unaccelerated_iterations)
+                {
+                    cerr << accelerated_method << " did not reduce iterations" << endl;
+                    checksum += 1;
+                }
+                cout << setw(16) << "iterations" << setw(16) << unaccelerated_iterations << setw(16) << accelerated_iterations << endl;
+                cout << endl;
+            }
+            
+            // Test the diffusion preconditioner, which should reduce the
+            // number of GMRES iterations
+            vector<string> krylov_methods = {"krylov_steady_state",
+                                             "krylov_steady_state_diffusion"};
+            vector<int> krylov_iterations(krylov_methods.size(), 0);
+            for (int m = 0; m < krylov_methods.size(); ++m)
+            {
+                cout << description << "steady state with reflecting boundaries, " << krylov_methods[m] << endl;
+                checksum += test_infinite(true, // mls basis
+                                          true, // mls weight
+                                          "wendland11", // basis type
+                                          "wendland11", // weight type
+                                          weight_options,
+                                          weak_options,
+                                          krylov_methods[m],
+                                          1, // dimension
+                                          16, // ordinates
+                                          5, // number of points
+                                          3, // number of intervals
+                                          1, // number of groups
+                                          false, // downscatter only
+                                          1.0, // sigma_t
+                                          0.9, // sigma_s
+                                          0.0, // nu_sigma_f
+                                          1.0, // internal source
+                                          0.0, // boundary source
+                                          1.0, // alpha
+                                          2.0, // length
+                                          1e-4, // tolerance
+                                          &krylov_iterations[m]);
+            }
+            if (krylov_iterations[1] >= krylov_iterations[0])
+            {
+                cerr << "diffusion preconditioner did not reduce iterations" << endl;
+                checksum += 1;
+            }
+            cout << setw(16) << "iterations" << setw(16) << krylov_iterations[0] << setw(16) << krylov_iterations[1] << endl;
+            cout << endl;
+        }
+
+        // Test 1D multigroup Gauss-Seidel with within-group source iteration
+        // and Krylov solves, which have operators of the size of one group
+        vector<string> multigroup_methods = {"multigroup_gauss_seidel",
+                                             "multigroup_gauss_seidel_krylov"};
+        for (string multigroup_method : multigroup_methods)
+        {
+            cout << description << "steady state, " << multigroup_method << endl;
+            checksum += test_infinite(true, // mls basis
+                                      true, // mls weight
+                                      "wendland11", // basis type
+                                      "wendland11", // weight type
+                                      weight_options,
+                                      weak_options,
+                                      multigroup_method,
+                                      1, // dimension
+                                      16, // ordinates
+                                      5, // number of points
+                                      3, // number of intervals
+                                      2, // number of groups
+                                      false, // downscatter only
+                                      1.0, // sigma_t
+                                      0.5, // sigma_s
+                                      0.0, // nu_sigma_f
+                                      1.0, // internal source
+                                      0.0, // boundary source
+                                      1.0, // alpha
+                                      2.0, // length
+                                      1e-4); // tolerance
+            
+            // Without upscatter, each group is solved once in order
+            cout << description << "steady state without upscatter, " << multigroup_method << endl;
+            int outer_iterations = 0;
+            checksum += test_infinite(true, // mls basis
+                                      true, // mls weight
+                                      "wendland11", // basis type
+                                      "wendland11", // weight type
+                                      weight_options,
+                                      weak_options,
+                                      multigroup_method,
+                                      1, // dimension
+                                      16, // ordinates
+                                      5, // number of points
+                                      3, // number of intervals
+                                      2, // number of groups
+                                      true, // downscatter only
+                                      1.0, // sigma_t
+                                      0.5, // sigma_s
+                                      0.0, // nu_sigma_f
+                                      1.0, // internal source
+                                      0.0, // boundary source
+                                      1.0, // alpha
+                                      2.0, // length
+                                      1e-4, // tolerance
+                                      &outer_iterations);
+            if (outer_iterations != 1)
+            {
+                cerr << multigroup_method << " iterated without upscatter" << endl;
+                checksum += 1;
+            }
+        }
     }
 
     // Run 2D problems
@@ -453,6 +835,8 @@ int run_tests()
                                   3, // angular rule
                                   5, // number of points
                                   3, // number of intervals
+                                  1, // number of groups
+                                  false, // downscatter only
                                   2.0, // sigma_t
                                   0.8, // sigma_s
                                   1.1, // nu_sigma_f
@@ -475,6 +859,8 @@ int run_tests()
                                   3, // angular rule
                                   5, // number of points
                                   3, // number of intervals
+                                  1, // number of groups
+                                  false, // downscatter only
                                   2.0, // sigma_t
                                   0.8, // sigma_s
                                   1.1, // nu_sigma_f
@@ -497,6 +883,8 @@ int run_tests()
                                   2, // angular rule
                                   5, // number of points
                                   3, // number of intervals
+                                  1, // number of groups
+                                  false, // downscatter only
                                   2.0, // sigma_t
                                   0.8, // sigma_s
                                   1.1, // nu_sigma_f
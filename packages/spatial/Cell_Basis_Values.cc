@@ -0,0 +1,144 @@
+#include "Cell_Basis_Values.hh"
+
+#if defined(ENABLE_OPENMP)
+    #include <omp.h>
+#endif
+
+#include "Check.hh"
+#include "Integration_Mesh.hh"
+
+using namespace std;
+
+Cell_Basis_Values::
+Cell_Basis_Values(shared_ptr<Integration_Mesh> mesh):
+    dimension_(mesh->dimension()),
+    number_of_cells_(mesh->number_of_cells())
+{
+    // Get quadrature and basis values for each cell
+    vector<vector<double> > cell_ordinates(number_of_cells_);
+    vector<vector<double> > cell_weights(number_of_cells_);
+    vector<vector<double> > cell_values(number_of_cells_);
+    #pragma omp parallel for schedule(dynamic, 10)
+    for (int i = 0; i < number_of_cells_; ++i)
+    {
+        shared_ptr<Integration_Cell> const cell = mesh->cell(i);
+        int const number_of_basis_functions = cell->number_of_basis_functions;
+
+        // Get quadrature
+        int number_of_ordinates;
+        vector<vector<double> > ordinates;
+        mesh->get_volume_quadrature(i,
+                                    number_of_ordinates,
+                                    ordinates,
+                                    cell_weights[i]);
+
+        // Get center positions
+        vector<vector<double> > basis_centers;
+        mesh->get_basis_centers(cell,
+                                basis_centers);
+
+        // Get basis values at each quadrature point
+        cell_ordinates[i].resize(dimension_ * number_of_ordinates);
+        cell_values[i].resize(number_of_basis_functions * number_of_ordinates);
+        vector<double> b_val;
+        for (int q = 0; q < number_of_ordinates; ++q)
+        {
+            vector<double> const &position = ordinates[q];
+            copy(position.begin(), position.end(), cell_ordinates[i].begin() + dimension_ * q);
+
+            mesh->get_basis_values(cell,
+                                   position,
+                                   basis_centers,
+                                   b_val);
+            copy(b_val.begin(), b_val.end(), cell_values[i].begin() + number_of_basis_functions * q);
+        }
+    }
+
+    // Get offsets
+    ordinate_offsets_.assign(number_of_cells_ + 1, 0);
+    basis_offsets_.assign(number_of_cells_ + 1, 0);
+    value_offsets_.assign(number_of_cells_ + 1, 0);
+    for (int i = 0; i < number_of_cells_; ++i)
+    {
+        ordinate_offsets_[i + 1] = ordinate_offsets_[i] + cell_weights[i].size();
+        basis_offsets_[i + 1] = basis_offsets_[i] + mesh->cell(i)->number_of_basis_functions;
+        value_offsets_[i + 1] = value_offsets_[i] + cell_values[i].size();
+    }
+
+    // Copy data, keeping storage nonempty so that views are always valid pointers
+    int const total_ordinates = ordinate_offsets_[number_of_cells_];
+    basis_function_indices_.resize(max(basis_offsets_[number_of_cells_], 1));
+    ordinates_.resize(max(dimension_ * total_ordinates, 1));
+    weights_.resize(max(total_ordinates, 1));
+    values_.resize(max(value_offsets_[number_of_cells_], 1));
+    volumes_.assign(number_of_cells_, 0.);
+    for (int i = 0; i < number_of_cells_; ++i)
+    {
+        vector<int> const &indices = mesh->cell(i)->basis_indices;
+        Assert(indices.size() == basis_offsets_[i + 1] - basis_offsets_[i]);
+        copy(indices.begin(), indices.end(), basis_function_indices_.begin() + basis_offsets_[i]);
+        copy(cell_ordinates[i].begin(), cell_ordinates[i].end(), ordinates_.begin() + dimension_ * ordinate_offsets_[i]);
+        copy(cell_weights[i].begin(), cell_weights[i].end(), weights_.begin() + ordinate_offsets_[i]);
+        copy(cell_values[i].begin(), cell_values[i].end(), values_.begin() + value_offsets_[i]);
+
+        // Get the volume (sum of weights)
+        for (double weight : cell_weights[i])
+        {
+            volumes_[i] += weight;
+        }
+    }
+}
+
+void Cell_Basis_Values::
+get_values(int i,
+           int number_per_point,
+           vector<double> const &coefficients,
+           vector<double> &values) const
+{
+    View const cell = view(i);
+
+    values.assign(number_per_point * cell.number_of_ordinates, 0.);
+    for (int q = 0; q < cell.number_of_ordinates; ++q)
+    {
+        double *const value = &values[number_per_point * q];
+        for (int j = 0; j < cell.number_of_basis_functions; ++j)
+        {
+            double const b_val = cell.values[j + cell.number_of_basis_functions * q];
+            double const *const coefficient = &coefficients[number_per_point * cell.basis_function_indices[j]];
+
+            for (int l = 0; l < number_per_point; ++l)
+            {
+                value[l] += b_val * coefficient[l];
+            }
+        }
+    }
+}
+
+void Cell_Basis_Values::
+get_averaging_matrix(vector<int> &row_offsets,
+                     vector<int> &column_indices,
+                     vector<double> &values) const
+{
+    // The basis functions of each cell are distinct, so the sparsity pattern
+    // is that of the cell basis function indices
+    row_offsets = basis_offsets_;
+    column_indices.assign(basis_function_indices_.begin(),
+                          basis_function_indices_.begin() + basis_offsets_[number_of_cells_]);
+    values.assign(basis_offsets_[number_of_cells_], 0.);
+
+    #pragma omp parallel for schedule(dynamic, 10)
+    for (int i = 0; i < number_of_cells_; ++i)
+    {
+        View const cell = view(i);
+        double *const average = &values[row_offsets[i]];
+
+        for (int q = 0; q < cell.number_of_ordinates; ++q)
+        {
+            double const mult = cell.weights[q] / cell.volume;
+            for (int j = 0; j < cell.number_of_basis_functions; ++j)
+            {
+                average[j] += mult * cell.values[j + cell.number_of_basis_functions * q];
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef Cell_Basis_Values_hh
+#define Cell_Basis_Values_hh
+
+#include <memory>
+#include <vector>
+
+class Integration_Mesh;
+
+/*
+  Volume quadrature and basis function values of all cells of an integration
+  mesh in contiguous storage
+
+  The quadrature and the (normalized) basis function values only depend on the
+  mesh, so they are computed once here instead of each time an operator that
+  integrates over the mesh is applied. All quadrature points of a cell share
+  the basis functions of the cell, so the values of each cell are a dense
+  matrix indexed as j + number_of_basis_functions * q.
+*/
+class Cell_Basis_Values
+{
+public:
+
+    // Pointers to the quadrature and values of one cell
+    struct View
+    {
+        int number_of_ordinates;
+        int number_of_basis_functions;
+        int const *basis_function_indices;
+        double const *ordinates; // d + dimension * q
+        double const *weights;
+        double const *values; // j + number_of_basis_functions * q
+        double volume;
+    };
+
+    // Constructor
+    Cell_Basis_Values(std::shared_ptr<Integration_Mesh> mesh);
+
+    // Number of dimensions and cells
+    int dimension() const
+    {
+        return dimension_;
+    }
+    int number_of_cells() const
+    {
+        return number_of_cells_;
+    }
+
+    // Get quadrature and values for cell i
+    View view(int i) const
+    {
+        View v;
+        v.number_of_ordinates = ordinate_offsets_[i + 1] - ordinate_offsets_[i];
+        v.number_of_basis_functions = basis_offsets_[i + 1] - basis_offsets_[i];
+        v.basis_function_indices = basis_function_indices_.data() + basis_offsets_[i];
+        v.ordinates = ordinates_.data() + dimension_ * ordinate_offsets_[i];
+        v.weights = weights_.data() + ordinate_offsets_[i];
+        v.values = values_.data() + value_offsets_[i];
+        v.volume = volumes_[i];
+        return v;
+    }
+
+    // Offsets of the quadrature points of each cell
+    std::vector<int> const &ordinate_offsets() const
+    {
+        return ordinate_offsets_;
+    }
+
+    // Get the expansion values at the quadrature points of cell i
+    // Coefficients are indexed as l + number_per_point * global_basis_index
+    // and values as l + number_per_point * q
+    void get_values(int i,
+                    int number_per_point,
+                    std::vector<double> const &coefficients,
+                    std::vector<double> &values) const;
+
+    // Get the sparse matrix that takes the coefficients to the average of the
+    // expansion over each cell, with the quadrature weights and volume included
+    void get_averaging_matrix(std::vector<int> &row_offsets,
+                              std::vector<int> &column_indices,
+                              std::vector<double> &values) const;
+
+private:
+
+    // Data
+    int dimension_;
+    int number_of_cells_;
+    std::vector<int> ordinate_offsets_;
+    std::vector<int> basis_offsets_;
+    std::vector<int> value_offsets_;
+    std::vector<int> basis_function_indices_;
+    std::vector<double> ordinates_;
+    std::vector<double> weights_;
+    std::vector<double> values_;
+    std::vector<double> volumes_;
+};
+
+#endif
@@ -0,0 +1,73 @@
+#include "Integral_Store.hh"
+
+#include "Check.hh"
+
+using namespace std;
+
+namespace // anonymous
+{
+    // Quantities of the integrals in the order of Integral_Store::Quantity
+    vector<double> Weight_Function::Integrals::* const quantities[]
+        = {&Weight_Function::Integrals::is_w,
+           &Weight_Function::Integrals::is_b_w,
+           &Weight_Function::Integrals::iv_w,
+           &Weight_Function::Integrals::iv_dw,
+           &Weight_Function::Integrals::iv_b_w,
+           &Weight_Function::Integrals::iv_b_dw,
+           &Weight_Function::Integrals::iv_db_w,
+           &Weight_Function::Integrals::iv_db_dw};
+}
+
+Integral_Store::
+Integral_Store(vector<shared_ptr<Weight_Function> > const &weights):
+    number_of_points_(weights.size())
+{
+    // Get offsets
+    for (int q = 0; q <= NUMBER_OF_QUANTITIES; ++q)
+    {
+        offsets_[q].assign(number_of_points_ + 1, 0);
+    }
+    for (int i = 0; i < number_of_points_; ++i)
+    {
+        Assert(weights[i]->index() == i);
+        Weight_Function::Integrals const integrals = weights[i]->integrals();
+        offsets_[0][i + 1] = offsets_[0][i] + weights[i]->number_of_basis_functions();
+        for (int q = 0; q < NUMBER_OF_QUANTITIES; ++q)
+        {
+            offsets_[q + 1][i + 1] = offsets_[q + 1][i] + (integrals.*quantities[q]).size();
+        }
+    }
+    
+    // Copy data
+    basis_function_indices_.resize(offsets_[0][number_of_points_]);
+    for (int q = 0; q < NUMBER_OF_QUANTITIES; ++q)
+    {
+        // Keep storage nonempty so that views are always valid pointers
+        data_[q].resize(max(offsets_[q + 1][number_of_points_], 1));
+    }
+    for (int i = 0; i < number_of_points_; ++i)
+    {
+        vector<int> const &indices = weights[i]->basis_function_indices();
+        Assert(indices.size() == offsets_[0][i + 1] - offsets_[0][i]);
+        copy(indices.begin(), indices.end(), basis_function_indices_.begin() + offsets_[0][i]);
+        
+        Weight_Function::Integrals const integrals = weights[i]->integrals();
+        for (int q = 0; q < NUMBER_OF_QUANTITIES; ++q)
+        {
+            vector<double> const &quantity = integrals.*quantities[q];
+            copy(quantity.begin(), quantity.end(), data_[q].begin() + offsets_[q + 1][i]);
+        }
+    }
+}
+
+void Integral_Store::
+get_integrals(int i,
+              Weight_Function::Integrals &integrals) const
+{
+    for (int q = 0; q < NUMBER_OF_QUANTITIES; ++q)
+    {
+        vector<double>::const_iterator const begin = data_[q].begin();
+        (integrals.*quantities[q]).assign(begin + offsets_[q + 1][i],
+                                          begin + offsets_[q + 1][i + 1]);
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef Integral_Store_hh
+#define Integral_Store_hh
+
+#include <memory>
+#include <vector>
+
+#include "Weight_Function.hh"
+
+/*
+  Integrals and basis function indices of all weight functions in contiguous storage
+
+  Each quantity of Weight_Function::Integrals is stored for all weight
+  functions consecutively, in the same order as within each weight function,
+  with offsets giving the start of the data for each weight function.
+  Weight function i must have index i, so the weight functions can release
+  their own copies of the integrals and read them from the store instead.
+*/
+class Integral_Store
+{
+public:
+
+    // Pointers to the integrals of one weight function
+    // Ordering is the same as in Weight_Function::Integrals
+    struct View
+    {
+        int number_of_basis_functions;
+        int const *basis_function_indices;
+        double const *is_w;
+        double const *is_b_w;
+        double const *iv_w;
+        double const *iv_dw;
+        double const *iv_b_w;
+        double const *iv_b_dw;
+        double const *iv_db_w;
+        double const *iv_db_dw;
+    };
+
+    // Constructor
+    Integral_Store(std::vector<std::shared_ptr<Weight_Function> > const &weights);
+
+    // Number of weight functions
+    int number_of_points() const
+    {
+        return number_of_points_;
+    }
+    
+    // Get integrals for weight function i
+    View view(int i) const
+    {
+        View v;
+        v.number_of_basis_functions = offsets_[0][i + 1] - offsets_[0][i];
+        v.basis_function_indices = basis_function_indices_.data() + offsets_[0][i];
+        v.is_w = pointer(IS_W, i);
+        v.is_b_w = pointer(IS_B_W, i);
+        v.iv_w = pointer(IV_W, i);
+        v.iv_dw = pointer(IV_DW, i);
+        v.iv_b_w = pointer(IV_B_W, i);
+        v.iv_b_dw = pointer(IV_B_DW, i);
+        v.iv_db_w = pointer(IV_DB_W, i);
+        v.iv_db_dw = pointer(IV_DB_DW, i);
+        return v;
+    }
+
+    // Copy the integrals of weight function i
+    void get_integrals(int i,
+                       Weight_Function::Integrals &integrals) const;
+    
+    // Offsets of the basis function indices of each weight function
+    std::vector<int> const &basis_offsets() const
+    {
+        return offsets_[0];
+    }
+    
+private:
+
+    // Quantities in order of Weight_Function::Integrals
+    enum Quantity
+    {
+        IS_W = 0,
+        IS_B_W,
+        IV_W,
+        IV_DW,
+        IV_B_W,
+        IV_B_DW,
+        IV_DB_W,
+        IV_DB_DW,
+        NUMBER_OF_QUANTITIES
+    };
+
+    double const *pointer(int q,
+                          int i) const
+    {
+        return data_[q].data() + offsets_[q + 1][i];
+    }
+    
+    // Data
+    int number_of_points_;
+    std::vector<int> basis_function_indices_;
+    std::vector<double> data_[NUMBER_OF_QUANTITIES];
+    std::vector<int> offsets_[NUMBER_OF_QUANTITIES + 1]; // basis indices, then quantities
+};
+
+#endif
@@ -1,6 +1,7 @@
 #include "Simple_Spatial_Discretization.hh"
 
 #include "Dimensional_Moments.hh"
+#include "Material_Table.hh"
 #include "XML_Node.hh"
 
 using std::make_shared;
@@ -29,6 +30,13 @@ Simple_Spatial_Discretization(vector<shared_ptr<Point> > points):
     dimensional_moments_
         = make_shared<Dimensional_Moments>(false, // supg
                                            dimension_);
+
+    vector<shared_ptr<Material> > materials(number_of_points_);
+    for (int i = 0; i < number_of_points_; ++i)
+    {
+        materials[i] = points_[i]->material();
+    }
+    material_table_ = make_shared<Material_Table>(materials);
 }
 
 void Simple_Spatial_Discretization::
@@ -53,6 +61,8 @@ void Simple_Spatial_Discretization::
 check_class_invariants() const
 {
     Assert(points_.size() == number_of_points_);
+    Assert(material_table_);
+    Assert(material_table_->number_of_points() == number_of_points_);
     
     for (int i = 0; i < number_of_points_; ++i)
     {
@@ -39,6 +39,10 @@ public:
     {
         return points_[point_index];
     }
+    virtual std::shared_ptr<Material_Table> material_table() const override
+    {
+        return material_table_;
+    }
 
     virtual void output(XML_Node output_node) const override;
     virtual void check_class_invariants() const override;
@@ -50,6 +54,7 @@ private:
     int number_of_boundary_points_;
     std::shared_ptr<Dimensional_Moments> dimensional_moments_;
     std::vector<std::shared_ptr<Point> > points_;
+    std::shared_ptr<Material_Table> material_table_;
 };
 
 #endif
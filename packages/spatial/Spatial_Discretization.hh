@@ -5,6 +5,7 @@
 #include <vector>
 
 class Dimensional_Moments;
+class Material_Table;
 class Point;
 class XML_Node;
 
@@ -38,6 +39,9 @@ public:
     
     // Return dimensional moments
     virtual std::shared_ptr<Dimensional_Moments> dimensional_moments() const = 0;
+
+    // Return cross sections of all points
+    virtual std::shared_ptr<Material_Table> material_table() const = 0;
     
     // Output data to XML file
     virtual void output(XML_Node output_node) const = 0;
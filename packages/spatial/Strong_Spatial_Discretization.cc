@@ -34,7 +34,13 @@ Strong_Spatial_Discretization(vector<shared_ptr<Basis_Function> > &bases,
         break;
     }
 
+    // Integrals and materials are set by the integration above
+    build_integral_store();
+    build_material_table();
+    
     options_->normalized = true;
+
+    check_class_invariants();
 }
 
 void Strong_Spatial_Discretization::
@@ -6,7 +6,9 @@
 #include "Check.hh"
 #include "Conversion.hh"
 #include "Dimensional_Moments.hh"
+#include "Integral_Store.hh"
 #include "KD_Tree.hh"
+#include "Material_Table.hh"
 #include "Meshless_Function.hh"
 #include "Meshless_Normalization.hh"
 #include "Weight_Function_Integration.hh"
@@ -109,6 +111,25 @@ Weak_Spatial_Discretization(vector<shared_ptr<Basis_Function> > &bases,
         integrator.perform_integration();
         integration_numbers_ = integrator.get_total_max_points();
     }
+
+    // Integrals that are not performed here are replaced by the derived
+    // class, which then rebuilds the store
+    build_integral_store();
+
+    // Materials are only available once the integrals have been performed or
+    // read, so otherwise the derived class builds the table after setting them
+    bool has_materials = true;
+    for (int i = 0; i < number_of_points_; ++i)
+    {
+        if (!weights_[i]->material())
+        {
+            has_materials = false;
+        }
+    }
+    if (has_materials)
+    {
+        build_material_table();
+    }
     
     check_class_invariants();
 }
@@ -150,11 +171,10 @@ double Weak_Spatial_Discretization::
 weighted_collocation_value(int i,
                            vector<double> const &coefficients) const
 {
-    shared_ptr<Weight_Function> weight = weights_[i];
-    Weight_Function::Integrals const integrals = weight->integrals();
-    int number_of_basis_functions = weight->number_of_basis_functions();
-    vector<int> const basis_indices = weight->basis_function_indices();
-    vector<double> const &iv_b_w = integrals.iv_b_w;
+    Integral_Store::View const integrals = integral_store_->view(i);
+    int number_of_basis_functions = integrals.number_of_basis_functions;
+    int const *basis_indices = integrals.basis_function_indices;
+    double const *iv_b_w = integrals.iv_b_w;
     double const iv_w = integrals.iv_w[0];
     
     // Sum over coefficients
@@ -314,6 +334,37 @@ expansion_values(int number_of_groups,
                             coefficients);
 }
 
+void Weak_Spatial_Discretization::
+build_integral_store()
+{
+    // Store integrals contiguously for fast access, releasing the copies in
+    // the weight functions
+    integral_store_ = make_shared<Integral_Store>(weights_);
+    for (int i = 0; i < number_of_points_; ++i)
+    {
+        weights_[i]->set_integral_store(integral_store_);
+    }
+}
+
+void Weak_Spatial_Discretization::
+build_material_table()
+{
+    // Store cross sections contiguously, keeping one copy of identical materials
+    vector<shared_ptr<Material> > materials(number_of_points_);
+    for (int i = 0; i < number_of_points_; ++i)
+    {
+        materials[i] = weights_[i]->material();
+        AssertMsg(materials[i], "weight function " + to_string(i) + " has no material");
+    }
+    material_table_ = make_shared<Material_Table>(materials);
+    
+    // Share the interned materials with the weight functions
+    for (int i = 0; i < number_of_points_; ++i)
+    {
+        weights_[i]->set_material(material_table_->material(i));
+    }
+}
+
 void Weak_Spatial_Discretization::
 check_class_invariants() const
 {
@@ -321,6 +372,16 @@ check_class_invariants() const
     Assert(boundary_weights_.size() == number_of_boundary_weights_);
     Assert(bases_.size() == number_of_points_);
     Assert(boundary_bases_.size() == number_of_boundary_bases_);
+    Assert(integral_store_);
+    Assert(integral_store_->number_of_points() == number_of_points_);
+    if (material_table_)
+    {
+        Assert(material_table_->number_of_points() == number_of_points_);
+        for (int i = 0; i < number_of_points_; ++i)
+        {
+            Assert(material_table_->material(i) == weights_[i]->material());
+        }
+    }
     
     for (int i = 0; i < number_of_points_; ++i)
     {
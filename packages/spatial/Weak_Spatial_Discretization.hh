@@ -5,7 +5,9 @@
 #include "Weight_Function.hh"
 
 class Basis_Function;
+class Integral_Store;
 class KD_Tree;
+class Material_Table;
 
 struct Weak_Spatial_Discretization_Options
 {
@@ -124,6 +126,10 @@ public:
     {
         return dimensional_moments_;
     }
+    virtual std::shared_ptr<Material_Table> material_table() const override
+    {
+        return material_table_;
+    }
     virtual std::shared_ptr<Point> point(int point_index) const override
     {
         return weights_[point_index];
@@ -169,6 +175,12 @@ public:
         return boundary_bases_[boundary_index];
     }
 
+    // Integrals of all weight functions in contiguous storage
+    virtual std::shared_ptr<Integral_Store> integral_store() const
+    {
+        return integral_store_;
+    }
+
     // Functions to get values given expansion coefficients
     
     // Get the nearest weight function to a point: this can be used to find the basis functions applicable to a point
@@ -205,6 +217,14 @@ public:
 
 protected:
 
+    // Move the integrals of the weight functions into the integral store
+    // Called again whenever the integrals of the weight functions are replaced
+    void build_integral_store();
+    
+    // Intern the materials of the weight functions into the material table
+    // Called once all weight functions have materials
+    void build_material_table();
+    
     // Data
     bool has_reflection_;
     bool basis_depends_on_neighbors_;
@@ -222,6 +242,8 @@ protected:
     std::vector<std::shared_ptr<Basis_Function> > boundary_bases_;
     std::shared_ptr<Dimensional_Moments> dimensional_moments_;
     std::shared_ptr<KD_Tree> kd_tree_;
+    std::shared_ptr<Integral_Store> integral_store_;
+    std::shared_ptr<Material_Table> material_table_;
     std::vector<int> integration_numbers_;
 };
 
@@ -12,6 +12,7 @@
 #include "Cross_Section.hh"
 #include "Dimensional_Moments.hh"
 #include "Energy_Discretization.hh"
+#include "Integral_Store.hh"
 #include "Material.hh"
 #include "Meshless_Function.hh"
 #include "Quadrature_Rule.hh"
@@ -1331,14 +1332,21 @@ check_class_invariants() const
     Assert(max_boundary_limits_.size() == dimension_);
     Assert(values_.v_b.size() == number_of_basis_functions_);
     Assert(values_.v_db.size() == number_of_basis_functions_ * dimension_);
-    Assert(integrals_.is_w.size() == number_of_boundary_surfaces_);
-    Assert(integrals_.is_b_w.size() == number_of_boundary_surfaces_ * number_of_basis_functions_);
-    Assert(integrals_.iv_w.size() == 1);
-    Assert(integrals_.iv_dw.size() == dimension_);
-    Assert(integrals_.iv_b_w.size() == number_of_basis_functions_);
-    Assert(integrals_.iv_b_dw.size() == number_of_basis_functions_ * dimension_);
-    Assert(integrals_.iv_db_w.size() == number_of_basis_functions_ * dimension_);
-    Assert(integrals_.iv_db_dw.size() == number_of_basis_functions_ * dimension_ * dimension_);
+    if (integral_store_)
+    {
+        Assert(integral_store_->view(index_).number_of_basis_functions == number_of_basis_functions_);
+    }
+    else
+    {
+        Assert(integrals_.is_w.size() == number_of_boundary_surfaces_);
+        Assert(integrals_.is_b_w.size() == number_of_boundary_surfaces_ * number_of_basis_functions_);
+        Assert(integrals_.iv_w.size() == 1);
+        Assert(integrals_.iv_dw.size() == dimension_);
+        Assert(integrals_.iv_b_w.size() == number_of_basis_functions_);
+        Assert(integrals_.iv_b_dw.size() == number_of_basis_functions_ * dimension_);
+        Assert(integrals_.iv_db_w.size() == number_of_basis_functions_ * dimension_);
+        Assert(integrals_.iv_db_dw.size() == number_of_basis_functions_ * dimension_ * dimension_);
+    }
 }
 
 void Weight_Function::
@@ -1377,14 +1385,15 @@ output(XML_Node output_node) const
 
     if (options_->output_integrals)
     {
-        output_node.set_child_vector(integrals_.is_w, "is_w", "surface");
-        output_node.set_child_vector(integrals_.is_b_w, "is_b_w", "surface-basis");
-        output_node.set_child_vector(integrals_.iv_w, "iv_w");
-        output_node.set_child_vector(integrals_.iv_dw, "iv_dw", "dimension");
-        output_node.set_child_vector(integrals_.iv_b_w, "iv_b_w", "basis");
-        output_node.set_child_vector(integrals_.iv_b_dw, "iv_b_dw", "dimension-basis");
-        output_node.set_child_vector(integrals_.iv_db_w, "iv_db_w", "dimension-basis");
-        output_node.set_child_vector(integrals_.iv_db_dw, "iv_db_dw", "dimension-dimension-basis");
+        Integrals const integrals = this->integrals();
+        output_node.set_child_vector(integrals.is_w, "is_w", "surface");
+        output_node.set_child_vector(integrals.is_b_w, "is_b_w", "surface-basis");
+        output_node.set_child_vector(integrals.iv_w, "iv_w");
+        output_node.set_child_vector(integrals.iv_dw, "iv_dw", "dimension");
+        output_node.set_child_vector(integrals.iv_b_w, "iv_b_w", "basis");
+        output_node.set_child_vector(integrals.iv_b_dw, "iv_b_dw", "dimension-basis");
+        output_node.set_child_vector(integrals.iv_db_w, "iv_db_w", "dimension-basis");
+        output_node.set_child_vector(integrals.iv_db_dw, "iv_db_dw", "dimension-dimension-basis");
     }
 }
 
@@ -1393,8 +1402,9 @@ set_integrals(Weight_Function::Integrals const &integrals,
               shared_ptr<Material> material,
               vector<shared_ptr<Boundary_Source> > boundary_sources)
 {
-    // Set integral data
+    // Set integral data, replacing any previously stored integrals
     integrals_ = integrals;
+    integral_store_.reset();
     material_ = material;
     boundary_sources_ = boundary_sources;
     
@@ -1402,6 +1412,38 @@ set_integrals(Weight_Function::Integrals const &integrals,
     check_class_invariants();
 }
 
+Weight_Function::Integrals Weight_Function::
+integrals() const
+{
+    if (!integral_store_)
+    {
+        return integrals_;
+    }
+    
+    Integrals integrals;
+    integral_store_->get_integrals(index_,
+                                   integrals);
+    return integrals;
+}
+
+void Weight_Function::
+set_integral_store(shared_ptr<Integral_Store> integral_store)
+{
+    Assert(integral_store);
+    Assert(integral_store->view(index_).number_of_basis_functions == number_of_basis_functions_);
+    
+    integral_store_ = integral_store;
+    integrals_ = Integrals();
+}
+
+void Weight_Function::
+set_material(shared_ptr<Material> material)
+{
+    Assert(material);
+    
+    material_ = material;
+}
+
 int Weight_Function::
 local_basis_index(int global_index) const
 {
@@ -11,6 +11,7 @@ class Boundary_Source;
 class Cartesian_Plane;
 template<class T1, class T2> class Conversion;
 class Dimensional_Moments;
+class Integral_Store;
 class Meshless_Function;
 class Solid_Geometry;
 struct Weak_Spatial_Discretization_Options;
@@ -161,10 +162,8 @@ public:
     }
 
     // Get values or integrals
-    virtual Integrals const &integrals() const
-    {
-        return integrals_;
-    };
+    // Once released to an Integral_Store, the integrals are copied from it
+    virtual Integrals integrals() const;
     virtual Values const &values() const
     {
         return values_;
@@ -188,6 +187,13 @@ public:
     virtual void set_integrals(Weight_Function::Integrals const &integrals,
                                std::shared_ptr<Material> material,
                                std::vector<std::shared_ptr<Boundary_Source>> boundary_sources);
+
+    // Replace the material by an equivalent one, such as a shared copy
+    virtual void set_material(std::shared_ptr<Material> material);
+
+    // Release the integrals, which are then read from the store
+    // The store must have been created from this weight function
+    virtual void set_integral_store(std::shared_ptr<Integral_Store> integral_store);
     
     // Get local basis function index from from global basis function index
     // Returns Errors::DOES_NOT_EXIST if none found
@@ -260,6 +266,7 @@ private:
 
     // Values and integrals of data
     Integrals integrals_;
+    std::shared_ptr<Integral_Store> integral_store_;
     Values values_;
 };
 
@@ -19,6 +19,7 @@
 #include "Energy_Discretization.hh"
 #include "Material.hh"
 #include "Meshless_Function.hh"
+#include "Mixed_Cross_Section.hh"
 #include "Solid_Geometry.hh"
 #include "Weak_Spatial_Discretization.hh"
 #include "Weight_Function.hh"
@@ -115,6 +116,12 @@ perform_integration()
         
         // Normalize materials
         normalize_materials(materials);
+
+        // Get cross sections shared between mixtures
+        #pragma omp single
+        {
+            get_mixture_components(materials);
+        }
         
         // Put results into weight functions and materials
         put_integrals_into_weight(integrals,
@@ -187,6 +194,88 @@ add_material_sets(vector<Material_Data> const &local_materials,
                             material.norm);
         add_vector_to_total(local_material.boundary_sources,
                             material.boundary_sources);
+        add_mixture_to_total(local_material,
+                             material);
+    }
+}
+
+void Weight_Function_Integration::
+add_mixture_to_total(Material_Data const &local_material,
+                     Material_Data &material) const
+{
+    int number_of_components = local_material.mixture_materials.size();
+    if (number_of_components == 0)
+    {
+        return;
+    }
+    int number_of_coefficients = local_material.mixture_coefficients.size() / number_of_components;
+    
+    for (int r = 0; r < number_of_components; ++r)
+    {
+        int index = get_mixture_index(local_material.mixture_materials[r],
+                                      number_of_coefficients,
+                                      material);
+        
+        for (int k = 0; k < number_of_coefficients; ++k)
+        {
+            material.mixture_coefficients[k + number_of_coefficients * index]
+                += local_material.mixture_coefficients[k + number_of_coefficients * r];
+        }
+    }
+}
+
+int Weight_Function_Integration::
+get_mixture_index(shared_ptr<Material> point_material,
+                  int number_of_coefficients,
+                  Material_Data &material) const
+{
+    // Regions are few, so a linear search is sufficient
+    int number_of_components = material.mixture_materials.size();
+    for (int r = 0; r < number_of_components; ++r)
+    {
+        if (material.mixture_materials[r] == point_material)
+        {
+            return r;
+        }
+    }
+    
+    material.mixture_materials.push_back(point_material);
+    material.mixture_coefficients.resize(number_of_coefficients * (number_of_components + 1), 0.);
+    return number_of_components;
+}
+
+void Weight_Function_Integration::
+get_mixture_components(vector<Material_Data> const &materials)
+{
+    if (options_->weighting != Weak_Spatial_Discretization_Options::Weighting::FULL)
+    {
+        return;
+    }
+    
+    Cross_Section::Dependencies sigma_f_deps;
+    sigma_f_deps.energy = Cross_Section::Dependencies::Energy::GROUP_TO_GROUP;
+    for (Material_Data const &material : materials)
+    {
+        for (shared_ptr<Material> region_material : material.mixture_materials)
+        {
+            if (fission_components_.count(region_material.get()) == 0)
+            {
+                vector<double> sigma_t;
+                vector<double> sigma_s;
+                vector<double> sigma_f;
+                vector<double> internal_source;
+                get_cross_sections(region_material,
+                                   sigma_t,
+                                   sigma_s,
+                                   sigma_f,
+                                   internal_source);
+                fission_components_[region_material.get()]
+                    = make_shared<Cross_Section>(sigma_f_deps,
+                                                 angular_,
+                                                 energy_,
+                                                 sigma_f);
+            }
+        }
     }
 }
 
@@ -636,6 +725,12 @@ add_volume_material(shared_ptr<Integration_Cell> const cell,
             // Get weight function data
             int w_ind = cell->weight_indices[i];
             Material_Data &material = materials[w_ind];
+            int number_of_basis_functions = weights_[w_ind]->number_of_basis_functions();
+
+            // Scattering and fission are stored as a mixture of region materials
+            int r = get_mixture_index(point_material,
+                                      number_of_dimensional_moments * number_of_basis_functions,
+                                      material);
         
             for (int d = 0; d < number_of_dimensional_moments; ++d)
             {
@@ -664,19 +759,9 @@ add_volume_material(shared_ptr<Integration_Cell> const cell,
                             material.sigma_t[k] += sigma_t[s] * b_val[j] * wid * quad_weight;
                         }
 
-                        // Fission cross section
-                        for (int s = 0; s < sigma_f_size; ++s)
-                        {
-                            int k = d + number_of_dimensional_moments * (s + sigma_f_size * w_b_ind);
-                            material.sigma_f[k] += sigma_f[s] * b_val[j] * wid * quad_weight;
-                        }
-
-                        // Scattering cross section
-                        for (int s = 0; s < sigma_s_size; ++s)
-                        {
-                            int k = d + number_of_dimensional_moments * (s + sigma_s_size * w_b_ind);
-                            material.sigma_s[k] += sigma_s[s] * b_val[j] * wid * quad_weight;
-                        }
+                        // Mixing coefficient for scattering and fission
+                        int k = d + number_of_dimensional_moments * (w_b_ind + number_of_basis_functions * r);
+                        material.mixture_coefficients[k] += b_val[j] * wid * quad_weight;
                     }
                 }
             }
@@ -1052,21 +1137,47 @@ get_material(int index,
                                      angular_,
                                      energy_,
                                      material_data.sigma_t);
-    shared_ptr<Cross_Section> sigma_s
-        = make_shared<Cross_Section>(sigma_s_deps,
-                                     angular_,
-                                     energy_,
-                                     material_data.sigma_s);
+    shared_ptr<Cross_Section> sigma_s;
+    shared_ptr<Cross_Section> sigma_f;
+    if (options_->weighting == Weak_Spatial_Discretization_Options::Weighting::FULL)
+    {
+        // Share the region cross sections between weight functions
+        int number_of_components = material_data.mixture_materials.size();
+        vector<shared_ptr<Cross_Section> > sigma_s_components(number_of_components);
+        vector<shared_ptr<Cross_Section> > sigma_f_components(number_of_components);
+        for (int r = 0; r < number_of_components; ++r)
+        {
+            shared_ptr<Material> region_material = material_data.mixture_materials[r];
+            sigma_s_components[r] = region_material->sigma_s();
+            sigma_f_components[r] = fission_components_.at(region_material.get());
+        }
+        sigma_s = make_shared<Mixed_Cross_Section>(sigma_s_deps,
+                                                   angular_,
+                                                   energy_,
+                                                   sigma_s_components,
+                                                   material_data.mixture_coefficients);
+        sigma_f = make_shared<Mixed_Cross_Section>(sigma_f_deps,
+                                                   angular_,
+                                                   energy_,
+                                                   sigma_f_components,
+                                                   material_data.mixture_coefficients);
+    }
+    else
+    {
+        sigma_s = make_shared<Cross_Section>(sigma_s_deps,
+                                             angular_,
+                                             energy_,
+                                             material_data.sigma_s);
+        sigma_f = make_shared<Cross_Section>(sigma_f_deps,
+                                             angular_,
+                                             energy_,
+                                             material_data.sigma_f);
+    }
     shared_ptr<Cross_Section> nu
         = make_shared<Cross_Section>(nu_deps,
                                      angular_,
                                      energy_,
                                      material_data.nu);
-    shared_ptr<Cross_Section> sigma_f
-        = make_shared<Cross_Section>(sigma_f_deps,
-                                     angular_,
-                                     energy_,
-                                     material_data.sigma_f);
     shared_ptr<Cross_Section> chi
         = make_shared<Cross_Section>(chi_deps,
                                      angular_,
@@ -1180,15 +1291,9 @@ initialize_materials(vector<Material_Data> &materials) const
             material.sigma_t.assign(number_of_basis_functions
                                     * number_of_dimensional_moments
                                     * number_of_groups, 0.);
-            material.sigma_s.assign(number_of_basis_functions
-                                    * number_of_dimensional_moments
-                                    * number_of_groups
-                                    * number_of_groups
-                                    * number_of_scattering_moments, 0.);
-            material.sigma_f.assign(number_of_basis_functions
-                                    * number_of_dimensional_moments
-                                    * number_of_groups
-                                    * number_of_groups, 0.);
+            // Scattering and fission are added to the mixture as regions are found
+            material.sigma_s.clear();
+            material.sigma_f.clear();
             material.norm.assign(number_of_dimensional_moments, 1.);
             break;
         case Weak_Spatial_Discretization_Options::Weighting::BASIS:
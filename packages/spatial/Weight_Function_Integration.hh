@@ -1,6 +1,7 @@
 #ifndef Weight_Function_Integration_hh
 #define Weight_Function_Integration_hh
 
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -9,6 +10,7 @@
 
 class Angular_Discretization;
 class Basis_Function;
+class Cross_Section;
 class Energy_Discretization;
 class Material;
 class Weak_Spatial_Discretization_Options;
@@ -28,6 +30,10 @@ public:
         std::vector<double> internal_source;
         std::vector<double> norm;
         std::vector<double> boundary_sources;
+
+        // Region materials and mixing coefficients for full weighting
+        std::vector<std::shared_ptr<Material> > mixture_materials;
+        std::vector<double> mixture_coefficients;
     };
     
     Weight_Function_Integration(int number_of_points,
@@ -92,6 +98,18 @@ private:
     // Add local materials to global materials (for parallel)
     void add_material_sets(std::vector<Material_Data> const &local_materials,
                            std::vector<Material_Data> &materials);
+
+    // Add local mixture coefficients to global mixture coefficients
+    void add_mixture_to_total(Material_Data const &local_material,
+                              Material_Data &material) const;
+
+    // Get the index of a region material in the mixture, adding it if needed
+    int get_mixture_index(std::shared_ptr<Material> point_material,
+                          int number_of_coefficients,
+                          Material_Data &material) const;
+
+    // Get the fission cross sections shared by the mixtures
+    void get_mixture_components(std::vector<Material_Data> const &materials);
     
     // Perform all surface integrals
     void perform_surface_integration(std::vector<Weight_Function::Integrals> &integrals,
@@ -159,6 +177,9 @@ private:
     std::shared_ptr<Angular_Discretization> angular_;
     std::shared_ptr<Energy_Discretization> energy_;
     std::shared_ptr<Integration_Mesh> mesh_;
+
+    // Group-to-group fission cross section of each region material
+    std::map<Material const *, std::shared_ptr<Cross_Section> > fission_components_;
 };
     
 #endif
@@ -17,6 +17,24 @@ public:
     // Constructor
     Boundary_Source_Toggle(bool local_include_boundary_source,
                            std::shared_ptr<Sweep_Operator> sweep);
+
+    // Group restriction is held by the wrapped sweep
+    virtual int active_group() const override
+    {
+        return sweep_->active_group();
+    }
+    virtual void set_active_group(int group) override
+    {
+        sweep_->set_active_group(group);
+    }
+    virtual void set_inner_tolerance(double tolerance) override
+    {
+        sweep_->set_inner_tolerance(tolerance);
+    }
+    virtual void reset_inner_tolerance() override
+    {
+        sweep_->reset_inner_tolerance();
+    }
     
     // Data
     virtual std::shared_ptr<Spatial_Discretization> spatial_discretization() const override
@@ -1,5 +1,8 @@
 #include "Meshless_Sweep.hh"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #if defined(ENABLE_OPENMP)
     #include <omp.h>
@@ -19,6 +22,7 @@
 #include "Epetra_Map.h"
 #include "Epetra_MpiComm.h"
 #include "Epetra_MultiVector.h"
+#include "Epetra_Operator.h"
 #include "Epetra_SerialComm.h"
 #include "Epetra_Vector.h"
 #include "Ifpack.h"
@@ -34,12 +38,16 @@
 #include "Conversion.hh"
 #include "Cross_Section.hh"
 #include "Dimensional_Moments.hh"
+#include "Eigen_Dense_Solver.hh"
+#include "Eigen_Sparse_Solver.hh"
 #include "Energy_Discretization.hh"
 #include "Material.hh"
 #include "Transport_Discretization.hh"
 #include "XML_Node.hh"
 
 using std::make_shared;
+using std::max;
+using std::min;
 using std::pair;
 using std::shared_ptr;
 using std::string;
@@ -54,6 +62,7 @@ Meshless_Sweep(Options options,
     Sweep_Operator(Sweep_Type::ORDINATE,
                    transport_discretization),
     options_(options),
+    inner_tolerance_(options.tolerance),
     spatial_discretization_(spatial_discretization),
     angular_discretization_(angular_discretization),
     energy_discretization_(energy_discretization)
@@ -89,6 +98,15 @@ initialize_solver()
     case Options::Solver::BELOS_IFPACK_RIGHT2:
         solver_ = make_shared<Belos_Ifpack_Right2_Solver>(*this);
         break;
+    case Options::Solver::BELOS_MATRIX_FREE:
+        solver_ = make_shared<Belos_Matrix_Free_Solver>(*this);
+        break;
+    case Options::Solver::EIGEN_SPARSE_LU:
+        solver_ = make_shared<Eigen_Solver>(*this);
+        break;
+    case Options::Solver::UPWIND:
+        solver_ = make_shared<Upwind_Solver>(*this);
+        break;
     }
 }
 
@@ -133,11 +151,41 @@ update_augments(vector<double> &x) const
     }
 }
 
+void Meshless_Sweep::
+get_matrix_components(Matrix_Components &components) const
+{
+    AssertMsg(false, "matrix components not available for " + description());
+}
+
+void Meshless_Sweep::
+get_matrix_coefficients(int o,
+                        int g,
+                        Matrix_Coefficients &coefficients) const
+{
+    AssertMsg(false, "matrix components not available for " + description());
+}
+
+void Meshless_Sweep::
+set_inner_tolerance(double tolerance)
+{
+    inner_tolerance_ = tolerance;
+    solver_->update_tolerance();
+}
+
+void Meshless_Sweep::
+reset_inner_tolerance()
+{
+    set_inner_tolerance(options_.tolerance);
+}
+
 void Meshless_Sweep::
 output(XML_Node output_node) const
 {
     output_node.set_attribute(options_.solver_conversion()->convert(options_.solver),
                               "solver");
+    output_node.set_attribute(options_.tolerance,
+                              "tolerance");
+    solver_->output(output_node);
 }
 
 void Meshless_Sweep::
@@ -178,12 +226,185 @@ Meshless_Sweep::Sweep_Solver::
 Sweep_Solver(Meshless_Sweep const &wrs):
     wrs_(wrs)
 {
+    int number_of_groups = wrs_.energy_discretization_->number_of_groups();
+    int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
+    int number_of_tasks = number_of_groups * number_of_ordinates;
+    
+    // Get the direction-independent matrix components once for all o and g
+    if (wrs_.options_.decompose_matrix && wrs_.has_matrix_components())
+    {
+        components_ = make_shared<Matrix_Components>();
+        wrs_.get_matrix_components(*components_);
+    }
+
+    // Initialize task order
+    task_order_.resize(number_of_tasks);
+    for (int k = 0; k < number_of_tasks; ++k)
+    {
+        task_order_[k] = k;
+    }
+    task_time_.assign(number_of_tasks, 0.);
+}
+
+void Meshless_Sweep::Sweep_Solver::
+schedule(Task const &task,
+         bool parallel) const
+{
+    int number_of_groups = wrs_.energy_discretization_->number_of_groups();
+    int number_of_tasks = task_order_.size();
+    
+    // Start the most expensive tasks first so that they do not finish last
+    std::stable_sort(task_order_.begin(), task_order_.end(),
+                     [&](int k1, int k2)
+                     {
+                         return task_time_[k1] > task_time_[k2];
+                     });
+    
+    #pragma omp parallel if (parallel)
+    {
+        int t = omp_get_thread_num();
+        
+        #pragma omp for schedule(dynamic, 1)
+        for (int i = 0; i < number_of_tasks; ++i)
+        {
+            int k = task_order_[i];
+            int g = k % number_of_groups;
+            int o = k / number_of_groups;
+            if (!group_active(g))
+            {
+                continue;
+            }
+            
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            task(o, g, t);
+            std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+            task_time_[k] = time.count();
+        }
+    }
+}
+
+bool Meshless_Sweep::Sweep_Solver::
+group_active(int g) const
+{
+    int const active_group = wrs_.active_group();
+    return active_group < 0 || g == active_group;
+}
+
+void Meshless_Sweep::Sweep_Solver::
+output(XML_Node output_node) const
+{
+}
+
+void Meshless_Sweep::Sweep_Solver::
+get_matrix_pattern(vector<int> &row_offsets,
+                   vector<int> &column_indices) const
+{
+    if (components_)
+    {
+        row_offsets = components_->row_offsets;
+        column_indices = components_->column_indices;
+        return;
+    }
+    
+    int const number_of_points = wrs_.spatial_discretization_->number_of_points();
+    row_offsets.resize(number_of_points + 1);
+    row_offsets[0] = 0;
+    column_indices.clear();
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        vector<int> const &basis_indices = wrs_.spatial_discretization_->weight(i)->basis_function_indices();
+        column_indices.insert(column_indices.end(), basis_indices.begin(), basis_indices.end());
+        row_offsets[i + 1] = column_indices.size();
+    }
+}
+
+void Meshless_Sweep::Sweep_Solver::
+get_matrix_values(int o,
+                  int g,
+                  vector<double> &values) const
+{
+    // Get values one row at a time if the components are not available
+    if (!components_)
+    {
+        vector<int> indices;
+        vector<double> row_values;
+        int const number_of_points = wrs_.spatial_discretization_->number_of_points();
+        values.clear();
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            wrs_.get_matrix_row(i,
+                                o,
+                                g,
+                                indices,
+                                row_values);
+            values.insert(values.end(), row_values.begin(), row_values.end());
+        }
+        return;
+    }
+    
+    // Get coefficients for this ordinate and group
+    Matrix_Coefficients coefficients;
+    wrs_.get_matrix_coefficients(o,
+                                 g,
+                                 coefficients);
+    
+    // Get data
+    int const number_of_points = wrs_.spatial_discretization_->number_of_points();
+    int const number_of_entries = components_->column_indices.size();
+    int const number_of_terms = coefficients.components.size();
+    int const number_of_scaled_terms = coefficients.scaled_components.size();
+    vector<int> const &row_offsets = components_->row_offsets;
+    double const *const component_values = &components_->values[0];
+    Check(number_of_scaled_terms == 0
+          || coefficients.row_scaling.size() == number_of_points);
+    
+    // Form the linear combination one row at a time so the row stays in cache
+    values.assign(number_of_entries, 0);
+    double *const row_values = &values[0];
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        int const k_begin = row_offsets[i];
+        int const k_end = row_offsets[i + 1];
+        
+        // Add unscaled components
+        for (int t = 0; t < number_of_terms; ++t)
+        {
+            double const a = coefficients.coefficients[t];
+            double const *const component = component_values + number_of_entries * coefficients.components[t];
+            for (int k = k_begin; k < k_end; ++k)
+            {
+                row_values[k] += a * component[k];
+            }
+        }
+        
+        // Add components scaled by the row value
+        if (number_of_scaled_terms > 0)
+        {
+            double const r = coefficients.row_scaling[i];
+            for (int t = 0; t < number_of_scaled_terms; ++t)
+            {
+                double const b = r * coefficients.scaled_coefficients[t];
+                double const *const component = component_values + number_of_entries * coefficients.scaled_components[t];
+                for (int k = k_begin; k < k_end; ++k)
+                {
+                    row_values[k] += b * component[k];
+                }
+            }
+        }
+    }
 }
 
 Meshless_Sweep::Trilinos_Solver::
 Trilinos_Solver(Meshless_Sweep const &wrs):
     Sweep_Solver(wrs)
 {
+    if (wrs_.options_.warm_start)
+    {
+        int number_of_points = wrs_.spatial_discretization_->number_of_points();
+        int number_of_groups = wrs_.energy_discretization_->number_of_groups();
+        int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
+        initial_guess_.assign(number_of_points * number_of_groups * number_of_ordinates, 1.0);
+    }
 }
 
 shared_ptr<Epetra_CrsMatrix> Meshless_Sweep::Trilinos_Solver::
@@ -192,26 +413,47 @@ get_matrix(int o,
            shared_ptr<Epetra_Map> map) const
 {
     int number_of_points = wrs_.spatial_discretization_->number_of_points();
-    vector<int> const number_of_basis_functions = wrs_.spatial_discretization_->number_of_basis_functions();
+    vector<int> const &number_of_basis_functions = wrs_.spatial_discretization_->number_of_basis_functions();
     
     shared_ptr<Epetra_CrsMatrix> mat
         = make_shared<Epetra_CrsMatrix>(Copy, // Data access
                                         *map,
                                         &number_of_basis_functions[0], // Num entries per row
                                         true); // Static profile
-    for (int i = 0; i < number_of_points; ++i)
+    if (components_)
+    {
+        // Combine components, which share the column indices
+        vector<int> const &row_offsets = components_->row_offsets;
+        vector<int> const &column_indices = components_->column_indices;
+        vector<double> values;
+        get_matrix_values(o,
+                          g,
+                          values);
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            int const k = row_offsets[i];
+            mat->InsertGlobalValues(i, // Row
+                                    number_of_basis_functions[i], // Num entries
+                                    &values[k],
+                                    &column_indices[k]);
+        }
+    }
+    else
     {
         vector<int> indices;
         vector<double> values;
-        wrs_.get_matrix_row(i,
-                            o,
-                            g,
-                            indices,
-                            values);
-        mat->InsertGlobalValues(i, // Row
-                                number_of_basis_functions[i], // Num entries
-                                &values[0],
-                                &indices[0]);
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            wrs_.get_matrix_row(i,
+                                o,
+                                g,
+                                indices,
+                                values);
+            mat->InsertGlobalValues(i, // Row
+                                    number_of_basis_functions[i], // Num entries
+                                    &values[0],
+                                    &indices[0]);
+        }
     }
     mat->FillComplete();
     mat->OptimizeStorage();
@@ -255,8 +497,6 @@ set_rhs(int o,
         vector<double> const &x) const
 {
     int number_of_points = wrs_.spatial_discretization_->number_of_points();
-    int number_of_groups = wrs_.energy_discretization_->number_of_groups();
-    int k = g + number_of_groups * o;
     for (int i = 0; i < number_of_points; ++i)
     {
         double value;
@@ -270,6 +510,66 @@ set_rhs(int o,
     }
 }
 
+bool Meshless_Sweep::Trilinos_Solver::
+set_lhs(int o,
+        int g,
+        shared_ptr<Epetra_Vector> const &rhs,
+        shared_ptr<Epetra_Vector> &lhs) const
+{
+    // Initialize LHS to 1.0 to avoid implicit residual problems
+    if (!wrs_.options_.warm_start)
+    {
+        lhs->PutScalar(1.0);
+        return false;
+    }
+
+    // The convergence test is scaled by the RHS norm, so a zero RHS
+    // must be handled here rather than by the solver
+    double rhs_norm;
+    rhs->NormInf(&rhs_norm);
+    if (rhs_norm == 0)
+    {
+        lhs->PutScalar(0.0);
+        return true;
+    }
+    
+    int number_of_points = wrs_.spatial_discretization_->number_of_points();
+    int number_of_groups = wrs_.energy_discretization_->number_of_groups();
+    int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        int k_x = g + number_of_groups * (o + number_of_ordinates * i);
+        (*lhs)[i] = initial_guess_[k_x];
+    }
+    return false;
+}
+
+void Meshless_Sweep::Trilinos_Solver::
+set_solution(int o,
+             int g,
+             shared_ptr<Epetra_Vector> const &lhs,
+             vector<double> &x) const
+{
+    int number_of_points = wrs_.spatial_discretization_->number_of_points();
+    int number_of_groups = wrs_.energy_discretization_->number_of_groups();
+    int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        int k_x = g + number_of_groups * (o + number_of_ordinates * i);
+        x[k_x] = (*lhs)[i];
+    }
+    
+    // Store solution for next initial guess
+    if (wrs_.options_.warm_start)
+    {
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            int k_x = g + number_of_groups * (o + number_of_ordinates * i);
+            initial_guess_[k_x] = (*lhs)[i];
+        }
+    }
+}
+
 void Meshless_Sweep::Trilinos_Solver::
 check_aztec_convergence(shared_ptr<AztecOO> const solver) const
 {
@@ -315,6 +615,21 @@ check_aztec_convergence(shared_ptr<AztecOO> const solver) const
     }
 }
 
+void Meshless_Sweep::Trilinos_Solver::
+set_belos_tolerance(vector<shared_ptr<BelosSolver> > const &solvers) const
+{
+    shared_ptr<Teuchos::ParameterList> belos_list
+        = make_shared<Teuchos::ParameterList>();
+    belos_list->set("Convergence Tolerance", wrs_.inner_tolerance_);
+    for (shared_ptr<BelosSolver> const &solver : solvers)
+    {
+        if (solver)
+        {
+            solver->setParameters(Teuchos::rcp(belos_list));
+        }
+    }
+}
+
 Meshless_Sweep::Amesos_Solver::
 Amesos_Solver(Meshless_Sweep const &wrs):
     Trilinos_Solver(wrs)
@@ -327,11 +642,13 @@ Amesos_Solver(Meshless_Sweep const &wrs):
     comm_ = make_shared<Epetra_SerialComm>();
     map_ = make_shared<Epetra_Map>(number_of_points, 0, *comm_);
     
-    // Initialize matrices and vectors
+    // Initialize vectors
     lhs_ = make_shared<Epetra_Vector>(*map_);
     rhs_ = make_shared<Epetra_Vector>(*map_);
     lhs_->PutScalar(1.0);
     rhs_->PutScalar(1.0);
+    
+    // Initialize matrices
     mat_.resize(number_of_groups * number_of_ordinates);
     problem_.resize(number_of_groups * number_of_ordinates);
     solver_.resize(number_of_groups * number_of_ordinates);
@@ -368,9 +685,8 @@ solve(vector<double> &x) const
     int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
 
     // Solve independently for each ordinate and group
-    for (int o = 0; o < number_of_ordinates; ++o)
-    {
-        for (int g = 0; g < number_of_groups; ++g)
+    Task task
+        = [&](int o, int g, int t)
         {
             int k = g + number_of_groups * o;
                 
@@ -389,8 +705,9 @@ solve(vector<double> &x) const
                 int k_x = g + number_of_groups * (o + number_of_ordinates * i);
                 x[k_x] = (*lhs_)[i];
             }
-        }
-    }
+        };
+    schedule(task,
+             false); // the factorizations share one map and vectors
 }
 
 Meshless_Sweep::Amesos_Parallel_Solver::
@@ -449,30 +766,28 @@ solve(vector<double> &x) const
     int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
 
     // Solve independently for each ordinate and group
-    #pragma omp parallel for schedule(dynamic, 1)
-    for (int o = 0; o < number_of_ordinates; ++o)
-    {
-        for (int g = 0; g < number_of_groups; ++g)
+    Task task
+        = [&](int o, int g, int t)
         {
             int k = g + number_of_groups * o;
-                
+
             // Set current RHS value
             set_rhs(o,
                     g,
                     rhs_[k],
                     x);
-                
+
             // Solve, putting result into LHS
             AssertMsg(solver_[k]->Solve() == 0, "Amesos solver failed to solve");
-            
+
             // Update solution value (overwrite x for this o and g)
             for (int i = 0; i < number_of_points; ++i)
             {
                 int k_x = g + number_of_groups * (o + number_of_ordinates * i);
                 x[k_x] = (*lhs_[k])[i];
             }
-        }
-    }
+        };
+    schedule(task);
 }
 
 Meshless_Sweep::Aztec_Solver::
@@ -491,14 +806,9 @@ Aztec_Solver(Meshless_Sweep const &wrs):
 void Meshless_Sweep::Aztec_Solver::
 solve(vector<double> &x) const
 {
-    int number_of_points = wrs_.spatial_discretization_->number_of_points();
-    int number_of_groups = wrs_.energy_discretization_->number_of_groups();
-    int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
-
     // Solve independently for each ordinate and group
-    for (int o = 0; o < number_of_ordinates; ++o)
-    {
-        for (int g = 0; g < number_of_groups; ++g)
+    Task task
+        = [&](int o, int g, int t)
         {
             // Set current RHS value
             set_rhs(o,
@@ -506,48 +816,61 @@ solve(vector<double> &x) const
                     rhs_,
                     x);
 
-            // Get matrix
-            std::shared_ptr<Epetra_CrsMatrix> mat = get_matrix(o,
-                                                               g,
-                                                               map_);
+            // Set initial guess for LHS
+            bool const solved = set_lhs(o,
+                                        g,
+                                        rhs_,
+                                        lhs_);
 
-            // Get linear problem
-            int k = g + number_of_groups * o;
-            std::shared_ptr<Epetra_LinearProblem> problem
-                = make_shared<Epetra_LinearProblem>(mat.get(),
-                                                    lhs_.get(),
-                                                    rhs_.get());
-            
-            // Get solver
-            shared_ptr<AztecOO> solver
-                = make_shared<AztecOO>(*problem);
-            solver->SetAztecOption(AZ_solver, AZ_gmres);
-            solver->SetAztecOption(AZ_kspace, wrs_.options_.kspace);
-            solver->SetAztecOption(AZ_precond, AZ_none);
-            if (wrs_.options_.print)
-            {
-                solver->SetAztecOption(AZ_output, AZ_all);
-            }
-            else
+            if (!solved)
             {
-                solver->SetAztecOption(AZ_output, AZ_warnings);
-            }
+                // Get matrix
+                std::shared_ptr<Epetra_CrsMatrix> mat = get_matrix(o,
+                                                                   g,
+                                                                   map_);
+
+                // Get linear problem
+                std::shared_ptr<Epetra_LinearProblem> problem
+                    = make_shared<Epetra_LinearProblem>(mat.get(),
+                                                        lhs_.get(),
+                                                        rhs_.get());
             
-            // Solve, putting result into LHS
-            solver->Iterate(wrs_.options_.max_iterations,
-                            wrs_.options_.tolerance);
-
-            // Check to ensure solver converged
-            check_aztec_convergence(solver);
+                // Get solver
+                shared_ptr<AztecOO> solver
+                    = make_shared<AztecOO>(*problem);
+                solver->SetAztecOption(AZ_solver, AZ_gmres);
+                solver->SetAztecOption(AZ_kspace, wrs_.options_.kspace);
+                if (wrs_.options_.warm_start)
+                {
+                    // Make convergence independent of the initial guess
+                    solver->SetAztecOption(AZ_conv, AZ_rhs);
+                }
+                solver->SetAztecOption(AZ_precond, AZ_none);
+                if (wrs_.options_.print)
+                {
+                    solver->SetAztecOption(AZ_output, AZ_all);
+                }
+                else
+                {
+                    solver->SetAztecOption(AZ_output, AZ_warnings);
+                }
             
-            // Update solution value (overwrite x for this o and g)
-            for (int i = 0; i < number_of_points; ++i)
-            {
-                int k_x = g + number_of_groups * (o + number_of_ordinates * i);
-                x[k_x] = (*lhs_)[i];
+                // Solve, putting result into LHS
+                solver->Iterate(wrs_.options_.max_iterations,
+                                wrs_.inner_tolerance_);
+
+                // Check to ensure solver converged
+                check_aztec_convergence(solver);
             }
-        }
-    }
+
+            // Update solution value (overwrite x for this o and g)
+            set_solution(o,
+                         g,
+                         lhs_,
+                         x);
+        };
+    schedule(task,
+             false); // AztecOO is not thread-safe
 }
 
 Meshless_Sweep::Aztec_Ifpack_Solver::
@@ -562,11 +885,13 @@ Aztec_Ifpack_Solver(Meshless_Sweep const &wrs):
     comm_ = make_shared<Epetra_MpiComm>(MPI_COMM_WORLD);
     map_ = make_shared<Epetra_Map>(number_of_points, 0, *comm_);
     
-    // Initialize matrices
+    // Initialize vectors
     lhs_ = make_shared<Epetra_Vector>(*map_);
     rhs_ = make_shared<Epetra_Vector>(*map_);
     lhs_->PutScalar(1.0);
     rhs_->PutScalar(1.0);
+    
+    // Initialize matrices
     mat_.resize(number_of_groups * number_of_ordinates);
     problem_.resize(number_of_groups * number_of_ordinates);
     if (wrs_.options_.use_preconditioner)
@@ -614,6 +939,11 @@ Aztec_Ifpack_Solver(Meshless_Sweep const &wrs):
             solver_[k] = make_shared<AztecOO>(*problem_[k]);
             solver_[k]->SetAztecOption(AZ_solver, AZ_gmres);
             solver_[k]->SetAztecOption(AZ_kspace, wrs_.options_.kspace);
+            if (wrs_.options_.warm_start)
+            {
+                // Make convergence independent of the initial guess
+                solver_[k]->SetAztecOption(AZ_conv, AZ_rhs);
+            }
             if (wrs_.options_.use_preconditioner)
             {
                 solver_[k]->SetPrecOperator(prec_[k].get());
@@ -633,43 +963,44 @@ Aztec_Ifpack_Solver(Meshless_Sweep const &wrs):
 void Meshless_Sweep::Aztec_Ifpack_Solver::
 solve(vector<double> &x) const
 {
-    int number_of_points = wrs_.spatial_discretization_->number_of_points();
     int number_of_groups = wrs_.energy_discretization_->number_of_groups();
-    int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
 
     // Solve independently for each ordinate and group
-    for (int o = 0; o < number_of_ordinates; ++o)
-    {
-        for (int g = 0; g < number_of_groups; ++g)
+    Task task
+        = [&](int o, int g, int t)
         {
             int k = g + number_of_groups * o;
 
-            // Set the LHS value
-            // If not set, the problem can converge too quickly
-            // and the solver thinks it's incorrectly converged
-            lhs_->PutScalar(1.0);
-            
             // Set current RHS value
             set_rhs(o,
                     g,
                     rhs_,
                     x);
-            
-            // Solve, putting result into LHS
-            solver_[k]->Iterate(wrs_.options_.max_iterations,
-                                wrs_.options_.tolerance);
-            
-            // Check to ensure solver converged
-            check_aztec_convergence(solver_[k]);
-            
-            // Update solution value (overwrite x for this o and g)
-            for (int i = 0; i < number_of_points; ++i)
+
+            // Set initial guess for LHS
+            bool const solved = set_lhs(o,
+                                        g,
+                                        rhs_,
+                                        lhs_);
+
+            if (!solved)
             {
-                int k_x = g + number_of_groups * (o + number_of_ordinates * i);
-                x[k_x] = (*lhs_)[i];
+                // Solve, putting result into LHS
+                solver_[k]->Iterate(wrs_.options_.max_iterations,
+                                    wrs_.inner_tolerance_);
+            
+                // Check to ensure solver converged
+                check_aztec_convergence(solver_[k]);
             }
-        }
-    }
+
+            // Update solution value (overwrite x for this o and g)
+            set_solution(o,
+                         g,
+                         lhs_,
+                         x);
+        };
+    schedule(task,
+             false); // AztecOO is not thread-safe
 }
 
 Meshless_Sweep::Belos_Solver::
@@ -710,7 +1041,13 @@ Belos_Solver(Meshless_Sweep const &wrs):
         belos_list->set("Num Blocks", wrs_.options_.kspace);
         belos_list->set("Maximum Iterations", wrs_.options_.max_iterations);
         belos_list->set("Maximum Restarts", wrs_.options_.max_restarts);
-        belos_list->set("Convergence Tolerance", wrs_.options_.tolerance);
+        belos_list->set("Convergence Tolerance", wrs_.inner_tolerance_);
+        if (wrs_.options_.warm_start)
+        {
+            // Make convergence independent of the initial guess
+            belos_list->set("Implicit Residual Scaling", "Norm of RHS");
+            belos_list->set("Explicit Residual Scaling", "Norm of RHS");
+        }
         if (wrs_.options_.print)
         {
             belos_list->set("Verbosity", Belos::IterationDetails + Belos::TimingDetails + Belos::FinalSummary);
@@ -730,53 +1067,52 @@ Belos_Solver(Meshless_Sweep const &wrs):
     }
 }
 
+void Meshless_Sweep::Belos_Solver::
+update_tolerance()
+{
+    set_belos_tolerance(solver_);
+}
+
 void Meshless_Sweep::Belos_Solver::
 solve(vector<double> &x) const
 {
-    int number_of_points = wrs_.spatial_discretization_->number_of_points();
-    int number_of_groups = wrs_.energy_discretization_->number_of_groups();
-    int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
 
     // Solve independently for each ordinate and group
-    #pragma omp parallel
-    {
-        int number_of_threads = omp_get_num_threads();
-        int t = omp_get_thread_num();
-        Assert(problem_.size() == number_of_threads);
-        
-        #pragma omp for schedule(dynamic, 1)
-        for (int o = 0; o < number_of_ordinates; ++o)
+    Task task
+        = [&](int o, int g, int t)
         {
-            for (int g = 0; g < number_of_groups; ++g)
-            {
-                int k = g + number_of_groups * o;
-                string description = std::to_string(o) + "_" + std::to_string(g);
-                
-                // Set current RHS value
-                set_rhs(o,
-                        g,
-                        rhs_[t],
-                        x);
-                
-                // Initialize LHS to 1.0 to avoid implicit residual problems
-                lhs_[t]->PutScalar(1.0);
-
-                // Get matrix
-                shared_ptr<Epetra_CrsMatrix> mat
-                    = get_matrix(o,
-                                 g,
-                                 map_[t]);
+            string description = std::to_string(o) + "_" + std::to_string(g);
+
+            // Set current RHS value
+            set_rhs(o,
+                    g,
+                    rhs_[t],
+                    x);
+
+            // Set initial guess for LHS
+            bool const solved = set_lhs(o,
+                                        g,
+                                        rhs_[t],
+                                        lhs_[t]);
+
+            if (!solved)
+            {
+                // Get matrix
+                shared_ptr<Epetra_CrsMatrix> mat
+                    = get_matrix(o,
+                                 g,
+                                 map_[t]);
 
                 // Set up problem
                 problem_[t]->setOperator(Teuchos::rcp(mat));
                 AssertMsg(problem_[t]->setProblem(), description);
-            
+
                 // Solve, putting result into LHS
                 try
                 {
                     Belos::ReturnType belos_result
                         = solver_[t]->solve();
-                
+
                     if (wrs_.options_.quit_if_diverged)
                     {
                         AssertMsg(belos_result == Belos::Converged, description);
@@ -787,17 +1123,15 @@ solve(vector<double> &x) const
                     AssertMsg(false, "Belos status test failed, " + description);
                 }
                 // std::cout << solver_[k]->getNumIters() << std::endl;
-            
-                // Update solution value (overwrite x for this o and g)
-                for (int i = 0; i < number_of_points; ++i)
-                {
-                    int k_x = g + number_of_groups * (o + number_of_ordinates * i);
-                    x[k_x] = (*lhs_[t])[i];
-                }
             }
-        }
 
-    }
+            // Update solution value (overwrite x for this o and g)
+            set_solution(o,
+                         g,
+                         lhs_[t],
+                         x);
+        };
+    schedule(task);
 }
 
 Meshless_Sweep::Belos_Ifpack_Solver::
@@ -885,7 +1219,13 @@ Belos_Ifpack_Solver(Meshless_Sweep const &wrs):
             belos_list->set("Num Blocks", wrs_.options_.kspace);
             belos_list->set("Maximum Iterations", wrs_.options_.max_iterations);
             belos_list->set("Maximum Restarts", wrs_.options_.max_restarts);
-            belos_list->set("Convergence Tolerance", wrs_.options_.tolerance);
+            belos_list->set("Convergence Tolerance", wrs_.inner_tolerance_);
+            if (wrs_.options_.warm_start)
+            {
+                // Make convergence independent of the initial guess
+                belos_list->set("Implicit Residual Scaling", "Norm of RHS");
+                belos_list->set("Explicit Residual Scaling", "Norm of RHS");
+            }
             if (wrs_.options_.print)
             {
                 belos_list->set("Verbosity", Belos::IterationDetails + Belos::TimingDetails + Belos::FinalSummary);
@@ -904,59 +1244,66 @@ Belos_Ifpack_Solver(Meshless_Sweep const &wrs):
     }
 }
 
+void Meshless_Sweep::Belos_Ifpack_Solver::
+update_tolerance()
+{
+    set_belos_tolerance(solver_);
+}
+
 void Meshless_Sweep::Belos_Ifpack_Solver::
 solve(vector<double> &x) const
 {
-    int number_of_points = wrs_.spatial_discretization_->number_of_points();
     int number_of_groups = wrs_.energy_discretization_->number_of_groups();
-    int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
 
     // Solve independently for each ordinate and group
-    #pragma omp parallel for schedule(dynamic, 1)
-    for (int o = 0; o < number_of_ordinates; ++o)
-    {
-        for (int g = 0; g < number_of_groups; ++g)
+    Task task
+        = [&](int o, int g, int t)
         {
             int k = g + number_of_groups * o;
             string description = std::to_string(o) + "_" + std::to_string(g);
-                
+
             // Set current RHS value
             set_rhs(o,
                     g,
                     rhs_[k],
                     x);
 
-            // Initialize LHS to 1.0 to avoid implicit residual problems
-            lhs_[k]->PutScalar(1.0);
+            // Set initial guess for LHS
+            bool const solved = set_lhs(o,
+                                        g,
+                                        rhs_[k],
+                                        lhs_[k]);
 
-            // Set up problem
-            AssertMsg(problem_[k]->setProblem(), description);
-            
-            // Solve, putting result into LHS
-            try
+            if (!solved)
             {
-                Belos::ReturnType belos_result
-                    = solver_[k]->solve();
-                
-                if (wrs_.options_.quit_if_diverged)
+                // Set up problem
+                AssertMsg(problem_[k]->setProblem(), description);
+
+                // Solve, putting result into LHS
+                try
+                {
+                    Belos::ReturnType belos_result
+                        = solver_[k]->solve();
+
+                    if (wrs_.options_.quit_if_diverged)
+                    {
+                        AssertMsg(belos_result == Belos::Converged, description);
+                    }
+                }
+                catch (Belos::StatusTestError const &error)
                 {
-                    AssertMsg(belos_result == Belos::Converged, description);
+                    AssertMsg(false, "Belos status test failed, " + description);
                 }
+                // std::cout << solver_[k]->getNumIters() << std::endl;
             }
-            catch (Belos::StatusTestError const &error)
-            {
-                AssertMsg(false, "Belos status test failed, " + description);
-            }
-            // std::cout << solver_[k]->getNumIters() << std::endl;
-            
+
             // Update solution value (overwrite x for this o and g)
-            for (int i = 0; i < number_of_points; ++i)
-            {
-                int k_x = g + number_of_groups * (o + number_of_ordinates * i);
-                x[k_x] = (*lhs_[k])[i];
-            }
-        }
-    }
+            set_solution(o,
+                         g,
+                         lhs_[k],
+                         x);
+        };
+    schedule(task);
 }
 
 Meshless_Sweep::Belos_Ifpack_Right_Solver::
@@ -1024,7 +1371,13 @@ Belos_Ifpack_Right_Solver(Meshless_Sweep const &wrs):
         belos_list->set("Num Blocks", wrs_.options_.kspace);
         belos_list->set("Maximum Iterations", wrs_.options_.max_iterations);
         belos_list->set("Maximum Restarts", wrs_.options_.max_restarts);
-        belos_list->set("Convergence Tolerance", wrs_.options_.tolerance);
+        belos_list->set("Convergence Tolerance", wrs_.inner_tolerance_);
+        if (wrs_.options_.warm_start)
+        {
+            // Make convergence independent of the initial guess
+            belos_list->set("Implicit Residual Scaling", "Norm of RHS");
+            belos_list->set("Explicit Residual Scaling", "Norm of RHS");
+        }
         if (wrs_.options_.print)
         {
             belos_list->set("Verbosity", Belos::IterationDetails + Belos::TimingDetails + Belos::FinalSummary);
@@ -1055,53 +1408,52 @@ Belos_Ifpack_Right_Solver(Meshless_Sweep const &wrs):
     }
 }
 
+void Meshless_Sweep::Belos_Ifpack_Right_Solver::
+update_tolerance()
+{
+    set_belos_tolerance(solver_);
+}
+
 void Meshless_Sweep::Belos_Ifpack_Right_Solver::
 solve(vector<double> &x) const
 {
-    int number_of_points = wrs_.spatial_discretization_->number_of_points();
-    int number_of_groups = wrs_.energy_discretization_->number_of_groups();
-    int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
 
     // Solve independently for each ordinate and group
-    #pragma omp parallel
-    {
-        int number_of_threads = omp_get_num_threads();
-        int t = omp_get_thread_num();
-        Assert(problem_.size() == number_of_threads);
-        
-        #pragma omp for schedule(dynamic, 1)
-        for (int o = 0; o < number_of_ordinates; ++o)
+    Task task
+        = [&](int o, int g, int t)
         {
-            for (int g = 0; g < number_of_groups; ++g)
-            {
-                int k = g + number_of_groups * o;
-                string description = std::to_string(o) + "_" + std::to_string(g);
-                
-                // Set current RHS value
-                set_rhs(o,
-                        g,
-                        rhs_[t],
-                        x);
-                
-                // Initialize LHS to 1.0 to avoid implicit residual problems
-                lhs_[t]->PutScalar(1.0);
+            string description = std::to_string(o) + "_" + std::to_string(g);
+
+            // Set current RHS value
+            set_rhs(o,
+                    g,
+                    rhs_[t],
+                    x);
+
+            // Set initial guess for LHS
+            bool const solved = set_lhs(o,
+                                        g,
+                                        rhs_[t],
+                                        lhs_[t]);
 
+            if (!solved)
+            {
                 // Get matrix
                 shared_ptr<Epetra_CrsMatrix> mat
                     = get_matrix(o,
                                  g,
                                  map_[t]);
-                
+
                 // Set up problem
                 problem_[t]->setOperator(Teuchos::rcp(mat));
                 AssertMsg(problem_[t]->setProblem(), description);
-                
+
                 // Solve, putting result into LHS
                 try
                 {
                     Belos::ReturnType belos_result
                         = solver_[t]->solve();
-                
+
                     if (wrs_.options_.quit_if_diverged)
                     {
                         AssertMsg(belos_result == Belos::Converged, description);
@@ -1112,17 +1464,15 @@ solve(vector<double> &x) const
                     AssertMsg(false, "Belos status test failed, " + description);
                 }
                 // std::cout << solver_[k]->getNumIters() << std::endl;
-            
-                // Update solution value (overwrite x for this o and g)
-                for (int i = 0; i < number_of_points; ++i)
-                {
-                    int k_x = g + number_of_groups * (o + number_of_ordinates * i);
-                    x[k_x] = (*lhs_[t])[i];
-                }
             }
-        }
 
-    }
+            // Update solution value (overwrite x for this o and g)
+            set_solution(o,
+                         g,
+                         lhs_[t],
+                         x);
+        };
+    schedule(task);
 }
 
 Meshless_Sweep::Belos_Ifpack_Right2_Solver::
@@ -1193,7 +1543,13 @@ Belos_Ifpack_Right2_Solver(Meshless_Sweep const &wrs):
         belos_list->set("Num Blocks", wrs_.options_.kspace);
         belos_list->set("Maximum Iterations", wrs_.options_.max_iterations);
         belos_list->set("Maximum Restarts", wrs_.options_.max_restarts);
-        belos_list->set("Convergence Tolerance", wrs_.options_.tolerance);
+        belos_list->set("Convergence Tolerance", wrs_.inner_tolerance_);
+        if (wrs_.options_.warm_start)
+        {
+            // Make convergence independent of the initial guess
+            belos_list->set("Implicit Residual Scaling", "Norm of RHS");
+            belos_list->set("Explicit Residual Scaling", "Norm of RHS");
+        }
         if (wrs_.options_.print)
         {
             belos_list->set("Verbosity", Belos::IterationDetails + Belos::TimingDetails + Belos::FinalSummary);
@@ -1241,45 +1597,51 @@ Belos_Ifpack_Right2_Solver(Meshless_Sweep const &wrs):
     }
 }
 
+void Meshless_Sweep::Belos_Ifpack_Right2_Solver::
+update_tolerance()
+{
+    set_belos_tolerance(solver_);
+}
+
 void Meshless_Sweep::Belos_Ifpack_Right2_Solver::
 solve(vector<double> &x) const
 {
-    int number_of_points = wrs_.spatial_discretization_->number_of_points();
     int number_of_groups = wrs_.energy_discretization_->number_of_groups();
-    int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
 
     // Solve independently for each ordinate and group
-    #pragma omp parallel
-    {
-        int number_of_threads = omp_get_num_threads();
-        int t = omp_get_thread_num();
-        
-        #pragma omp for schedule(static)
-        for (int o = 0; o < number_of_ordinates; ++o)
+    Task task
+        = [&](int o, int g, int t)
         {
-            for (int g = 0; g < number_of_groups; ++g)
-            {
-                int k = g + number_of_groups * o;
-                string description = std::to_string(o) + "_" + std::to_string(g);
-                
-                // Set current RHS value
-                set_rhs(o,
-                        g,
-                        rhs_[t],
-                        x);
-                
-                // Initialize LHS to 1.0 to avoid implicit residual problems
-                lhs_[t]->PutScalar(1.0);
+            int k = g + number_of_groups * o;
+            string description = std::to_string(o) + "_" + std::to_string(g);
+
+            // Set this thread's vectors in the problem for o and g
+            problem_[k]->setLHS(Teuchos::rcp(lhs_[t]));
+            problem_[k]->setRHS(Teuchos::rcp(rhs_[t]));
+
+            // Set current RHS value
+            set_rhs(o,
+                    g,
+                    rhs_[t],
+                    x);
 
+            // Set initial guess for LHS
+            bool const solved = set_lhs(o,
+                                        g,
+                                        rhs_[t],
+                                        lhs_[t]);
+
+            if (!solved)
+            {
                 // Set up problem
                 AssertMsg(problem_[k]->setProblem(), description);
-                
+
                 // Solve, putting result into LHS
                 try
                 {
                     Belos::ReturnType belos_result
                         = solver_[k]->solve();
-                
+
                     if (wrs_.options_.quit_if_diverged)
                     {
                         AssertMsg(belos_result == Belos::Converged, description);
@@ -1291,16 +1653,1035 @@ solve(vector<double> &x) const
                 }
 
                 // std::cout << solver_[k]->getNumIters() << std::endl;
-            
-                // Update solution value (overwrite x for this o and g)
-                for (int i = 0; i < number_of_points; ++i)
+            }
+
+            // Update solution value (overwrite x for this o and g)
+            set_solution(o,
+                         g,
+                         lhs_[t],
+                         x);
+        };
+    schedule(task);
+}
+
+class Meshless_Sweep::Component_Operator : public Epetra_Operator
+{
+public:
+
+    // Constructor
+    Component_Operator(shared_ptr<Epetra_Comm> comm,
+                       shared_ptr<Epetra_Map> map,
+                       shared_ptr<Matrix_Components const> components):
+        comm_(comm),
+        map_(map),
+        components_(components)
+    {
+        Assert(components_);
+        values_.resize(components_->column_indices.size());
+    }
+
+    // Values of the matrix for the current o and g, in the order of the components
+    vector<double> &values()
+    {
+        return values_;
+    }
+    
+    // Apply the matrix using the shared sparsity pattern
+    virtual int Apply(Epetra_MultiVector const &X,
+                      Epetra_MultiVector &Y) const override
+    {
+        Assert(X.NumVectors() == Y.NumVectors());
+        
+        int const number_of_points = components_->row_offsets.size() - 1;
+        int const number_of_vectors = X.NumVectors();
+        int const *const row_offsets = &components_->row_offsets[0];
+        int const *const column_indices = &components_->column_indices[0];
+        double const *const values = &values_[0];
+        
+        for (int v = 0; v < number_of_vectors; ++v)
+        {
+            double const *const x = X[v];
+            double *const y = Y[v];
+            for (int i = 0; i < number_of_points; ++i)
+            {
+                int const k_begin = row_offsets[i];
+                int const k_end = row_offsets[i + 1];
+                double sum = 0;
+                #pragma omp simd reduction(+:sum)
+                for (int k = k_begin; k < k_end; ++k)
                 {
-                    int k_x = g + number_of_groups * (o + number_of_ordinates * i);
-                    x[k_x] = (*lhs_[t])[i];
+                    sum += values[k] * x[column_indices[k]];
                 }
+                y[i] = sum;
             }
         }
+        
+        return 0;
+    }
+    
+    // Epetra_Operator functions
+    virtual int SetUseTranspose(bool UseTranspose) override
+    {
+        return -1;
+    }
+    virtual int ApplyInverse(Epetra_MultiVector const &X,
+                             Epetra_MultiVector &Y) const override
+    {
+        return 1;
+    }
+    virtual double NormInf() const override
+    {
+        return 0.;
+    }
+    virtual const char *Label() const override
+    {
+        return "Meshless_Sweep_Component_Operator";
+    }
+    virtual bool UseTranspose() const override
+    {
+        return false;
+    }
+    virtual bool HasNormInf() const override
+    {
+        return false;
+    }
+    virtual const Epetra_Comm &Comm() const override
+    {
+        return *comm_;
+    }
+    virtual const Epetra_Map &OperatorDomainMap() const override
+    {
+        return *map_;
+    }
+    virtual const Epetra_Map &OperatorRangeMap() const override
+    {
+        return *map_;
     }
+    
+private:
+    
+    shared_ptr<Epetra_Comm> comm_;
+    shared_ptr<Epetra_Map> map_;
+    shared_ptr<Matrix_Components const> components_;
+    vector<double> values_;
+};
+
+Meshless_Sweep::Belos_Matrix_Free_Solver::
+Belos_Matrix_Free_Solver(Meshless_Sweep const &wrs):
+    Trilinos_Solver(wrs)
+{
+    AssertMsg(components_, "matrix-free solver requires decompose_matrix and matrix components");
+    
+    int number_of_points = wrs_.spatial_discretization_->number_of_points();
+    
+    #pragma omp parallel
+    {
+        int number_of_threads = omp_get_num_threads();
+        int t = omp_get_thread_num();
+
+        #pragma omp single
+        {
+            // Initialize data pointers
+            comm_.resize(number_of_threads);
+            map_.resize(number_of_threads);
+            oper_.resize(number_of_threads);
+            lhs_.resize(number_of_threads);
+            rhs_.resize(number_of_threads);
+            prec_.resize(number_of_threads);
+            prec_mat_.resize(number_of_threads);
+            problem_.resize(number_of_threads);
+            solver_.resize(number_of_threads);
+        }
+        
+        // Get comm and map
+        comm_[t] = make_shared<Epetra_SerialComm>();
+        map_[t] = make_shared<Epetra_Map>(number_of_points, 0, *comm_[t]);
+        
+        // Get vectors and operator
+        lhs_[t] = make_shared<Epetra_Vector>(*map_[t]);
+        rhs_[t] = make_shared<Epetra_Vector>(*map_[t]);
+        lhs_[t]->PutScalar(1.0);
+        rhs_[t]->PutScalar(1.0);
+        oper_[t] = make_shared<Component_Operator>(comm_[t],
+                                                   map_[t],
+                                                   components_);
+        
+        // Get preconditioner
+        if (wrs_.options_.use_preconditioner)
+        {
+            prec_mat_[t] = get_prec_matrix(map_[t]);
+
+            Ifpack factory;
+            shared_ptr<Ifpack_Preconditioner> temp_prec
+                = shared_ptr<Ifpack_Preconditioner>(factory.Create("ILUT",
+                                                                   prec_mat_[t].get()));
+            Teuchos::ParameterList prec_list;
+            prec_list.set("fact: drop tolerance", wrs_.options_.drop_tolerance);
+            prec_list.set("fact: ilut level-of-fill", wrs_.options_.level_of_fill);
+            temp_prec->SetParameters(prec_list);
+            temp_prec->Initialize();
+            temp_prec->Compute();
+            AssertMsg(temp_prec->IsInitialized() == true, std::to_string(t));
+            AssertMsg(temp_prec->IsComputed() == true, std::to_string(t));
+
+            #pragma omp critical
+            {
+                prec_[t]
+                    = make_shared<BelosPreconditioner>(Teuchos::rcp(temp_prec));
+            }
+        }
+        
+        // Get problem and solver
+        shared_ptr<Teuchos::ParameterList> belos_list
+            = make_shared<Teuchos::ParameterList>();
+        belos_list->set("Num Blocks", wrs_.options_.kspace);
+        belos_list->set("Maximum Iterations", wrs_.options_.max_iterations);
+        belos_list->set("Maximum Restarts", wrs_.options_.max_restarts);
+        belos_list->set("Convergence Tolerance", wrs_.inner_tolerance_);
+        if (wrs_.options_.warm_start)
+        {
+            // Make convergence independent of the initial guess
+            belos_list->set("Implicit Residual Scaling", "Norm of RHS");
+            belos_list->set("Explicit Residual Scaling", "Norm of RHS");
+        }
+        if (wrs_.options_.print)
+        {
+            belos_list->set("Verbosity", Belos::IterationDetails + Belos::TimingDetails + Belos::FinalSummary);
+        }
+        else
+        {
+            belos_list->set("Verbosity", Belos::Errors + Belos::Warnings);
+        }
+        #pragma omp critical
+        {
+            problem_[t] = make_shared<BelosLinearProblem>();
+            problem_[t]->setOperator(Teuchos::rcp(oper_[t]));
+            if (wrs_.options_.use_preconditioner)
+            {
+                if (wrs_.options_.force_left)
+                {
+                    problem_[t]->setLeftPrec(Teuchos::rcp(prec_[t]));
+                }
+                else
+                {
+                    problem_[t]->setRightPrec(Teuchos::rcp(prec_[t]));
+                }
+            }
+            problem_[t]->setLHS(Teuchos::rcp(lhs_[t]));
+            problem_[t]->setRHS(Teuchos::rcp(rhs_[t]));
+            solver_[t] = make_shared<BelosSolver>(Teuchos::rcp(problem_[t]),
+                                                  Teuchos::rcp(belos_list));
+        }
+    }
+}
+
+void Meshless_Sweep::Belos_Matrix_Free_Solver::
+update_tolerance()
+{
+    set_belos_tolerance(solver_);
+}
+
+void Meshless_Sweep::Belos_Matrix_Free_Solver::
+solve(vector<double> &x) const
+{
+
+    // Solve independently for each ordinate and group
+    Task task
+        = [&](int o, int g, int t)
+        {
+            string description = std::to_string(o) + "_" + std::to_string(g);
+
+            // Set current RHS value
+            set_rhs(o,
+                    g,
+                    rhs_[t],
+                    x);
+
+            // Set initial guess for LHS
+            bool const solved = set_lhs(o,
+                                        g,
+                                        rhs_[t],
+                                        lhs_[t]);
+
+            if (!solved)
+            {
+                // Update operator values in place
+                get_matrix_values(o,
+                                  g,
+                                  oper_[t]->values());
+
+                // Set up problem
+                AssertMsg(problem_[t]->setProblem(), description);
+
+                // Solve, putting result into LHS
+                try
+                {
+                    Belos::ReturnType belos_result
+                        = solver_[t]->solve();
+
+                    if (wrs_.options_.quit_if_diverged)
+                    {
+                        AssertMsg(belos_result == Belos::Converged, description);
+                    }
+                }
+                catch (Belos::StatusTestError const &error)
+                {
+                    AssertMsg(false, "Belos status test failed, " + description);
+                }
+            }
+
+            // Update solution value (overwrite x for this o and g)
+            set_solution(o,
+                         g,
+                         lhs_[t],
+                         x);
+        };
+    schedule(task);
+}
+
+Meshless_Sweep::Eigen_Solver::
+Eigen_Solver(Meshless_Sweep const &wrs):
+    Sweep_Solver(wrs),
+    memory_(0)
+{
+    int number_of_points = wrs_.spatial_discretization_->number_of_points();
+    int number_of_groups = wrs_.energy_discretization_->number_of_groups();
+    int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
+    int number_of_matrices = number_of_groups * number_of_ordinates;
+    bool single_precision = wrs_.options_.single_precision;
+    
+    // Perform symbolic analysis once for the shared pattern
+    get_matrix_pattern(row_offsets_,
+                       column_indices_);
+    int number_of_entries = column_indices_.size();
+    if (single_precision)
+    {
+        single_pattern_
+            = make_shared<Eigen_Sparse_Pattern<float> >(number_of_points,
+                                                        row_offsets_,
+                                                        column_indices_);
+    }
+    else
+    {
+        pattern_ = make_shared<Eigen_Sparse_Pattern<double> >(number_of_points,
+                                                              row_offsets_,
+                                                              column_indices_);
+    }
+    
+    // Initialize vectors for each thread
+    #pragma omp parallel
+    {
+        int number_of_threads = omp_get_num_threads();
+        int t = omp_get_thread_num();
+        
+        #pragma omp single
+        {
+            values_.resize(number_of_threads);
+            rhs_.resize(number_of_threads);
+            lhs_.resize(number_of_threads);
+            residual_.resize(number_of_threads);
+            single_values_.resize(number_of_threads);
+            single_rhs_.resize(number_of_threads);
+            single_lhs_.resize(number_of_threads);
+        }
+        
+        values_[t].resize(number_of_entries);
+        rhs_[t].resize(number_of_points);
+        lhs_[t].resize(number_of_points);
+        if (single_precision)
+        {
+            residual_[t].resize(number_of_points);
+            single_values_[t].resize(number_of_entries);
+            single_rhs_[t].resize(number_of_points);
+            single_lhs_[t].resize(number_of_points);
+        }
+    }
+    
+    // Decompositions are performed as needed during the solve
+    solver_.resize(number_of_matrices);
+    recent_position_.resize(number_of_matrices, recent_.end());
+    hits_.assign(number_of_matrices, 0);
+    misses_.assign(number_of_matrices, 0);
+    refinements_.assign(number_of_matrices, 0);
+}
+
+double Meshless_Sweep::Eigen_Solver::Factorization::
+memory() const
+{
+    return ((double_solver ? double_solver->memory() : 0.)
+            + (single_solver ? single_solver->memory() : 0.));
+}
+
+shared_ptr<Meshless_Sweep::Eigen_Solver::Factorization> Meshless_Sweep::Eigen_Solver::
+get_solver(int o,
+           int g,
+           int t) const
+{
+    int const k = g + wrs_.energy_discretization_->number_of_groups() * o;
+    double const max_memory = wrs_.options_.max_factorization_memory;
+    
+    // Check for a stored decomposition
+    shared_ptr<Factorization> solver;
+    #pragma omp critical(eigen_solver_cache)
+    {
+        solver = solver_[k];
+        if (solver)
+        {
+            hits_[k] += 1;
+            recent_.splice(recent_.begin(), recent_, recent_position_[k]);
+        }
+        else
+        {
+            misses_[k] += 1;
+        }
+    }
+    if (solver)
+    {
+        return solver;
+    }
+    
+    // Factor the matrix outside of the critical section
+    get_matrix_values(o,
+                      g,
+                      values_[t]);
+    solver = make_shared<Factorization>();
+    if (wrs_.options_.single_precision)
+    {
+        vector<float> &single_values = single_values_[t];
+        single_values.assign(values_[t].begin(), values_[t].end());
+        solver->single_solver = make_shared<Eigen_Sparse_Solver<float> >(single_pattern_);
+        solver->single_solver->initialize(single_values);
+    }
+    else
+    {
+        solver->double_solver = make_shared<Eigen_Sparse_Solver<double> >(pattern_);
+        solver->double_solver->initialize(values_[t]);
+    }
+    
+    // Store the decomposition, discarding the least recently used past the limit
+    #pragma omp critical(eigen_solver_cache)
+    {
+        solver_[k] = solver;
+        recent_.push_front(k);
+        recent_position_[k] = recent_.begin();
+        memory_ += solver->memory();
+        
+        while (max_memory >= 0 && memory_ > max_memory && recent_.size() > 1)
+        {
+            int const l = recent_.back();
+            recent_.pop_back();
+            recent_position_[l] = recent_.end();
+            memory_ -= solver_[l]->memory();
+            solver_[l].reset();
+        }
+    }
+    
+    return solver;
+}
+
+void Meshless_Sweep::Eigen_Solver::
+solve_refined(int o,
+              int g,
+              int t,
+              Factorization const &factorization) const
+{
+    int number_of_points = wrs_.spatial_discretization_->number_of_points();
+    int const max_iterations = wrs_.options_.max_refinement_iterations;
+    double const tolerance = wrs_.inner_tolerance_;
+    vector<double> const &rhs = rhs_[t];
+    vector<double> &lhs = lhs_[t];
+    vector<double> &residual = residual_[t];
+    vector<double> &values = values_[t];
+    vector<float> &single_rhs = single_rhs_[t];
+    vector<float> &single_lhs = single_lhs_[t];
+    
+    // Get double precision matrix values for the residual
+    get_matrix_values(o,
+                      g,
+                      values);
+    
+    // Initial solve in single precision
+    double rhs_norm = 0;
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        rhs_norm = max(rhs_norm, std::abs(rhs[i]));
+        single_rhs[i] = rhs[i];
+    }
+    factorization.single_solver->solve(single_rhs,
+                                       single_lhs);
+    lhs.assign(single_lhs.begin(), single_lhs.end());
+    
+    // Correct the solution until the residual is below the tolerance,
+    // checking the residual after the last correction as well
+    bool converged = false;
+    int iteration = 0;
+    for (; ; ++iteration)
+    {
+        // Get residual
+        double residual_norm = 0;
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            double sum = rhs[i];
+            for (int l = row_offsets_[i]; l < row_offsets_[i + 1]; ++l)
+            {
+                sum -= values[l] * lhs[column_indices_[l]];
+            }
+            residual[i] = sum;
+            residual_norm = max(residual_norm, std::abs(sum));
+        }
+        if (residual_norm <= tolerance * rhs_norm)
+        {
+            converged = true;
+            break;
+        }
+        if (iteration == max_iterations)
+        {
+            break;
+        }
+        
+        // Solve for the correction in single precision
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            single_rhs[i] = residual[i];
+        }
+        factorization.single_solver->solve(single_rhs,
+                                           single_lhs);
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            lhs[i] += single_lhs[i];
+        }
+    }
+    
+    #pragma omp atomic
+    refinements_[g + wrs_.energy_discretization_->number_of_groups() * o] += iteration;
+    
+    if (!converged)
+    {
+        string message = "Eigen_Solver: iterative refinement did not converge";
+        if (wrs_.options_.quit_if_diverged)
+        {
+            AssertMsg(false, message);
+        }
+        else
+        {
+            std::cerr << message << std::endl;
+        }
+    }
+}
+
+void Meshless_Sweep::Eigen_Solver::
+solve(vector<double> &x) const
+{
+    int number_of_points = wrs_.spatial_discretization_->number_of_points();
+    int number_of_groups = wrs_.energy_discretization_->number_of_groups();
+    int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
+    
+    // Solve independently for each ordinate and group
+    Task task
+        = [&](int o, int g, int t)
+        {
+            vector<double> &rhs = rhs_[t];
+            vector<double> &lhs = lhs_[t];
+            
+            // Set current RHS value
+            for (int i = 0; i < number_of_points; ++i)
+            {
+                wrs_.get_rhs(i,
+                             o,
+                             g,
+                             x,
+                             rhs[i]);
+            }
+            
+            // Solve, putting result into LHS
+            shared_ptr<Factorization> factorization = get_solver(o, g, t);
+            if (wrs_.options_.single_precision)
+            {
+                solve_refined(o,
+                              g,
+                              t,
+                              *factorization);
+            }
+            else
+            {
+                factorization->double_solver->solve(rhs,
+                                                    lhs);
+            }
+            
+            // Update solution value (overwrite x for this o and g)
+            for (int i = 0; i < number_of_points; ++i)
+            {
+                int k_x = g + number_of_groups * (o + number_of_ordinates * i);
+                x[k_x] = lhs[i];
+            }
+        };
+    schedule(task);
+}
+
+void Meshless_Sweep::Eigen_Solver::
+output(XML_Node output_node) const
+{
+    XML_Node cache_node = output_node.append_child("factorization_cache");
+    cache_node.set_attribute(wrs_.options_.max_factorization_memory, "max_memory");
+    cache_node.set_attribute(memory_, "memory");
+    cache_node.set_attribute(static_cast<int>(recent_.size()), "number_stored");
+    cache_node.set_attribute(wrs_.options_.single_precision, "single_precision");
+    cache_node.set_child_vector(hits_, "hits", "group-ordinate");
+    cache_node.set_child_vector(misses_, "misses", "group-ordinate");
+    if (wrs_.options_.single_precision)
+    {
+        cache_node.set_child_vector(refinements_, "refinements", "group-ordinate");
+    }
+}
+
+Meshless_Sweep::Upwind_Solver::
+Upwind_Solver(Meshless_Sweep const &wrs):
+    Sweep_Solver(wrs)
+{
+    int number_of_points = wrs_.spatial_discretization_->number_of_points();
+    int number_of_groups = wrs_.energy_discretization_->number_of_groups();
+    int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
+    
+    // Get pattern shared by all matrices
+    get_matrix_pattern(row_offsets_,
+                       column_indices_);
+    int number_of_entries = column_indices_.size();
+    
+    // Order the points once for each ordinate, as the order depends only on
+    // the direction and is the same for each group
+    orderings_.resize(number_of_ordinates);
+    #pragma omp parallel for schedule(dynamic)
+    for (int o = 0; o < number_of_ordinates; ++o)
+    {
+        get_ordering(o,
+                     orderings_[o]);
+    }
+    
+    // Initialize workspace for each thread
+    #pragma omp parallel
+    {
+        int number_of_threads = omp_get_num_threads();
+        int t = omp_get_thread_num();
+        
+        #pragma omp single
+        {
+            workspace_.resize(number_of_threads);
+        }
+        
+        Workspace &workspace = workspace_[t];
+        workspace.values.resize(number_of_entries);
+        workspace.rhs.resize(number_of_points);
+        workspace.lhs.resize(number_of_points);
+        workspace.residual.resize(number_of_points);
+        workspace.shadow_residual.resize(number_of_points);
+        workspace.search.resize(number_of_points);
+        workspace.product.resize(number_of_points);
+        workspace.intermediate.resize(number_of_points);
+        workspace.intermediate_product.resize(number_of_points);
+        workspace.preconditioned.resize(number_of_points);
+    }
+    
+    iterations_.assign(number_of_groups * number_of_ordinates, 0);
+    fallbacks_.assign(number_of_groups * number_of_ordinates, 0);
+}
+
+void Meshless_Sweep::Upwind_Solver::
+get_ordering(int o,
+             Ordering &ordering) const
+{
+    int number_of_points = wrs_.spatial_discretization_->number_of_points();
+    int dimension = wrs_.spatial_discretization_->dimension();
+    int max_block_size = wrs_.options_.max_block_size;
+    vector<double> const &direction = wrs_.angular_discretization_->direction(o);
+    vector<int> &block_offsets = ordering.block_offsets;
+    vector<int> &block_points = ordering.block_points;
+    vector<int> &point_block = ordering.point_block;
+    vector<int> &point_position = ordering.point_position;
+    Assert(max_block_size >= 1);
+    
+    // Sort the points by distance along the direction
+    vector<double> distance(number_of_points, 0.);
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        vector<double> const &position = wrs_.spatial_discretization_->weight(i)->position();
+        for (int d = 0; d < dimension; ++d)
+        {
+            distance[i] += direction[d] * position[d];
+        }
+    }
+    block_points.resize(number_of_points);
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        block_points[i] = i;
+    }
+    std::stable_sort(block_points.begin(), block_points.end(),
+                     [&](int i, int j)
+                     {
+                         return distance[i] < distance[j];
+                     });
+    
+    // Group consecutive points into blocks
+    block_offsets.assign(1, 0);
+    for (int l = 0; l < number_of_points; l += max_block_size)
+    {
+        block_offsets.push_back(min(l + max_block_size, number_of_points));
+    }
+    
+    // Get block and position in block of each point
+    int number_of_blocks = block_offsets.size() - 1;
+    point_block.resize(number_of_points);
+    point_position.resize(number_of_points);
+    for (int b = 0; b < number_of_blocks; ++b)
+    {
+        for (int l = block_offsets[b]; l < block_offsets[b + 1]; ++l)
+        {
+            int i = block_points[l];
+            point_block[i] = b;
+            point_position[i] = l - block_offsets[b];
+        }
+    }
+    
+    // Check whether the sweep alone is exact
+    ordering.lagged = false;
+    for (int i = 0; i < number_of_points && !ordering.lagged; ++i)
+    {
+        for (int k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k)
+        {
+            if (point_block[column_indices_[k]] > point_block[i])
+            {
+                ordering.lagged = true;
+                break;
+            }
+        }
+    }
+}
+
+void Meshless_Sweep::Upwind_Solver::
+factor_blocks(Ordering const &ordering,
+              Workspace &workspace) const
+{
+    vector<double> const &values = workspace.values;
+    vector<int> const &block_offsets = ordering.block_offsets;
+    vector<int> const &block_points = ordering.block_points;
+    vector<int> const &point_block = ordering.point_block;
+    vector<int> const &point_position = ordering.point_position;
+    vector<double> &a = workspace.block_matrix;
+    int number_of_blocks = block_offsets.size() - 1;
+    
+    // Solvers from previous solves are reused when the sizes match
+    if (workspace.block_solvers.size() < number_of_blocks)
+    {
+        workspace.block_solvers.resize(number_of_blocks);
+    }
+    for (int b = 0; b < number_of_blocks; ++b)
+    {
+        int block_size = block_offsets[b + 1] - block_offsets[b];
+        if (block_size == 1)
+        {
+            continue;
+        }
+        
+        // Get all entries between points in the block
+        a.assign(block_size * block_size, 0.);
+        for (int l = 0; l < block_size; ++l)
+        {
+            int i = block_points[block_offsets[b] + l];
+            for (int k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k)
+            {
+                int j = column_indices_[k];
+                if (point_block[j] == b)
+                {
+                    a[point_position[j] + block_size * l] += values[k];
+                }
+            }
+        }
+        
+        shared_ptr<Eigen_Dense_Solver<double> > &solver = workspace.block_solvers[b];
+        if (!solver || solver->size() != block_size)
+        {
+            solver = make_shared<Eigen_Dense_Solver<double> >(block_size);
+        }
+        solver->initialize(a);
+    }
+}
+
+void Meshless_Sweep::Upwind_Solver::
+sweep(Ordering const &ordering,
+      Workspace &workspace,
+      vector<double> const &b,
+      vector<double> &x) const
+{
+    vector<double> const &values = workspace.values;
+    vector<int> const &block_offsets = ordering.block_offsets;
+    vector<int> const &block_points = ordering.block_points;
+    vector<int> const &point_block = ordering.point_block;
+    vector<double> &r = workspace.block_rhs;
+    vector<double> &y = workspace.block_lhs;
+    int number_of_blocks = block_offsets.size() - 1;
+    
+    // Solve each block using the values of the upwind blocks
+    for (int c = 0; c < number_of_blocks; ++c)
+    {
+        int block_size = block_offsets[c + 1] - block_offsets[c];
+        if (block_size == 1)
+        {
+            int i = block_points[block_offsets[c]];
+            double diagonal = 0;
+            double sum = b[i];
+            for (int k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k)
+            {
+                int j = column_indices_[k];
+                if (j == i)
+                {
+                    diagonal += values[k];
+                }
+                else if (point_block[j] < c)
+                {
+                    sum -= values[k] * x[j];
+                }
+            }
+            x[i] = sum / diagonal;
+        }
+        else
+        {
+            r.resize(block_size);
+            y.resize(block_size);
+            for (int l = 0; l < block_size; ++l)
+            {
+                int i = block_points[block_offsets[c] + l];
+                r[l] = b[i];
+                for (int k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k)
+                {
+                    int j = column_indices_[k];
+                    if (point_block[j] < c)
+                    {
+                        r[l] -= values[k] * x[j];
+                    }
+                }
+            }
+            workspace.block_solvers[c]->solve(r,
+                                              y);
+            for (int l = 0; l < block_size; ++l)
+            {
+                x[block_points[block_offsets[c] + l]] = y[l];
+            }
+        }
+    }
+}
+
+void Meshless_Sweep::Upwind_Solver::
+multiply(Workspace const &workspace,
+         vector<double> const &x,
+         vector<double> &y) const
+{
+    int number_of_points = wrs_.spatial_discretization_->number_of_points();
+    vector<double> const &values = workspace.values;
+    
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        double sum = 0;
+        for (int k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k)
+        {
+            sum += values[k] * x[column_indices_[k]];
+        }
+        y[i] = sum;
+    }
+}
+
+bool Meshless_Sweep::Upwind_Solver::
+solve_bicgstab(Ordering const &ordering,
+               Workspace &workspace,
+               int &number_of_iterations) const
+{
+    int number_of_points = wrs_.spatial_discretization_->number_of_points();
+    int max_iterations = wrs_.options_.max_iterations;
+    double tolerance = wrs_.inner_tolerance_;
+    vector<double> const &rhs = workspace.rhs;
+    vector<double> &x = workspace.lhs;
+    vector<double> &r = workspace.residual;
+    vector<double> &r0 = workspace.shadow_residual;
+    vector<double> &p = workspace.search;
+    vector<double> &v = workspace.product;
+    vector<double> &s = workspace.intermediate;
+    vector<double> &t = workspace.intermediate_product;
+    vector<double> &y = workspace.preconditioned;
+    auto dot
+        = [number_of_points](vector<double> const &a,
+                             vector<double> const &b)
+        {
+            double sum = 0;
+            for (int i = 0; i < number_of_points; ++i)
+            {
+                sum += a[i] * b[i];
+            }
+            return sum;
+        };
+    
+    // Without downwind couplings, a single sweep is exact
+    sweep(ordering,
+          workspace,
+          rhs,
+          x);
+    number_of_iterations = 1;
+    if (!ordering.lagged)
+    {
+        return true;
+    }
+    
+    // Start from the sweep of the right hand side
+    multiply(workspace,
+             x,
+             r);
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        r[i] = rhs[i] - r[i];
+    }
+    r0 = r;
+    std::fill(p.begin(), p.end(), 0.);
+    std::fill(v.begin(), v.end(), 0.);
+    double const max_residual = tolerance * sqrt(dot(rhs, rhs));
+    double rho = 1;
+    double alpha = 1;
+    double omega = 1;
+    for (number_of_iterations = 1; number_of_iterations <= max_iterations; ++number_of_iterations)
+    {
+        if (sqrt(dot(r, r)) <= max_residual)
+        {
+            return true;
+        }
+        
+        // Update search direction
+        double const rho_new = dot(r0, r);
+        double const beta = (rho_new / rho) * (alpha / omega);
+        rho = rho_new;
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            p[i] = r[i] + beta * (p[i] - omega * v[i]);
+        }
+        sweep(ordering,
+              workspace,
+              p,
+              y);
+        multiply(workspace,
+                 y,
+                 v);
+        alpha = rho / dot(r0, v);
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            x[i] += alpha * y[i];
+            s[i] = r[i] - alpha * v[i];
+        }
+        
+        // Stabilize
+        sweep(ordering,
+              workspace,
+              s,
+              y);
+        multiply(workspace,
+                 y,
+                 t);
+        omega = dot(t, s) / dot(t, t);
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            x[i] += omega * y[i];
+            r[i] = s[i] - omega * t[i];
+        }
+        
+        if (!std::isfinite(omega) || !std::isfinite(alpha) || omega == 0)
+        {
+            return false;
+        }
+    }
+    number_of_iterations = max_iterations;
+    return sqrt(dot(r, r)) <= max_residual;
+}
+
+shared_ptr<Eigen_Sparse_Pattern<double> > Meshless_Sweep::Upwind_Solver::
+get_pattern() const
+{
+    // Perform symbolic analysis only if a fallback solve is needed
+    #pragma omp critical(upwind_solver_pattern)
+    {
+        if (!pattern_)
+        {
+            int number_of_points = wrs_.spatial_discretization_->number_of_points();
+            pattern_ = make_shared<Eigen_Sparse_Pattern<double> >(number_of_points,
+                                                                  row_offsets_,
+                                                                  column_indices_);
+        }
+    }
+    return pattern_;
+}
+
+void Meshless_Sweep::Upwind_Solver::
+solve(vector<double> &x) const
+{
+    int number_of_points = wrs_.spatial_discretization_->number_of_points();
+    int number_of_groups = wrs_.energy_discretization_->number_of_groups();
+    int number_of_ordinates = wrs_.angular_discretization_->number_of_ordinates();
+    
+    // Solve independently for each ordinate and group
+    Task task
+        = [&](int o, int g, int t)
+        {
+            Ordering const &ordering = orderings_[o];
+            Workspace &workspace = workspace_[t];
+            vector<double> &rhs = workspace.rhs;
+            vector<double> &lhs = workspace.lhs;
+            int k_og = g + number_of_groups * o;
+            
+            // Get matrix and current RHS value
+            get_matrix_values(o,
+                              g,
+                              workspace.values);
+            for (int i = 0; i < number_of_points; ++i)
+            {
+                wrs_.get_rhs(i,
+                             o,
+                             g,
+                             x,
+                             rhs[i]);
+            }
+            
+            // Factor the blocks in the stored order, then solve
+            factor_blocks(ordering,
+                          workspace);
+            int number_of_iterations;
+            bool converged = solve_bicgstab(ordering,
+                                            workspace,
+                                            number_of_iterations);
+            iterations_[k_og] += number_of_iterations;
+            
+            if (!converged)
+            {
+                AssertMsg(!wrs_.options_.quit_if_diverged,
+                          "upwind solve did not converge, " + std::to_string(o) + "_" + std::to_string(g));
+                
+                // Fall back to a direct solve of the full matrix
+                Eigen_Sparse_Solver<double> solver(get_pattern());
+                solver.initialize(workspace.values);
+                solver.solve(rhs,
+                             lhs);
+                fallbacks_[k_og] += 1;
+            }
+            
+            // Update solution value (overwrite x for this o and g)
+            for (int i = 0; i < number_of_points; ++i)
+            {
+                int k_x = g + number_of_groups * (o + number_of_ordinates * i);
+                x[k_x] = lhs[i];
+            }
+        };
+    schedule(task);
+}
+
+void Meshless_Sweep::Upwind_Solver::
+output(XML_Node output_node) const
+{
+    XML_Node upwind_node = output_node.append_child("upwind");
+    upwind_node.set_attribute(wrs_.options_.max_block_size, "max_block_size");
+    upwind_node.set_child_vector(iterations_, "iterations", "group-ordinate");
+    upwind_node.set_child_vector(fallbacks_, "fallbacks", "group-ordinate");
 }
 
 shared_ptr<Conversion<Meshless_Sweep::Options::Solver, string> > Meshless_Sweep::Options::
@@ -1314,7 +2695,10 @@ solver_conversion() const
            {Solver::BELOS, "belos"},
            {Solver::BELOS_IFPACK, "belos_ifpack"},
            {Solver::BELOS_IFPACK_RIGHT, "belos_ifpack_right"},
-           {Solver::BELOS_IFPACK_RIGHT2, "belos_ifpack_right2"}};
+           {Solver::BELOS_IFPACK_RIGHT2, "belos_ifpack_right2"},
+           {Solver::BELOS_MATRIX_FREE, "belos_matrix_free"},
+           {Solver::EIGEN_SPARSE_LU, "eigen_sparse_lu"},
+           {Solver::UPWIND, "upwind"}};
            
     return make_shared<Conversion<Solver, string> >(conversions);
 }
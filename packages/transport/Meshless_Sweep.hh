@@ -1,12 +1,18 @@
 #ifndef Meshless_Sweep_hh
 #define Meshless_Sweep_hh
 
+#include <functional>
+#include <list>
+
 #include "Sweep_Operator.hh"
 #include "Weak_Spatial_Discretization.hh"
 
 class Amesos_BaseSolver;
 class AztecOO;
 template<class T1, class T2> class Conversion;
+template<class Scalar> class Eigen_Dense_Solver;
+template<class Scalar> class Eigen_Sparse_Pattern;
+template<class Scalar> class Eigen_Sparse_Solver;
 class Epetra_CrsMatrix;
 class Epetra_Comm;
 class Epetra_LinearProblem;
@@ -44,7 +50,10 @@ public:
             BELOS,
             BELOS_IFPACK,
             BELOS_IFPACK_RIGHT,
-            BELOS_IFPACK_RIGHT2
+            BELOS_IFPACK_RIGHT2,
+            BELOS_MATRIX_FREE,
+            EIGEN_SPARSE_LU,
+            UPWIND
         };
         std::shared_ptr<Conversion<Solver, std::string> > solver_conversion() const;
         
@@ -64,6 +73,23 @@ public:
         // Options specific to right preconditioners
         bool weighted_preconditioner = false; 
         bool force_left = false;
+
+        // Assemble matrices from direction-independent components
+        bool decompose_matrix = true;
+
+        // Memory limit in bytes for stored factorizations (negative for no limit)
+        double max_factorization_memory = -1;
+
+        // Use previous solution as initial guess for iterative solvers
+        bool warm_start = false;
+
+        // Store sparse LU factors in single precision and recover double
+        // precision through iterative refinement
+        bool single_precision = false;
+        int max_refinement_iterations = 10;
+
+        // Number of consecutive points the upwind solver factors together
+        int max_block_size = 16;
     };
 
     // Constructor
@@ -89,6 +115,11 @@ public:
     virtual void output(XML_Node output_node) const override;
     virtual void check_class_invariants() const override = 0;
     virtual std::string description() const override = 0;
+
+    // Set the relative tolerance of the iterative sweep solvers, or return
+    // to the tolerance given in the options
+    virtual void set_inner_tolerance(double tolerance) override;
+    virtual void reset_inner_tolerance() override;
     
     // Save matrix to specified XML output file
     void save_matrix_as_xml(int o,
@@ -97,6 +128,27 @@ public:
     
 protected:
 
+    // Direction-independent pieces of the transport matrix
+    // All components share the sparsity pattern of the basis function indices
+    struct Matrix_Components
+    {
+        int number_of_components = 0;
+        std::vector<int> row_offsets; // point -> first entry of row
+        std::vector<int> column_indices; // entry -> global basis index
+        std::vector<double> values; // entry + number_of_entries * component
+    };
+
+    // Coefficients of the components for a single ordinate and group
+    // A(o,g) = sum_c a_c K_c + diag(r) sum_c b_c K_c
+    struct Matrix_Coefficients
+    {
+        std::vector<int> components; // c for a_c
+        std::vector<double> coefficients; // a_c
+        std::vector<int> scaled_components; // c for b_c
+        std::vector<double> scaled_coefficients; // b_c
+        std::vector<double> row_scaling; // r, empty if no scaled components
+    };
+    
     // Vector_Operator function
     virtual void apply(std::vector<double> &x) const override;
 
@@ -116,6 +168,16 @@ protected:
                          int g, // group
                          std::vector<double> const &x, // angular flux w/ augments
                          double &value) const = 0; // rhs value
+
+    // Direction-decomposed matrix: optional, get_matrix_row is used if not available
+    virtual bool has_matrix_components() const
+    {
+        return false;
+    }
+    virtual void get_matrix_components(Matrix_Components &components) const;
+    virtual void get_matrix_coefficients(int o, // ordinate
+                                         int g, // group
+                                         Matrix_Coefficients &coefficients) const;
     
     // Generalized solver
     class Sweep_Solver
@@ -127,9 +189,48 @@ protected:
         // Solve problem
         virtual void solve(std::vector<double> &x) const = 0;
 
+        // Update solver after a change to the tolerance in the options
+        // Solvers that read the tolerance during the solve need not update
+        virtual void update_tolerance()
+        {
+        }
+        
+        // Output data to XML file
+        virtual void output(XML_Node output_node) const;
+
     protected:
+
+        // Task for one ordinate and group, given the thread number
+        typedef std::function<void(int, int, int)> Task; // (o, g, t)
+
+        // Perform task for each ordinate and group, in parallel unless the
+        // solver shares data that is not thread-safe between tasks
+        // Tasks are started in order of decreasing time in the last call,
+        // and each thread takes the next task when it finishes its current one
+        void schedule(Task const &task,
+                      bool parallel = true) const;
+
+        // Check whether group is included in the current sweep
+        bool group_active(int g) const;
+        
+        // Get sparsity pattern shared by the matrices for all o and g
+        void get_matrix_pattern(std::vector<int> &row_offsets,
+                                std::vector<int> &column_indices) const;
+        
+        // Get values of the transport matrix for o and g in the order of the pattern
+        void get_matrix_values(int o,
+                               int g,
+                               std::vector<double> &values) const;
+        
         // Data
         Meshless_Sweep const &wrs_;
+
+        // Matrix components, shared by all o and g
+        std::shared_ptr<Matrix_Components> components_;
+
+        // Task order and time from the last call to schedule()
+        mutable std::vector<int> task_order_;
+        mutable std::vector<double> task_time_;
     };
     
     // Generalized trilinos solver
@@ -157,14 +258,33 @@ protected:
                      int g,
                      std::shared_ptr<Epetra_Vector> &rhs,
                      std::vector<double> const &x) const;
+
+        // Set initial guess for lhs from the previous solution for o and g
+        // Returns true if the initial guess is already the solution
+        bool set_lhs(int o,
+                     int g,
+                     std::shared_ptr<Epetra_Vector> const &rhs,
+                     std::shared_ptr<Epetra_Vector> &lhs) const;
+
+        // Copy lhs into x for o and g and store it for the next initial guess
+        void set_solution(int o,
+                          int g,
+                          std::shared_ptr<Epetra_Vector> const &lhs,
+                          std::vector<double> &x) const;
         
         // Check Aztec solver message
         void check_aztec_convergence(std::shared_ptr<AztecOO> const solver) const;
+
+        // Set the convergence tolerance of existing Belos solvers
+        void set_belos_tolerance(std::vector<std::shared_ptr<BelosSolver> > const &solvers) const;
+
+        // Previous solution for each o and g
+        mutable std::vector<double> initial_guess_;
     };
     
     // Amesos solver
     // Stores LU decompositions of all matrices
-    // Only serial
+    // Only serial, as all factorizations share one map and pair of vectors
     class Amesos_Solver : public Trilinos_Solver
     {
     public:
@@ -211,7 +331,7 @@ protected:
     
     // Aztec solver
     // Iterative, does not store matrices
-    // Only in serial
+    // Only in serial, as AztecOO is not thread-safe
     class Aztec_Solver : public Trilinos_Solver
     {
     public:
@@ -236,12 +356,11 @@ protected:
         std::shared_ptr<Epetra_Map> map_;
         mutable std::shared_ptr<Epetra_Vector> lhs_;
         mutable std::shared_ptr<Epetra_Vector> rhs_;
-        
     };
 
     // Aztec preconditioned by Ifpack
     // Preconditioned by inverse of Linv matrices
-    // Only in serial
+    // Only in serial, as AztecOO is not thread-safe
     class Aztec_Ifpack_Solver : public Trilinos_Solver
     {
     public:
@@ -275,6 +394,7 @@ protected:
         
         // Solve problem
         virtual void solve(std::vector<double> &x) const override;
+        virtual void update_tolerance() override;
         
     protected:
 
@@ -298,6 +418,7 @@ protected:
         
         // Solve problem
         virtual void solve(std::vector<double> &x) const override;
+        virtual void update_tolerance() override;
 
     protected:
         
@@ -324,6 +445,7 @@ protected:
         
         // Solve problem
         virtual void solve(std::vector<double> &x) const override;
+        virtual void update_tolerance() override;
 
     protected:
         
@@ -338,6 +460,39 @@ protected:
         std::vector<std::shared_ptr<BelosSolver> > solver_;
     };
 
+    // Applies the transport matrix for a single o and g using the values
+    // combined from the matrix components, without an Epetra_CrsMatrix
+    // Defined in the source file to keep Epetra_Operator out of this header
+    class Component_Operator;
+
+    // Belos using the matrix components as an operator
+    // Optionally preconditioned on the right by the inverse of the basis value matrix
+    // Does not create matrices for o and g
+    // Works in parallel
+    class Belos_Matrix_Free_Solver : public Trilinos_Solver
+    {
+    public:
+        
+        // Constructor
+        Belos_Matrix_Free_Solver(Meshless_Sweep const &wrs);
+        
+        // Solve problem
+        virtual void solve(std::vector<double> &x) const override;
+        virtual void update_tolerance() override;
+
+    protected:
+        
+        std::vector<std::shared_ptr<Epetra_Comm> > comm_;
+        std::vector<std::shared_ptr<Epetra_Map> > map_;
+        std::vector<std::shared_ptr<Component_Operator> > oper_;
+        mutable std::vector<std::shared_ptr<Epetra_Vector> > lhs_;
+        mutable std::vector<std::shared_ptr<Epetra_Vector> > rhs_;
+        std::vector<std::shared_ptr<Epetra_CrsMatrix> > prec_mat_;
+        std::vector<std::shared_ptr<BelosPreconditioner> > prec_;
+        std::vector<std::shared_ptr<BelosLinearProblem> > problem_;
+        std::vector<std::shared_ptr<BelosSolver> > solver_;
+    };
+    
     // Belos preconditioned on the right by Ifpack
     // Preconditioned on the right by the inverse of the basis value matrix
     // Stores the matrices between iterations
@@ -351,6 +506,7 @@ protected:
         
         // Solve problem
         virtual void solve(std::vector<double> &x) const override;
+        virtual void update_tolerance() override;
 
     protected:
         
@@ -365,8 +521,163 @@ protected:
         std::vector<std::shared_ptr<BelosSolver> > solver_;
     };
     
+    // Eigen sparse LU solver
+    // Stores LU decompositions, which share one symbolic analysis
+    // Least recently used decompositions are discarded past the memory limit
+    // Decompositions may be stored in single precision, in which case the
+    // solution is refined using residuals computed in double precision
+    // Works in parallel
+    class Eigen_Solver : public Sweep_Solver
+    {
+    public:
+
+        // Constructor
+        Eigen_Solver(Meshless_Sweep const &wrs);
+
+        // Solve problem
+        virtual void solve(std::vector<double> &x) const override;
+
+        // Output data to XML file
+        virtual void output(XML_Node output_node) const override;
+        
+    protected:
+
+        // Decomposition in either double or single precision
+        struct Factorization
+        {
+            std::shared_ptr<Eigen_Sparse_Solver<double> > double_solver;
+            std::shared_ptr<Eigen_Sparse_Solver<float> > single_solver;
+
+            double memory() const;
+        };
+        
+        // Get stored decomposition, or factor the matrix if it is not stored
+        std::shared_ptr<Factorization> get_solver(int o,
+                                                  int g,
+                                                  int t) const;
+
+        // Solve using the single precision decomposition with iterative refinement
+        void solve_refined(int o,
+                           int g,
+                           int t,
+                           Factorization const &factorization) const;
+        
+        // Data
+        std::vector<int> row_offsets_;
+        std::vector<int> column_indices_;
+        std::shared_ptr<Eigen_Sparse_Pattern<double> > pattern_;
+        std::shared_ptr<Eigen_Sparse_Pattern<float> > single_pattern_;
+        mutable std::vector<std::vector<double> > values_;
+        mutable std::vector<std::vector<double> > rhs_;
+        mutable std::vector<std::vector<double> > lhs_;
+        mutable std::vector<std::vector<double> > residual_;
+        mutable std::vector<std::vector<float> > single_values_;
+        mutable std::vector<std::vector<float> > single_rhs_;
+        mutable std::vector<std::vector<float> > single_lhs_;
+
+        // Cache of decompositions for each o and g
+        mutable std::vector<std::shared_ptr<Factorization> > solver_;
+        mutable std::list<int> recent_; // most recently used first
+        mutable std::vector<std::list<int>::iterator> recent_position_;
+        mutable double memory_;
+        mutable std::vector<int> hits_;
+        mutable std::vector<int> misses_;
+        mutable std::vector<int> refinements_;
+    };
+    
+    // Upwind sweep solver
+    // Orders the points once for each ordinate by their distance along the
+    // direction and groups consecutive points into blocks of up to
+    // max_block_size points, which are factored as dense matrices
+    // A sweep through the blocks in this order, which drops the couplings to
+    // downwind blocks, preconditions a BiCGSTAB solve of the full matrix
+    // Falls back to a sparse LU solve if BiCGSTAB does not converge
+    // Works in parallel
+    class Upwind_Solver : public Sweep_Solver
+    {
+    public:
+
+        // Constructor
+        Upwind_Solver(Meshless_Sweep const &wrs);
+
+        // Solve problem
+        virtual void solve(std::vector<double> &x) const override;
+
+        // Output data to XML file
+        virtual void output(XML_Node output_node) const override;
+        
+    protected:
+
+        // Blocks of points in order along the direction of one ordinate
+        struct Ordering
+        {
+            std::vector<int> block_offsets;
+            std::vector<int> block_points; // points in block order
+            std::vector<int> point_block;
+            std::vector<int> point_position; // position of point in block
+            bool lagged; // any entry couples to a downwind block
+        };
+        
+        // Data for the solve of one ordinate and group, stored for each thread
+        struct Workspace
+        {
+            std::vector<double> values;
+            std::vector<double> rhs;
+            std::vector<double> lhs;
+            std::vector<double> residual;
+            std::vector<double> shadow_residual;
+            std::vector<double> search;
+            std::vector<double> product;
+            std::vector<double> intermediate;
+            std::vector<double> intermediate_product;
+            std::vector<double> preconditioned;
+            std::vector<double> block_matrix;
+            std::vector<double> block_rhs;
+            std::vector<double> block_lhs;
+            std::vector<std::shared_ptr<Eigen_Dense_Solver<double> > > block_solvers;
+        };
+        
+        // Get blocks of points in order along the direction of one ordinate
+        void get_ordering(int o,
+                          Ordering &ordering) const;
+
+        // Factor the blocks with more than one point
+        void factor_blocks(Ordering const &ordering,
+                           Workspace &workspace) const;
+
+        // Sweep through the blocks once, dropping downwind couplings
+        void sweep(Ordering const &ordering,
+                   Workspace &workspace,
+                   std::vector<double> const &b,
+                   std::vector<double> &x) const;
+
+        // Multiply by the full matrix
+        void multiply(Workspace const &workspace,
+                      std::vector<double> const &x,
+                      std::vector<double> &y) const;
+
+        // Solve using BiCGSTAB preconditioned on the right by the sweep,
+        // returning true if converged
+        bool solve_bicgstab(Ordering const &ordering,
+                            Workspace &workspace,
+                            int &number_of_iterations) const;
+
+        // Get symbolic analysis for the fallback solve
+        std::shared_ptr<Eigen_Sparse_Pattern<double> > get_pattern() const;
+        
+        // Data
+        std::vector<int> row_offsets_;
+        std::vector<int> column_indices_;
+        std::vector<Ordering> orderings_;
+        mutable std::shared_ptr<Eigen_Sparse_Pattern<double> > pattern_;
+        mutable std::vector<Workspace> workspace_;
+        mutable std::vector<int> iterations_;
+        mutable std::vector<int> fallbacks_;
+    };
+    
     // Data
     Options options_;
+    double inner_tolerance_; // Current tolerance, which may differ from options_.tolerance
     std::shared_ptr<Weak_Spatial_Discretization> spatial_discretization_;
     std::shared_ptr<Angular_Discretization> angular_discretization_;
     std::shared_ptr<Energy_Discretization> energy_discretization_;
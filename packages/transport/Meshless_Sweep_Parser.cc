@@ -62,6 +62,18 @@ get_weak_sweep(XML_Node input_node) const
                                                                      options.weighted_preconditioner);
     options.force_left = input_node.get_attribute<bool>("force_left",
                                                         options.force_left);
+    options.decompose_matrix = input_node.get_attribute<bool>("decompose_matrix",
+                                                              options.decompose_matrix);
+    options.max_factorization_memory = input_node.get_attribute<double>("max_factorization_memory",
+                                                                        options.max_factorization_memory);
+    options.warm_start = input_node.get_attribute<bool>("warm_start",
+                                                        options.warm_start);
+    options.single_precision = input_node.get_attribute<bool>("single_precision",
+                                                              options.single_precision);
+    options.max_refinement_iterations = input_node.get_attribute<int>("max_refinement_iterations",
+                                                                      options.max_refinement_iterations);
+    options.max_block_size = input_node.get_attribute<int>("max_block_size",
+                                                           options.max_block_size);
     
     string solver = input_node.get_attribute<string>("solver",
                                                      "belos_ifpack");
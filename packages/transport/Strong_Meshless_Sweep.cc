@@ -10,6 +10,7 @@
 #include "Dimensional_Moments.hh"
 #include "Energy_Discretization.hh"
 #include "Material.hh"
+#include "Material_Table.hh"
 #include "Transport_Discretization.hh"
 #include "Weak_Spatial_Discretization.hh"
 
@@ -63,7 +64,8 @@ get_matrix_row(int i, // weight function index (row)
     int const number_of_groups = energy_discretization_->number_of_groups();
     shared_ptr<Material> const material = weight->material();
     shared_ptr<Cross_Section> const sigma_t_cs = material->sigma_t();
-    vector<double> const sigma_t_data = sigma_t_cs->data();
+    shared_ptr<Material_Table> const material_table = spatial_discretization_->material_table();
+    double const *sigma_t_data = material_table->view(i).sigma_t;
     
     // Get indices
     indices = basis_indices;
@@ -112,9 +114,7 @@ get_matrix_row(int i, // weight function index (row)
         case Cross_Section::Dependencies::Spatial::BASIS:
         {
             int const b = basis_indices[j];
-            shared_ptr<Material> const basis_material = spatial_discretization_->weight(b)->material();
-            shared_ptr<Cross_Section> const basis_sigma_t_cs = basis_material->sigma_t();
-            vector<double> const basis_sigma_t_data = basis_sigma_t_cs->data();
+            double const *basis_sigma_t_data = material_table->view(b).sigma_t;
             value += basis_sigma_t_data[g] * v_b[j];
             break;
         }
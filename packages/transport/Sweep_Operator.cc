@@ -12,6 +12,7 @@ Sweep_Operator(Sweep_Type sweep_type,
                shared_ptr<Transport_Discretization> transport_discretization):
     Square_Vector_Operator(),
     include_boundary_source_(false),
+    active_group_(-1),
     sweep_type_(sweep_type),
     transport_discretization_(transport_discretization)
 {
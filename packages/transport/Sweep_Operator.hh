@@ -45,6 +45,17 @@ public:
         include_boundary_source_ = include_source;
     }
 
+    // Restrict sweep to one group (negative for all groups)
+    // Values for the other groups are left unchanged
+    virtual int active_group() const
+    {
+        return active_group_;
+    }
+    virtual void set_active_group(int group)
+    {
+        active_group_ = group;
+    }
+
     // Sweep type
     virtual Sweep_Type sweep_type() const
     {
@@ -67,6 +78,7 @@ public:
 protected:
     
     bool include_boundary_source_;
+    int active_group_;
     Sweep_Type sweep_type_;
     std::shared_ptr<Transport_Discretization> transport_discretization_;
     
@@ -34,7 +34,9 @@
 #include "Cross_Section.hh"
 #include "Dimensional_Moments.hh"
 #include "Energy_Discretization.hh"
+#include "Integral_Store.hh"
 #include "Material.hh"
+#include "Material_Table.hh"
 #include "Transport_Discretization.hh"
 #include "XML_Node.hh"
 
@@ -80,8 +82,8 @@ get_rhs(int i,
 {
     // Get data
     shared_ptr<Weight_Function> weight = spatial_discretization_->weight(i);
-    vector<double> const &is_b_w = weight->integrals().is_b_w;
-    vector<double> const direction = angular_discretization_->direction(o);
+    double const *is_b_w = spatial_discretization_->integral_store()->view(i).is_b_w;
+    vector<double> const &direction = angular_discretization_->direction(o);
     int number_of_basis_functions = weight->number_of_basis_functions();
     int number_of_boundary_surfaces = weight->number_of_boundary_surfaces();
     int number_of_ordinates = angular_discretization_->number_of_ordinates();
@@ -163,19 +165,17 @@ get_matrix_row(int i, // weight function index (row)
 {
     // Get data
     shared_ptr<Weight_Function> weight = spatial_discretization_->weight(i);
-    Weight_Function::Integrals const integrals = weight->integrals();
-    vector<double> const &iv_w = integrals.iv_w;
-    vector<double> const &iv_dw = integrals.iv_dw;
-    vector<double> const &is_b_w = integrals.is_b_w;
-    vector<double> const &iv_b_w = integrals.iv_b_w;
-    vector<double> const &iv_b_dw = integrals.iv_b_dw;
-    vector<double> const &iv_db_dw = integrals.iv_db_dw;
-    vector<double> const direction = angular_discretization_->direction(o);
+    Integral_Store::View const integrals = spatial_discretization_->integral_store()->view(i);
+    double const *is_b_w = integrals.is_b_w;
+    double const *iv_b_w = integrals.iv_b_w;
+    double const *iv_b_dw = integrals.iv_b_dw;
+    double const *iv_db_dw = integrals.iv_db_dw;
+    vector<double> const &direction = angular_discretization_->direction(o);
     shared_ptr<Dimensional_Moments> const dimensional_moments
         = spatial_discretization_->dimensional_moments();
     int const number_of_dimensional_moments = dimensional_moments->number_of_dimensional_moments();
-    int const number_of_basis_functions = weight->number_of_basis_functions();
-    vector<int> const basis_indices = weight->basis_function_indices();
+    int const number_of_basis_functions = integrals.number_of_basis_functions;
+    int const *basis_indices = integrals.basis_function_indices;
     int const number_of_boundary_surfaces = weight->number_of_boundary_surfaces();
     int const dimension = spatial_discretization_->dimension();
     int const number_of_groups = energy_discretization_->number_of_groups();
@@ -183,10 +183,12 @@ get_matrix_row(int i, // weight function index (row)
         = spatial_discretization_->options();
     shared_ptr<Weight_Function_Options> const weight_options
         = weight->options();
+    shared_ptr<Material_Table> const material_table = spatial_discretization_->material_table();
+    Material_Table::View const material_data = material_table->view(i);
     shared_ptr<Material> const material = weight->material();
     shared_ptr<Cross_Section> const sigma_t_cs = material->sigma_t();
     shared_ptr<Cross_Section> const norm_cs = material->norm();
-    vector<double> const sigma_t_data = sigma_t_cs->data();
+    double const *sigma_t_data = material_data.sigma_t;
     
     bool const include_supg = weak_options->include_supg;
     bool const normalized = weak_options->normalized;
@@ -196,10 +198,7 @@ get_matrix_row(int i, // weight function index (row)
                                             direction);
 
     // Get indices
-    {
-        vector<int> const indices_data = weight->basis_function_indices();
-        indices = indices_data;
-    }
+    indices.assign(basis_indices, basis_indices + number_of_basis_functions);
     
     // Get values
     values.assign(number_of_basis_functions, 0);
@@ -274,9 +273,7 @@ get_matrix_row(int i, // weight function index (row)
         case Cross_Section::Dependencies::Spatial::BASIS:
         {
             int const b = basis_indices[j];
-            shared_ptr<Material> const basis_material = spatial_discretization_->weight(b)->material();
-            shared_ptr<Cross_Section> const basis_sigma_t_cs = basis_material->sigma_t();
-            vector<double> const basis_sigma_t_data = basis_sigma_t_cs->data();
+            double const *basis_sigma_t_data = material_table->view(b).sigma_t;
 
             double sum = 0;
             for (int d = 0; d < number_of_dimensional_moments; ++d)
@@ -306,7 +303,7 @@ get_matrix_row(int i, // weight function index (row)
             // Normalize total cross section if needed
             if (!normalized)
             {
-                vector<double> const norm_data = norm_cs->data();
+                double const *norm_data = material_data.norm;
                 double norm = 0;
                 switch (norm_cs->dependencies().energy)
                 {
@@ -357,19 +354,15 @@ get_prec_matrix_row(int i, // weight function index (row)
 {
     // Get data
     shared_ptr<Weight_Function> weight = spatial_discretization_->weight(i);
-    Weight_Function::Integrals const weight_integrals = weight->integrals();
-    Weight_Function::Values const weight_values = weight->values();
-    vector<double> const &v_b = weight_values.v_b;
-    vector<double> const &iv_w = weight_integrals.iv_w;
-    vector<double> const &iv_b_w = weight_integrals.iv_b_w;
-    int const number_of_basis_functions = weight->number_of_basis_functions();
-    vector<int> const basis_indices = weight->basis_function_indices();
+    Integral_Store::View const weight_integrals = spatial_discretization_->integral_store()->view(i);
+    vector<double> const &v_b = weight->values().v_b;
+    double const *iv_w = weight_integrals.iv_w;
+    double const *iv_b_w = weight_integrals.iv_b_w;
+    int const number_of_basis_functions = weight_integrals.number_of_basis_functions;
+    int const *basis_indices = weight_integrals.basis_function_indices;
     
     // Get indices
-    {
-        vector<int> const indices_data = weight->basis_function_indices();
-        indices = indices_data;
-    }
+    indices.assign(basis_indices, basis_indices + number_of_basis_functions);
     
     // Get values
     values.assign(number_of_basis_functions, 0);
@@ -388,3 +381,302 @@ get_prec_matrix_row(int i, // weight function index (row)
     } // basis functions
 }
 
+int Weak_Meshless_Sweep::
+number_of_streaming_components() const
+{
+    // Surface (per dimension and normal direction), volume and SUPG
+    int const dimension = spatial_discretization_->dimension();
+    bool const include_supg = spatial_discretization_->options()->include_supg;
+    
+    return 3 * dimension + (include_supg ? dimension * dimension : 0);
+}
+
+void Weak_Meshless_Sweep::
+get_matrix_components(Matrix_Components &components) const
+{
+    // Get data
+    int const number_of_points = spatial_discretization_->number_of_points();
+    int const dimension = spatial_discretization_->dimension();
+    int const number_of_groups = energy_discretization_->number_of_groups();
+    shared_ptr<Dimensional_Moments> const dimensional_moments
+        = spatial_discretization_->dimensional_moments();
+    int const number_of_dimensional_moments = dimensional_moments->number_of_dimensional_moments();
+    shared_ptr<Weak_Spatial_Discretization_Options> const weak_options
+        = spatial_discretization_->options();
+    bool const include_supg = weak_options->include_supg;
+    Cross_Section::Dependencies::Spatial const spatial_dependency
+        = spatial_discretization_->weight(0)->material()->sigma_t()->dependencies().spatial;
+    
+    // Get number of components
+    // The streaming components come first, followed by the collision components
+    int const collision_offset = number_of_streaming_components();
+    int number_of_collision_components;
+    switch (spatial_dependency)
+    {
+    case Cross_Section::Dependencies::Spatial::BASIS_WEIGHT:
+    case Cross_Section::Dependencies::Spatial::BASIS:
+        number_of_collision_components = number_of_dimensional_moments * number_of_groups;
+        break;
+    case Cross_Section::Dependencies::Spatial::WEIGHT:
+        number_of_collision_components = include_supg ? 1 + dimension : 1;
+        break;
+    }
+    int const number_of_components = collision_offset + number_of_collision_components;
+    
+    // Get sparsity pattern
+    shared_ptr<Integral_Store> const integral_store = spatial_discretization_->integral_store();
+    shared_ptr<Material_Table> const material_table = spatial_discretization_->material_table();
+    vector<int> &row_offsets = components.row_offsets;
+    vector<int> &column_indices = components.column_indices;
+    row_offsets = integral_store->basis_offsets();
+    int const number_of_entries = row_offsets[number_of_points];
+    column_indices.resize(number_of_entries);
+    components.number_of_components = number_of_components;
+    components.values.assign(number_of_entries * number_of_components, 0);
+    
+    #pragma omp parallel for schedule(dynamic, 10)
+    for (int i = 0; i < number_of_points; ++i)
+    {
+        // Get weight data
+        shared_ptr<Weight_Function> const weight = spatial_discretization_->weight(i);
+        Integral_Store::View const integrals = integral_store->view(i);
+        double const *is_b_w = integrals.is_b_w;
+        double const *iv_b_w = integrals.iv_b_w;
+        double const *iv_b_dw = integrals.iv_b_dw;
+        double const *iv_db_dw = integrals.iv_db_dw;
+        int const *basis_indices = integrals.basis_function_indices;
+        int const number_of_basis_functions = integrals.number_of_basis_functions;
+        int const number_of_boundary_surfaces = weight->number_of_boundary_surfaces();
+        double const tau = weight->options()->tau;
+        shared_ptr<Cross_Section> const sigma_t_cs = weight->material()->sigma_t();
+        double const *sigma_t_data = material_table->view(i).sigma_t;
+        AssertMsg(sigma_t_cs->dependencies().spatial == spatial_dependency,
+                  "spatial dependency of total cross section must be the same for all points");
+        
+        for (int j = 0; j < number_of_basis_functions; ++j)
+        {
+            int const k = row_offsets[i] + j;
+            double *const values = &components.values[k];
+            column_indices[k] = basis_indices[j];
+            
+            // Streaming surface components, separated by surface dimension and normal
+            for (int s = 0; s < number_of_boundary_surfaces; ++s)
+            {
+                shared_ptr<Cartesian_Plane> const surface = weight->boundary_surface(s);
+                int const surface_dimension = surface->surface_dimension();
+                double const normal = surface->normal();
+                int const c = (normal > 0 ? 0 : 1) + 2 * surface_dimension;
+                int const is_index = s + number_of_boundary_surfaces * j;
+                values[number_of_entries * c] += normal * is_b_w[is_index];
+            }
+            
+            // Streaming volume components
+            for (int d = 0; d < dimension; ++d)
+            {
+                int const c = 2 * dimension + d;
+                values[number_of_entries * c] = iv_b_dw[d + dimension * j];
+            }
+            
+            // Streaming SUPG components
+            if (include_supg)
+            {
+                for (int d1 = 0; d1 < dimension; ++d1)
+                {
+                    for (int d2 = 0; d2 < dimension; ++d2)
+                    {
+                        int const c = 3 * dimension + d2 + dimension * d1;
+                        int const iv_index = d2 + dimension * (d1 + dimension * j);
+                        values[number_of_entries * c] = tau * iv_db_dw[iv_index];
+                    }
+                }
+            }
+            
+            // Collision components
+            switch (spatial_dependency)
+            {
+            case Cross_Section::Dependencies::Spatial::BASIS_WEIGHT:
+                for (int g = 0; g < number_of_groups; ++g)
+                {
+                    for (int d = 0; d < number_of_dimensional_moments; ++d)
+                    {
+                        int const c = collision_offset + d + number_of_dimensional_moments * g;
+                        int const k_sigma = d + number_of_dimensional_moments * (g + number_of_groups * j);
+                        values[number_of_entries * c] = (d == 0 ? 1 : tau) * sigma_t_data[k_sigma];
+                    }
+                }
+                break;
+            case Cross_Section::Dependencies::Spatial::BASIS:
+            {
+                int const b = basis_indices[j];
+                double const *basis_sigma_t_data = material_table->view(b).sigma_t;
+                for (int g = 0; g < number_of_groups; ++g)
+                {
+                    for (int d = 0; d < number_of_dimensional_moments; ++d)
+                    {
+                        int const c = collision_offset + d + number_of_dimensional_moments * g;
+                        int const k_sigma = d + number_of_dimensional_moments * g;
+                        double const mult = (d == 0
+                                             ? iv_b_w[j]
+                                             : tau * iv_b_dw[d - 1 + dimension * j]);
+                        values[number_of_entries * c] = mult * basis_sigma_t_data[k_sigma];
+                    }
+                }
+                break;
+            }
+            case Cross_Section::Dependencies::Spatial::WEIGHT:
+                // Scaled by the total cross section in get_matrix_coefficients
+                values[number_of_entries * collision_offset] = iv_b_w[j];
+                if (include_supg)
+                {
+                    for (int d = 0; d < dimension; ++d)
+                    {
+                        int const c = collision_offset + 1 + d;
+                        values[number_of_entries * c] = tau * iv_b_dw[d + dimension * j];
+                    }
+                }
+                break;
+            }
+        } // basis functions
+    } // points
+}
+
+void Weak_Meshless_Sweep::
+get_matrix_coefficients(int o,
+                        int g,
+                        Matrix_Coefficients &coefficients) const
+{
+    // Get data
+    int const number_of_points = spatial_discretization_->number_of_points();
+    int const dimension = spatial_discretization_->dimension();
+    vector<double> const direction = angular_discretization_->direction(o);
+    shared_ptr<Dimensional_Moments> const dimensional_moments
+        = spatial_discretization_->dimensional_moments();
+    int const number_of_dimensional_moments = dimensional_moments->number_of_dimensional_moments();
+    shared_ptr<Weak_Spatial_Discretization_Options> const weak_options
+        = spatial_discretization_->options();
+    bool const include_supg = weak_options->include_supg;
+    bool const normalized = weak_options->normalized;
+    Cross_Section::Dependencies::Spatial const spatial_dependency
+        = spatial_discretization_->weight(0)->material()->sigma_t()->dependencies().spatial;
+    int const collision_offset = number_of_streaming_components();
+    vector<int> &components = coefficients.components;
+    vector<double> &values = coefficients.coefficients;
+    components.clear();
+    values.clear();
+    coefficients.scaled_components.clear();
+    coefficients.scaled_coefficients.clear();
+    coefficients.row_scaling.clear();
+    
+    // Streaming surface: only outgoing surfaces contribute
+    for (int d = 0; d < dimension; ++d)
+    {
+        if (direction[d] != 0)
+        {
+            components.push_back((direction[d] > 0 ? 0 : 1) + 2 * d);
+            values.push_back(direction[d]);
+        }
+    }
+    
+    // Streaming volume
+    for (int d = 0; d < dimension; ++d)
+    {
+        components.push_back(2 * dimension + d);
+        values.push_back(-direction[d]);
+    }
+
+    // Streaming SUPG
+    if (include_supg)
+    {
+        for (int d1 = 0; d1 < dimension; ++d1)
+        {
+            for (int d2 = 0; d2 < dimension; ++d2)
+            {
+                components.push_back(3 * dimension + d2 + dimension * d1);
+                values.push_back(direction[d1] * direction[d2]);
+            }
+        }
+    }
+    
+    // Collision
+    switch (spatial_dependency)
+    {
+    case Cross_Section::Dependencies::Spatial::BASIS_WEIGHT:
+    case Cross_Section::Dependencies::Spatial::BASIS:
+        // Tau is included in the components
+        for (int d = 0; d < number_of_dimensional_moments; ++d)
+        {
+            components.push_back(collision_offset + d + number_of_dimensional_moments * g);
+            values.push_back(d == 0 ? 1 : direction[d - 1]);
+        }
+        break;
+    case Cross_Section::Dependencies::Spatial::WEIGHT:
+    {
+        Assert(weak_options->total == Weak_Spatial_Discretization_Options::Total::ISOTROPIC); // moment method not yet implemented
+        
+        coefficients.scaled_components.push_back(collision_offset);
+        coefficients.scaled_coefficients.push_back(1);
+        if (include_supg)
+        {
+            for (int d = 0; d < dimension; ++d)
+            {
+                coefficients.scaled_components.push_back(collision_offset + 1 + d);
+                coefficients.scaled_coefficients.push_back(direction[d]);
+            }
+        }
+        
+        // Row scaling is the total cross section of the weight function
+        vector<double> &row_scaling = coefficients.row_scaling;
+        row_scaling.resize(number_of_points);
+        shared_ptr<Material_Table> const material_table = spatial_discretization_->material_table();
+        for (int i = 0; i < number_of_points; ++i)
+        {
+            shared_ptr<Weight_Function> const weight = spatial_discretization_->weight(i);
+            shared_ptr<Material> const material = weight->material();
+            Material_Table::View const material_data = material_table->view(i);
+            double const *sigma_t_data = material_data.sigma_t;
+            vector<double> const dimensional_coefficients
+                = dimensional_moments->coefficients(weight->options()->tau,
+                                                    direction);
+            
+            // Get total cross section: leave out higher moments for now
+            double sigma_t = 0;
+            for (int d = 0; d < number_of_dimensional_moments; ++d)
+            {
+                int const k_sigma = d + number_of_dimensional_moments * g;
+                sigma_t += sigma_t_data[k_sigma] * dimensional_coefficients[d];
+            }
+            
+            // Normalize total cross section if needed
+            if (!normalized)
+            {
+                shared_ptr<Cross_Section> const norm_cs = material->norm();
+                double const *norm_data = material_data.norm;
+                double norm = 0;
+                switch (norm_cs->dependencies().energy)
+                {
+                case Cross_Section::Dependencies::Energy::NONE:
+                    for (int d = 0; d < number_of_dimensional_moments; ++d)
+                    {
+                        norm += norm_data[d] * dimensional_coefficients[d];
+                    }
+                    break;
+                case Cross_Section::Dependencies::Energy::GROUP:
+                    for (int d = 0; d < number_of_dimensional_moments; ++d)
+                    {
+                        int const k_norm = d + number_of_dimensional_moments * g;
+                        norm += norm_data[k_norm] * dimensional_coefficients[d];
+                    }
+                    break;
+                default:
+                    AssertMsg(false, "norm dependency incorrect");
+                    break;
+                }
+                sigma_t /= norm;
+            } // if !normalized
+            
+            row_scaling[i] = sigma_t;
+        }
+        break;
+    } // Spatial::WEIGHT
+    } // switch Spatial
+}
@@ -35,6 +35,19 @@ protected:
                          int g, // group
                          std::vector<double> const &x, // angular flux w/ augments
                          double &value) const override; // rhs value
+    virtual bool has_matrix_components() const override
+    {
+        return true;
+    }
+    virtual void get_matrix_components(Matrix_Components &components) const override;
+    virtual void get_matrix_coefficients(int o, // ordinate
+                                         int g, // group
+                                         Matrix_Coefficients &coefficients) const override;
+
+private:
+
+    // Number of components for the streaming and SUPG terms
+    int number_of_streaming_components() const;
 };
 
 #endif
@@ -3,31 +3,43 @@
 #include "Angular_Discretization.hh"
 #include "Angular_Discretization_Factory.hh"
 #include "Angular_Discretization_Parser.hh"
+#include "Basis_Function.hh"
 #include "Boundary_Source.hh"
 #include "Boundary_Source_Parser.hh"
+#include "Cartesian_Distance.hh"
 #include "Cartesian_Plane.hh"
 #include "Constructive_Solid_Geometry.hh"
 #include "Constructive_Solid_Geometry_Parser.hh"
+#include "Conversion.hh"
 #include "Cross_Section.hh"
 #include "Dimensional_Moments.hh"
 #include "Discrete_Value_Operator.hh"
 #include "Energy_Discretization.hh"
 #include "Energy_Discretization_Parser.hh"
+#include "KD_Tree.hh"
 #include "Material.hh"
 #include "Material_Factory.hh"
 #include "Material_Parser.hh"
+#include "Material_Table.hh"
+#include "Meshless_Function_Factory.hh"
+#include "RBF_Factory.hh"
 #include "Region.hh"
+#include "Strong_Meshless_Sweep.hh"
+#include "Strong_Spatial_Discretization.hh"
 #include "Transport_Discretization.hh"
 #include "Weak_Meshless_Sweep.hh"
 #include "Weak_Spatial_Discretization.hh"
 #include "Weak_Spatial_Discretization_Factory.hh"
 #include "Weak_Spatial_Discretization_Parser.hh"
+#include "Weight_Function.hh"
 #include "XML_Document.hh"
 #include "XML_Node.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -55,7 +67,8 @@ XML_Document get_xml_document(string input_filename)
     return input_file;
 }
 
-void get_one_region(bool basis_mls,
+void get_one_region(bool strong,
+                    bool basis_mls,
                     bool weight_mls,
                     string basis_type,
                     string weight_type,
@@ -156,15 +169,118 @@ void get_one_region(bool basis_mls,
     // Get spatial discretization
     Weak_Spatial_Discretization_Factory spatial_factory(solid,
                                                         solid->cartesian_boundary_surfaces());
-    spatial
-        = spatial_factory.get_simple_discretization(num_dimensional_points,
-                                                    radius_num_intervals,
-                                                    basis_mls,
-                                                    weight_mls,
-                                                    basis_type,
-                                                    weight_type,
-                                                    weight_options,
-                                                    weak_options);
+    if (strong)
+    {
+        // Get points
+        Meshless_Function_Factory meshless_factory;
+        vector<vector<double> > limits;
+        meshless_factory.get_boundary_limits(dimension,
+                                             solid->cartesian_boundary_surfaces(),
+                                             limits);
+        int number_of_points;
+        vector<vector<double> > points;
+        meshless_factory.get_cartesian_points(dimension,
+                                              vector<int>(dimension, num_dimensional_points),
+                                              limits,
+                                              number_of_points,
+                                              points);
+        shared_ptr<KD_Tree> kd_tree
+            = make_shared<KD_Tree>(dimension,
+                                   number_of_points,
+                                   points);
+        
+        // Get MLS basis functions
+        RBF_Factory rbf_factory;
+        shared_ptr<Distance> distance
+            = make_shared<Cartesian_Distance>(dimension);
+        double radius = (points[1][0] - points[0][0]) * radius_num_intervals;
+        vector<double> radii(number_of_points, radius);
+        vector<vector<int> > neighbors;
+        vector<vector<double> > squared_distances;
+        meshless_factory.get_neighbors(kd_tree,
+                                       false, // global_rbf
+                                       dimension,
+                                       number_of_points,
+                                       radii,
+                                       radii,
+                                       points,
+                                       neighbors,
+                                       squared_distances);
+        vector<shared_ptr<Meshless_Function> > simple_functions;
+        meshless_factory.get_rbf_functions(number_of_points,
+                                           radii,
+                                           points,
+                                           rbf_factory.get_rbf(basis_type),
+                                           distance,
+                                           simple_functions);
+        vector<shared_ptr<Meshless_Function> > meshless_basis;
+        meshless_factory.get_mls_functions(1,
+                                           number_of_points,
+                                           simple_functions,
+                                           neighbors,
+                                           meshless_basis);
+        vector<shared_ptr<Basis_Function> > bases;
+        spatial_factory.get_basis_functions(number_of_points,
+                                            meshless_basis,
+                                            bases);
+        
+        // Get weight functions that only include their own point
+        vector<double> weight_radii(number_of_points, 1000 * numeric_limits<double>::epsilon());
+        vector<shared_ptr<Meshless_Function> > meshless_weight;
+        meshless_factory.get_rbf_functions(number_of_points,
+                                           weight_radii,
+                                           points,
+                                           rbf_factory.get_rbf("wendland11"),
+                                           distance,
+                                           meshless_weight);
+        vector<vector<int> > point_neighbors;
+        vector<vector<double> > point_squared_distances;
+        meshless_factory.get_point_neighbors(kd_tree,
+                                             dimension,
+                                             number_of_points,
+                                             radii,
+                                             points,
+                                             point_neighbors,
+                                             point_squared_distances);
+        weak_options->discretization = Weak_Spatial_Discretization_Options::Discretization::STRONG;
+        weak_options->weighting = Weak_Spatial_Discretization_Options::Weighting::POINT;
+        weak_options->identical_basis_functions = Weak_Spatial_Discretization_Options::Identical_Basis_Functions::FALSE;
+        weak_options->include_supg = false;
+        weak_options->perform_integration = false;
+        weak_options->solid = solid;
+        shared_ptr<Dimensional_Moments> dimensional_moments
+            = make_shared<Dimensional_Moments>(weak_options->include_supg,
+                                               dimension);
+        vector<shared_ptr<Weight_Function> > weights;
+        spatial_factory.get_weight_functions(number_of_points,
+                                             weight_options,
+                                             weak_options,
+                                             dimensional_moments,
+                                             point_neighbors,
+                                             meshless_weight,
+                                             bases,
+                                             weights);
+        
+        // Materials are set by the strong discretization
+        spatial
+            = make_shared<Strong_Spatial_Discretization>(bases,
+                                                         weights,
+                                                         dimensional_moments,
+                                                         weak_options,
+                                                         kd_tree);
+    }
+    else
+    {
+        spatial
+            = spatial_factory.get_simple_discretization(num_dimensional_points,
+                                                        radius_num_intervals,
+                                                        basis_mls,
+                                                        weight_mls,
+                                                        basis_type,
+                                                        weight_type,
+                                                        weight_options,
+                                                        weak_options);
+    }
     
     // Get transport discretization
     transport
@@ -172,14 +288,27 @@ void get_one_region(bool basis_mls,
                                                 angular,
                                                 energy);
     
-    // Get weak RBF sweep
+    // Get weak or strong RBF sweep
     Meshless_Sweep::Options options;
-    sweeper
-        = make_shared<Weak_Meshless_Sweep>(options,
-                                           spatial,
-                                           angular,
-                                           energy,
-                                           transport);
+    if (strong)
+    {
+        options.solver = Meshless_Sweep::Options::Solver::EIGEN_SPARSE_LU;
+        sweeper
+            = make_shared<Strong_Meshless_Sweep>(options,
+                                                 spatial,
+                                                 angular,
+                                                 energy,
+                                                 transport);
+    }
+    else
+    {
+        sweeper
+            = make_shared<Weak_Meshless_Sweep>(options,
+                                               spatial,
+                                               angular,
+                                               energy,
+                                               transport);
+    }
 }
 void get_transport_from_xml(string input_filename,
                             shared_ptr<Weak_Spatial_Discretization> &spatial,
@@ -387,6 +516,80 @@ int run_test(shared_ptr<Weak_Spatial_Discretization> spatial,
     return 0;
 }
 
+// Compare a sweep with the given options to a sparse LU sweep, using a
+// different right hand side for each solve
+int compare_sweep(string description,
+                  Meshless_Sweep::Options options,
+                  shared_ptr<Weak_Spatial_Discretization> spatial,
+                  shared_ptr<Angular_Discretization> angular,
+                  shared_ptr<Energy_Discretization> energy,
+                  shared_ptr<Transport_Discretization> transport,
+                  int number_of_solves,
+                  double tolerance,
+                  shared_ptr<Meshless_Sweep> &sweeper,
+                  int zero_solve = -1) // solve without any source
+{
+    Meshless_Sweep::Options reference_options;
+    reference_options.solver = Meshless_Sweep::Options::Solver::EIGEN_SPARSE_LU;
+    shared_ptr<Meshless_Sweep> reference
+        = make_shared<Weak_Meshless_Sweep>(reference_options,
+                                           spatial,
+                                           angular,
+                                           energy,
+                                           transport);
+    sweeper
+        = make_shared<Weak_Meshless_Sweep>(options,
+                                           spatial,
+                                           angular,
+                                           energy,
+                                           transport);
+    
+    int checksum = 0;
+    int size = transport->psi_size() + transport->number_of_augments();
+    for (int s = 0; s < number_of_solves; ++s)
+    {
+        bool const zero = s == zero_solve;
+        reference->set_include_boundary_source(!zero);
+        sweeper->set_include_boundary_source(!zero);
+        vector<double> expected(size);
+        for (int k = 0; k < size; ++k)
+        {
+            expected[k] = zero ? 0 : 1 + 0.5 * sin(k + s);
+        }
+        vector<double> result = expected;
+        (*reference)(expected);
+        (*sweeper)(result);
+        
+        double error = 0;
+        double norm = 0;
+        for (int k = 0; k < size; ++k)
+        {
+            error = max(error, abs(result[k] - expected[k]));
+            norm = max(norm, abs(expected[k]));
+        }
+        if (!(error <= tolerance * norm))
+        {
+            cerr << description << " sweep differs from sparse LU in solve " << s << ": " << error / norm << endl;
+            checksum += 1;
+        }
+    }
+    
+    return checksum;
+}
+
+// Get a count for each ordinate and group from the output of the sparse LU
+// factorization cache
+vector<int> get_cache_counts(shared_ptr<Meshless_Sweep> sweeper,
+                             string description,
+                             int number_of_matrices)
+{
+    XML_Document output_file;
+    XML_Node output_node = output_file.append_child("output");
+    sweeper->output(output_node);
+    return output_node.get_child("factorization_cache").get_child_vector<int>(description,
+                                                                             number_of_matrices);
+}
+
 int main(int argc, char **argv)
 {
     int checksum = 0;
@@ -429,6 +632,244 @@ int main(int argc, char **argv)
                              sweeper,
                              print);
 
+        // Solve a one-region problem with the strong form, which sets the
+        // materials after the spatial discretization is constructed
+        {
+            shared_ptr<Weight_Function_Options> weight_options
+                = make_shared<Weight_Function_Options>();
+            shared_ptr<Weak_Spatial_Discretization_Options> weak_options
+                = make_shared<Weak_Spatial_Discretization_Options>();
+            weight_options->tau_const = 0;
+            weak_options->include_supg = false;
+            get_one_region(true, // strong
+                           true, // basis_mls
+                           true, // weight_mls
+                           "compact_gaussian",
+                           "compact_gaussian",
+                           weight_options,
+                           weak_options,
+                           1, // dimension
+                           2, // angular_rule
+                           21, // num_dimensional_points
+                           3.0, // radius_num_intervals
+                           1.0, // sigma_t
+                           2.0, // internal_source
+                           1.0, // boundary_source
+                           2.0, // length
+                           spatial,
+                           angular,
+                           energy,
+                           transport,
+                           solid,
+                           materials,
+                           sources,
+                           sweeper);
+            
+            shared_ptr<Material_Table> material_table = spatial->material_table();
+            if (!material_table
+                || material_table->number_of_points() != spatial->number_of_points())
+            {
+                cerr << "strong material table not built" << endl;
+                checksum += 1;
+            }
+            
+            checksum += run_test(spatial,
+                                 angular,
+                                 energy,
+                                 transport,
+                                 solid,
+                                 materials,
+                                 sources,
+                                 sweeper,
+                                 print);
+        }
+        
+        // Compare the sweep solvers to a sparse LU solve in two dimensions
+        {
+            shared_ptr<Weight_Function_Options> weight_options
+                = make_shared<Weight_Function_Options>();
+            shared_ptr<Weak_Spatial_Discretization_Options> weak_options
+                = make_shared<Weak_Spatial_Discretization_Options>();
+            weak_options->integration_ordinates = 32;
+            weight_options->tau_const = 0.5;
+            weak_options->include_supg = true;
+            get_one_region(false, // strong
+                           true, // basis_mls
+                           true, // weight_mls
+                           "compact_gaussian",
+                           "compact_gaussian",
+                           weight_options,
+                           weak_options,
+                           2, // dimension
+                           1, // angular_rule
+                           9, // num_dimensional_points
+                           3.0, // radius_num_intervals
+                           1.0, // sigma_t
+                           2.0, // internal_source
+                           1.0, // boundary_source
+                           2.0, // length
+                           spatial,
+                           angular,
+                           energy,
+                           transport,
+                           solid,
+                           materials,
+                           sources,
+                           sweeper);
+            
+            // Compare the upwind solver with blocks of several points and
+            // of single points
+            Meshless_Sweep::Options upwind_options;
+            upwind_options.solver = Meshless_Sweep::Options::Solver::UPWIND;
+            upwind_options.tolerance = 1e-12;
+            checksum += compare_sweep("upwind",
+                                      upwind_options,
+                                      spatial,
+                                      angular,
+                                      energy,
+                                      transport,
+                                      2, // number_of_solves
+                                      1e-8, // tolerance
+                                      sweeper);
+            upwind_options.max_block_size = 1;
+            checksum += compare_sweep("upwind_single_point",
+                                      upwind_options,
+                                      spatial,
+                                      angular,
+                                      energy,
+                                      transport,
+                                      1, // number_of_solves
+                                      1e-8, // tolerance
+                                      sweeper);
+            
+            // Compare the matrix-free Belos solver with and without the
+            // preconditioner
+            Meshless_Sweep::Options matrix_free_options;
+            matrix_free_options.solver = Meshless_Sweep::Options::Solver::BELOS_MATRIX_FREE;
+            matrix_free_options.tolerance = 1e-12;
+            checksum += compare_sweep("belos_matrix_free",
+                                      matrix_free_options,
+                                      spatial,
+                                      angular,
+                                      energy,
+                                      transport,
+                                      2, // number_of_solves
+                                      1e-8, // tolerance
+                                      sweeper);
+            matrix_free_options.use_preconditioner = false;
+            checksum += compare_sweep("belos_matrix_free_unpreconditioned",
+                                      matrix_free_options,
+                                      spatial,
+                                      angular,
+                                      energy,
+                                      transport,
+                                      1, // number_of_solves
+                                      1e-8, // tolerance
+                                      sweeper);
+            
+            // Start the Krylov solvers from the previous solution, including
+            // after a solve without any source, which the solvers skip
+            vector<Meshless_Sweep::Options::Solver> warm_solvers
+                = {Meshless_Sweep::Options::Solver::AZTEC_IFPACK,
+                   Meshless_Sweep::Options::Solver::BELOS_IFPACK};
+            for (Meshless_Sweep::Options::Solver solver : warm_solvers)
+            {
+                Meshless_Sweep::Options warm_options;
+                warm_options.solver = solver;
+                warm_options.tolerance = 1e-12;
+                warm_options.warm_start = true;
+                checksum += compare_sweep(warm_options.solver_conversion()->convert(solver) + "_warm_start",
+                                          warm_options,
+                                          spatial,
+                                          angular,
+                                          energy,
+                                          transport,
+                                          4, // number_of_solves
+                                          1e-8, // tolerance
+                                          sweeper,
+                                          1); // zero_solve
+            }
+            
+            // Each factorization is stored once without a memory limit, and
+            // is evicted and repeated on each solve when only one fits
+            int number_of_solves = 3;
+            int number_of_matrices = angular->number_of_ordinates() * energy->number_of_groups();
+            Meshless_Sweep::Options cache_options;
+            cache_options.solver = Meshless_Sweep::Options::Solver::EIGEN_SPARSE_LU;
+            checksum += compare_sweep("eigen_sparse_lu",
+                                      cache_options,
+                                      spatial,
+                                      angular,
+                                      energy,
+                                      transport,
+                                      number_of_solves,
+                                      1e-12, // tolerance
+                                      sweeper);
+            vector<int> misses = get_cache_counts(sweeper,
+                                                  "misses",
+                                                  number_of_matrices);
+            for (int k = 0; k < number_of_matrices; ++k)
+            {
+                if (misses[k] != 1)
+                {
+                    cerr << "eigen_sparse_lu factored matrix " << k << " " << misses[k] << " times" << endl;
+                    checksum += 1;
+                }
+            }
+            cache_options.max_factorization_memory = 1;
+            checksum += compare_sweep("eigen_sparse_lu_limited",
+                                      cache_options,
+                                      spatial,
+                                      angular,
+                                      energy,
+                                      transport,
+                                      number_of_solves,
+                                      1e-12, // tolerance
+                                      sweeper);
+            misses = get_cache_counts(sweeper,
+                                      "misses",
+                                      number_of_matrices);
+            int total_misses = 0;
+            for (int k = 0; k < number_of_matrices; ++k)
+            {
+                total_misses += misses[k];
+            }
+            // In parallel, the last matrix of one solve may be the first of the next
+            if (total_misses < number_of_solves * number_of_matrices - (number_of_solves - 1))
+            {
+                cerr << "eigen_sparse_lu_limited factored " << total_misses << " times" << endl;
+                checksum += 1;
+            }
+            
+            // Iterative refinement recovers the double precision solution,
+            // including when the last allowed correction converges
+            Meshless_Sweep::Options single_options;
+            single_options.solver = Meshless_Sweep::Options::Solver::EIGEN_SPARSE_LU;
+            single_options.tolerance = 1e-12;
+            single_options.single_precision = true;
+            checksum += compare_sweep("eigen_sparse_lu_single",
+                                      single_options,
+                                      spatial,
+                                      angular,
+                                      energy,
+                                      transport,
+                                      1, // number_of_solves
+                                      1e-8, // tolerance
+                                      sweeper);
+            vector<int> refinements = get_cache_counts(sweeper,
+                                                       "refinements",
+                                                       number_of_matrices);
+            single_options.max_refinement_iterations = *max_element(refinements.begin(), refinements.end());
+            checksum += compare_sweep("eigen_sparse_lu_single_limited",
+                                      single_options,
+                                      spatial,
+                                      angular,
+                                      energy,
+                                      transport,
+                                      1, // number_of_solves
+                                      1e-8, // tolerance
+                                      sweeper);
+        }
     }
     else if (argc == 4)
     {
@@ -451,7 +892,8 @@ int main(int argc, char **argv)
         weak_options->integration_ordinates = 64;
         weight_options->tau_const = 0.5;
         weak_options->include_supg = true;
-        get_one_region(basis_mls,
+        get_one_region(false, // strong
+                       basis_mls,
                        weight_mls,
                        basis_type,
                        weight_type,
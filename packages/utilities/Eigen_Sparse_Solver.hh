@@ -0,0 +1,210 @@
+#ifndef Eigen_Sparse_Solver_hh
+#define Eigen_Sparse_Solver_hh
+
+#include <memory>
+#include <vector>
+
+#include <Eigen/OrderingMethods>
+#include <Eigen/SparseCore>
+#include <Eigen/SparseLU>
+
+#include "Check.hh"
+
+/*
+  Symbolic analysis for sparse matrices that share a sparsity pattern
+
+  The pattern is given in compressed row form. The fill-reducing ordering
+  and the column elimination tree are computed once and copied into each
+  Eigen_Sparse_Solver, so only the numeric factorization is repeated.
+*/
+template<class Scalar>
+class Eigen_Sparse_Pattern
+{
+public:
+
+    // Matrices and vectors
+    typedef Eigen::SparseMatrix<Scalar, Eigen::ColMajor, int> ESparseMatrix;
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> EVector;
+
+    // Mapped types
+    typedef Eigen::Map<EVector> EMVector;
+    typedef Eigen::Map<EVector const> EMCVector;
+
+    // LU decomposition that can take the analysis of another decomposition
+    class ELU : public Eigen::SparseLU<ESparseMatrix, Eigen::COLAMDOrdering<int> >
+    {
+    public:
+
+        void copy_analysis(ELU const &other)
+        {
+            this->m_perm_c = other.m_perm_c;
+            this->m_etree = other.m_etree;
+            this->m_analysisIsOk = other.m_analysisIsOk;
+        }
+
+        // Approximate memory used by the factors in bytes
+        double memory() const
+        {
+            return (static_cast<double>(this->m_nnzL + this->m_nnzU)
+                    * (sizeof(Scalar) + sizeof(int))
+                    + 3. * this->m_perm_c.size() * sizeof(int));
+        }
+    };
+
+    // Constructor
+    Eigen_Sparse_Pattern(int size,
+                         std::vector<int> const &row_offsets,
+                         std::vector<int> const &column_indices):
+        size_(size),
+        number_of_entries_(column_indices.size()),
+        matrix_(size, size)
+    {
+        Assert(row_offsets.size() == size_ + 1);
+        Assert(row_offsets[size_] == number_of_entries_);
+
+        // Count entries in each column
+        matrix_.resizeNonZeros(number_of_entries_);
+        int *const outer = matrix_.outerIndexPtr();
+        int *const inner = matrix_.innerIndexPtr();
+        std::vector<int> next(size_ + 1, 0);
+        for (int k = 0; k < number_of_entries_; ++k)
+        {
+            next[column_indices[k] + 1] += 1;
+        }
+        for (int j = 0; j < size_; ++j)
+        {
+            next[j + 1] += next[j];
+        }
+        for (int j = 0; j <= size_; ++j)
+        {
+            outer[j] = next[j];
+        }
+
+        // Place each row entry in its column, keeping the row indices sorted
+        entry_indices_.resize(number_of_entries_);
+        for (int i = 0; i < size_; ++i)
+        {
+            for (int k = row_offsets[i]; k < row_offsets[i + 1]; ++k)
+            {
+                int const l = next[column_indices[k]]++;
+                inner[l] = i;
+                entry_indices_[k] = l;
+            }
+        }
+
+        // Perform symbolic analysis once
+        matrix_.coeffs().setZero();
+        lu_.analyzePattern(matrix_);
+    }
+
+    // Rank of matrix
+    int size() const
+    {
+        return size_;
+    }
+
+    // Number of entries in the pattern
+    int number_of_entries() const
+    {
+        return number_of_entries_;
+    }
+
+    // Get column-major matrix given values in the order of the row entries
+    void get_matrix(std::vector<Scalar> const &values,
+                    ESparseMatrix &matrix) const
+    {
+        Check(values.size() == number_of_entries_);
+
+        matrix = matrix_;
+        Scalar *const matrix_values = matrix.valuePtr();
+        for (int k = 0; k < number_of_entries_; ++k)
+        {
+            matrix_values[entry_indices_[k]] = values[k];
+        }
+    }
+
+    // Decomposition containing the symbolic analysis
+    ELU const &analysis() const
+    {
+        return lu_;
+    }
+
+private:
+
+    int size_;
+    int number_of_entries_;
+    std::vector<int> entry_indices_; // row entry -> column-major entry
+    ESparseMatrix matrix_;
+    ELU lu_;
+};
+
+/*
+  Sparse LU decomposition using the analysis from a shared Eigen_Sparse_Pattern
+*/
+template<class Scalar>
+class Eigen_Sparse_Solver
+{
+public:
+
+    typedef Eigen_Sparse_Pattern<Scalar> Pattern;
+
+    // Constructor
+    Eigen_Sparse_Solver(std::shared_ptr<Pattern const> pattern):
+        initialized_(false),
+        pattern_(pattern)
+    {
+        Assert(pattern_);
+    }
+
+    // Rank of matrix
+    int size() const
+    {
+        return pattern_->size();
+    }
+
+    // Check whether data has been initialized
+    bool initialized() const
+    {
+        return initialized_;
+    }
+
+    // Set matrix values in the order of the row entries and perform decomposition
+    void initialize(std::vector<Scalar> const &values)
+    {
+        typename Pattern::ESparseMatrix matrix;
+        pattern_->get_matrix(values,
+                             matrix);
+        lu_.copy_analysis(pattern_->analysis());
+        lu_.factorize(matrix);
+        AssertMsg(lu_.info() == Eigen::Success, "sparse LU decomposition failed");
+        initialized_ = true;
+    }
+
+    // Approximate memory used by the decomposition in bytes
+    double memory() const
+    {
+        return initialized_ ? lu_.memory() : 0.;
+    }
+    
+    // Apply to one vector
+    void solve(std::vector<Scalar> const &b_data,
+               std::vector<Scalar> &x_data) const
+    {
+        Assert(initialized_);
+        Check(b_data.size() == size());
+        Check(x_data.size() == size());
+
+        typename Pattern::EMCVector b(&b_data[0], size());
+        typename Pattern::EMVector x(&x_data[0], size());
+
+        x = lu_.solve(b);
+    }
+
+private:
+
+    bool initialized_;
+    std::shared_ptr<Pattern const> pattern_;
+    typename Pattern::ELU lu_;
+};
+
+#endif